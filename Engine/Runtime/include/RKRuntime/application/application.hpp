@@ -1,5 +1,9 @@
 #pragma once
 
+#include <RKSTL/memory.hpp>
+#include <RKSTL/memory_tracker.hpp>
+#include <RKSTL/memory_budget.hpp>
+
 #include "RKRuntime/tools/logger.hpp"
 #include "RKRuntime/tools/profiler.hpp"
 #include "RKRuntime/core/timer.hpp"
@@ -27,6 +31,18 @@ class RK_API Application : public NonCopyable, NonMovable {
    private:
     static inline Application *m_instance = nullptr;
 
+    static constexpr size_t c_frameArenaSize = RK_KIBIBYTES(64);
+    static constexpr std::chrono::milliseconds c_memorySampleInterval = std::chrono::milliseconds(250);
+
+    // Soft and hard memory budgets in bytes. The logger flushes itself at its threshold, its budget only catches the
+    // messages buffered past it by a single long message.
+    static constexpr std::pair<size_t, size_t> c_loggerBudget = {2 * tools::Logger::c_flushThreshold,
+                                                                 4 * tools::Logger::c_flushThreshold};
+    static constexpr std::pair<size_t, size_t> c_profilerBudget = {RK_KIBIBYTES(512), RK_MEBIBYTES(1)};
+
+    static_assert(c_loggerBudget.first > tools::Logger::c_flushThreshold,
+                  "The logger budget must not evict before the logger flushes itself");
+
     struct State {
         bool isRunning;
         bool isPaused;
@@ -37,9 +53,13 @@ class RK_API Application : public NonCopyable, NonMovable {
     };
 
     State m_state;
+    std::chrono::milliseconds m_lastMemorySampleTime = std::chrono::milliseconds::zero();
+    libraries::MemorySnapshot m_lastMemorySnapshot = {};
 
    protected:
     core::Timer m_timer;
+    libraries::FrameAllocator m_frameAllocator{c_frameArenaSize};
+    libraries::MemoryBudgetManager m_memoryBudgetManager;
     std::unique_ptr<core::CVarSystem> m_cVarSystem = nullptr;
     std::unique_ptr<core::WindowSystem> m_windowSystem = nullptr;
     std::unique_ptr<core::InputSystem> m_inputSystem = nullptr;
@@ -138,6 +158,19 @@ class RK_API Application : public NonCopyable, NonMovable {
 
     virtual void OnImGuiRender() noexcept = 0;
 
+   private:
+    /**
+     * @brief Records the live bytes and the churn since the last sample of every memory tag as profiler counters, then
+     * restarts the churn counters.
+     *
+     * @details
+     * Samples are taken at most once every c_memorySampleInterval and only when the counters changed, so an idle
+     * session does not fill the trace with identical events.
+     *
+     * @see libraries::MemoryTracker
+     */
+    void RecordMemoryCounters() noexcept;
+
    public:
     /**
      * @brief Get the state of the application.
@@ -146,6 +179,22 @@ class RK_API Application : public NonCopyable, NonMovable {
      * @see State
 	 */
     NODISCARD inline const State &GetState() const noexcept { return m_state; }
+
+    /**
+     * @brief Get the frame allocator used for per-frame temporaries.
+     *
+     * @return The frame allocator, reset at the beginning of every Update iteration.
+     * @see libraries::FrameAllocator
+     */
+    NODISCARD inline libraries::FrameAllocator &GetFrameAllocator() noexcept { return m_frameAllocator; }
+
+    /**
+     * @brief Get the manager subsystems register their memory budgets and eviction callbacks with.
+     *
+     * @return The memory budget manager, enforced at the beginning of every Update iteration.
+     * @see libraries::MemoryBudgetManager
+     */
+    NODISCARD inline libraries::MemoryBudgetManager &GetMemoryBudgetManager() noexcept { return m_memoryBudgetManager; }
 };
 
 }  // namespace Rake::application
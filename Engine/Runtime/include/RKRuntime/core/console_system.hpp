@@ -4,6 +4,8 @@
 
 #include <RKSTL/string.hpp>
 #include <RKSTL/enum.hpp>
+#include <RKSTL/memory_resource.hpp>
+#include <RKSTL/slab.hpp>
 
 #define MAX_CVAR_REGISTRY_SIZE 1024
 
@@ -49,10 +51,16 @@ class CVarSystem final : public NonCopyable, NonMovable {
 
     static inline CVarSystem *m_instance = nullptr;
 
-    std::unordered_map<std::string, std::shared_ptr<BoolCVar>> m_boolCVarReg = {};
-    std::unordered_map<std::string, std::shared_ptr<IntCVar>> m_intCVarReg = {};
-    std::unordered_map<std::string, std::shared_ptr<FloatCVar>> m_floatCVarReg = {};
-    std::unordered_map<std::string, std::shared_ptr<StringCVar>> m_stringCVarReg = {};
+    // Registry nodes and the names they hold are served by a pool local to the system instead of the global heap.
+    libraries::PoolResource<96> m_registryResource;
+
+    // CVar entries and their control blocks come from size-class slabs.
+    libraries::SlabAllocator m_cVarAllocator;
+
+    libraries::PmrStringMap<std::shared_ptr<BoolCVar>> m_boolCVarReg{&m_registryResource};
+    libraries::PmrStringMap<std::shared_ptr<IntCVar>> m_intCVarReg{&m_registryResource};
+    libraries::PmrStringMap<std::shared_ptr<FloatCVar>> m_floatCVarReg{&m_registryResource};
+    libraries::PmrStringMap<std::shared_ptr<StringCVar>> m_stringCVarReg{&m_registryResource};
 
    public:
     CVarSystem();
@@ -183,7 +191,7 @@ class CVarSystem final : public NonCopyable, NonMovable {
      * 
      * @return The console variable registry.
 	 */
-    inline const std::unordered_map<std::string, std::shared_ptr<BoolCVar>> &GetBoolReg() const noexcept {
+    inline const libraries::PmrStringMap<std::shared_ptr<BoolCVar>> &GetBoolReg() const noexcept {
         return m_boolCVarReg;
     }
 
@@ -192,7 +200,7 @@ class CVarSystem final : public NonCopyable, NonMovable {
 	 * 
 	 * @return The console variable registry.
      */
-    inline const std::unordered_map<std::string, std::shared_ptr<IntCVar>> &GetIntReg() const noexcept {
+    inline const libraries::PmrStringMap<std::shared_ptr<IntCVar>> &GetIntReg() const noexcept {
         return m_intCVarReg;
     }
 
@@ -201,7 +209,7 @@ class CVarSystem final : public NonCopyable, NonMovable {
 	 * 
 	 * @return The console variable registry.
      */
-    inline const std::unordered_map<std::string, std::shared_ptr<FloatCVar>> &GetFloatReg() const noexcept {
+    inline const libraries::PmrStringMap<std::shared_ptr<FloatCVar>> &GetFloatReg() const noexcept {
         return m_floatCVarReg;
     }
 
@@ -210,7 +218,7 @@ class CVarSystem final : public NonCopyable, NonMovable {
      * 
      * @return The console variable registry.
      */
-    inline const std::unordered_map<std::string, std::shared_ptr<StringCVar>> &GetStringReg() const noexcept {
+    inline const libraries::PmrStringMap<std::shared_ptr<StringCVar>> &GetStringReg() const noexcept {
         return m_stringCVarReg;
     }
 };
@@ -1,16 +1,28 @@
 #pragma once
 
-#include <queue>
 #include <mutex>
-#include <condition_variable>
 #include <functional>
 #include <typeindex>
 #include <unordered_map>
 #include <thread>
 #include <iostream>
 
+#include <RKSTL/pool.hpp>
+#include <RKSTL/mpsc_queue.hpp>
+#include <RKSTL/small_vector.hpp>
+#include <RKSTL/slab.hpp>
+
+#include "RKRuntime/base.hpp"
+
 namespace Rake::core {
 
+/**
+ * @brief Gets the slab allocator shared by the event producers for their handlers.
+ *
+ * @return libraries::SlabAllocator& The allocator, it lives until the end of the program.
+ */
+RK_API NODISCARD libraries::SlabAllocator &GetEventAllocator() noexcept;
+
 /**
  * @brief Represents an event with a templated data type.
  * 
@@ -88,27 +100,60 @@ class EventHandler {
 /**
  * @brief Represents an event producer that can generate and notify events to registered handlers.
  * 
+ * Events are registered through a lock-free MPSC queue, so producers never take the handler mutex and only
+ * NotifyEvents, the single consumer, takes it. Event nodes come from the thread cache of a pool, a producer only takes
+ * the pool lock when its cache runs dry and has to be refilled or the pool has to grow. Handlers, their control blocks
+ * and the nodes of the handler map are small and come from a slab allocator shared with the other producers, so a
+ * producer with a single handler does not pin slabs of its own.
+ *
  * @tparam T The type of data associated with the events.
  */
 template <typename T>
 class EventProducer final {
+    struct EventNode : public libraries::MPSCQueueHook<> {
+        Event<T> event;
+
+        EventNode(const Event<T>& _event) : event(_event) {}
+    };
+
    private:
-    std::queue<Event<T>> m_eventQueue;
+    static constexpr size_t c_nodesPerPage = 64;
+    static constexpr size_t c_inlineHandlers = 4;
+
+    using HandlerList = libraries::SmallVector<std::shared_ptr<EventHandler<T>>, c_inlineHandlers>;
+    using HandlerMapAllocator = libraries::SlabStlAllocator<std::pair<const std::thread::id, HandlerList>>;
+
+    // Queued events are served by a pool local to the producer instead of the global heap.
+    libraries::MemoryPool<EventNode> m_eventNodes{c_nodesPerPage, libraries::PoolLayout::segmented, c_nodesPerPage};
+    libraries::IntrusiveMPSCQueue<EventNode> m_eventQueue;
     std::mutex m_mutex;
-    std::condition_variable m_condition;
 
-    std::unordered_map<std::thread::id, std::vector<std::shared_ptr<EventHandler<T>>>> m_eventHandlers;
+    libraries::SlabAllocator &m_handlerAllocator;
+
+    // A producer rarely has more than a few handlers per thread, those are kept inline in the map node.
+    std::unordered_map<std::thread::id, HandlerList, std::hash<std::thread::id>, std::equal_to<std::thread::id>,
+        HandlerMapAllocator>
+        m_eventHandlers;
 
    public:
-    EventProducer() = default;
+    /**
+     * @brief Constructs an event producer.
+     *
+     * @param _handlerAllocator The allocator of the handlers, it must outlive the producer. The shared allocator is
+     * created on first use, so it also outlives producers with static storage duration.
+     */
+    explicit EventProducer(libraries::SlabAllocator& _handlerAllocator = GetEventAllocator())
+        : m_handlerAllocator(_handlerAllocator), m_eventHandlers(HandlerMapAllocator(_handlerAllocator)) {}
 
    public:
     /**
      * @brief Add an event handler to the list of registered handlers.
      * 
      * @param _handler The event handler to be added.
+     *
+     * @throw std::bad_alloc If the handler cannot be allocated.
      */
-    void AddHandler(const EventHandler<T>& _handler) noexcept;
+    void AddHandler(const EventHandler<T>& _handler);
 
     /**
      * @brief Remove the event handler associated with the current thread.
@@ -124,15 +169,19 @@ class EventProducer final {
      * @brief Register an event with the given data.
      * 
      * @param _data The data associated with the event.
+     *
+     * @throw std::bad_alloc If the node of the event cannot be allocated.
      */
-    void RegisterEvent(const T& _data) noexcept;
+    void RegisterEvent(const T& _data);
 
     /**
      * @brief Register a pre-constructed event.
      * 
      * @param _event The event to be registered.
+     *
+     * @throw std::bad_alloc If the node of the event cannot be allocated.
      */
-    void RegisterEvent(const Event<T>& _event) noexcept;
+    void RegisterEvent(const Event<T>& _event);
 
     /**
      * @brief Unregister all events from the queue.
@@ -148,23 +197,22 @@ class EventProducer final {
 
    public:
     /**
-     * @brief Get a view of the current event queue.
+     * @brief Check whether registered events are waiting to be notified, events still being registered are not seen.
      */
-    NODISCARD inline const std::queue<Event<T>>& GetEventQueue() const noexcept { return m_eventQueue; }
+    NODISCARD inline bool HasPendingEvents() noexcept {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return !m_eventQueue.empty();
+    }
 };
 
 template <typename T>
-void EventProducer<T>::AddHandler(const EventHandler<T>& _handler) noexcept {
+void EventProducer<T>::AddHandler(const EventHandler<T>& _handler) {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    auto threadId = std::this_thread::get_id();
-    auto it = m_eventHandlers.find(threadId);
+    auto handler = std::allocate_shared<EventHandler<T>>(
+        libraries::SlabStlAllocator<EventHandler<T>>(m_handlerAllocator), _handler);
 
-    if (it != m_eventHandlers.end()) {
-        it->second.push_back(std::make_shared<EventHandler<T>>(_handler));
-    } else {
-        m_eventHandlers[threadId] = {std::make_shared<EventHandler<T>>(_handler)};
-    }
+    m_eventHandlers[std::this_thread::get_id()].PushBack(std::move(handler));
 }
 
 template <typename T>
@@ -176,7 +224,7 @@ void EventProducer<T>::RemoveHandler(EventHandler<Event<T>>* _handler) noexcept
             std::find_if(handlers.begin(), handlers.end(), [_handler](const auto& h) { return h.get() == _handler; });
 
         if (it != handlers.end()) {
-            handlers.erase(it);
+            handlers.Erase(it);
             break;
         }
     }
@@ -191,37 +239,32 @@ void EventProducer<T>::RemoveAllHandlers() noexcept {
 template <typename T>
 void EventProducer<T>::UnregisterAllEvents() noexcept {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_eventQueue = std::queue<Event<T>>();
+    m_eventQueue.PopBatch([this](EventNode& _node) { m_eventNodes.Deallocate(&_node); });
 }
 
 template <typename T>
-void EventProducer<T>::RegisterEvent(const T& _data) noexcept {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_eventQueue.push(Event(_data));
-    m_condition.notify_one();
+void EventProducer<T>::RegisterEvent(const T& _data) {
+    RegisterEvent(Event(_data));
 }
 
 template <typename T>
-void EventProducer<T>::RegisterEvent(const Event<T>& _event) noexcept {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_eventQueue.push(_event);
-    m_condition.notify_one();
+void EventProducer<T>::RegisterEvent(const Event<T>& _event) {
+    m_eventQueue.Push(*m_eventNodes.Construct(_event));
 }
 
 template <typename T>
 void EventProducer<T>::NotifyEvents() noexcept {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    while (!m_eventQueue.empty()) {
-        Event<T> event = m_eventQueue.front();
-        m_eventQueue.pop();
-
+    m_eventQueue.PopBatch([this](EventNode& _node) {
         for (const auto& [tid, handlers] : m_eventHandlers) {
             for (const auto& handler : handlers) {
-                handler->HandleEvent(event);
+                handler->HandleEvent(_node.event);
             }
         }
-    }
+
+        m_eventNodes.Deallocate(&_node);
+    });
 }
 
 }  // namespace Rake::core
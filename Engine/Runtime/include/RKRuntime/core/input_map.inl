@@ -160,6 +160,174 @@ enum class ControllerAxis : uint8_t { left = 0, right = 1 };
 
 enum class ControllerTriggers : uint8_t { left = 0, right = 1 };
 
+// Names of the inputs as written in InputMappings.json, built into collision-free tables at compile time.
+
+inline constexpr auto c_keyboardKeyNames = libraries::MakePerfectHashMap<KeyboardKeys>({
+    {"backspace", KeyboardKeys::backspace},
+    {"tab", KeyboardKeys::tab},
+    {"clear", KeyboardKeys::clear},
+    {"returnKey", KeyboardKeys::returnKey},
+    {"shift", KeyboardKeys::shift},
+    {"control", KeyboardKeys::control},
+    {"menu", KeyboardKeys::menu},
+    {"pause", KeyboardKeys::pause},
+    {"capital", KeyboardKeys::capital},
+    {"escape", KeyboardKeys::escape},
+    {"space", KeyboardKeys::space},
+    {"pageUp", KeyboardKeys::pageUp},
+    {"pageDown", KeyboardKeys::pageDown},
+    {"end", KeyboardKeys::end},
+    {"home", KeyboardKeys::home},
+    {"left", KeyboardKeys::left},
+    {"up", KeyboardKeys::up},
+    {"right", KeyboardKeys::right},
+    {"down", KeyboardKeys::down},
+    {"select", KeyboardKeys::select},
+    {"print", KeyboardKeys::print},
+    {"execute", KeyboardKeys::execute},
+    {"snapshot", KeyboardKeys::snapshot},
+    {"insert", KeyboardKeys::insert},
+    {"deleteKey", KeyboardKeys::deleteKey},
+    {"help", KeyboardKeys::help},
+    {"zero", KeyboardKeys::zero},
+    {"one", KeyboardKeys::one},
+    {"two", KeyboardKeys::two},
+    {"three", KeyboardKeys::three},
+    {"four", KeyboardKeys::four},
+    {"five", KeyboardKeys::five},
+    {"six", KeyboardKeys::six},
+    {"seven", KeyboardKeys::seven},
+    {"eight", KeyboardKeys::eight},
+    {"nine", KeyboardKeys::nine},
+    {"a", KeyboardKeys::a},
+    {"b", KeyboardKeys::b},
+    {"c", KeyboardKeys::c},
+    {"d", KeyboardKeys::d},
+    {"e", KeyboardKeys::e},
+    {"f", KeyboardKeys::f},
+    {"g", KeyboardKeys::g},
+    {"h", KeyboardKeys::h},
+    {"i", KeyboardKeys::i},
+    {"j", KeyboardKeys::j},
+    {"k", KeyboardKeys::k},
+    {"l", KeyboardKeys::l},
+    {"m", KeyboardKeys::m},
+    {"n", KeyboardKeys::n},
+    {"o", KeyboardKeys::o},
+    {"p", KeyboardKeys::p},
+    {"q", KeyboardKeys::q},
+    {"r", KeyboardKeys::r},
+    {"s", KeyboardKeys::s},
+    {"t", KeyboardKeys::t},
+    {"u", KeyboardKeys::u},
+    {"v", KeyboardKeys::v},
+    {"w", KeyboardKeys::w},
+    {"x", KeyboardKeys::x},
+    {"y", KeyboardKeys::y},
+    {"z", KeyboardKeys::z},
+    {"leftWin", KeyboardKeys::leftWin},
+    {"rightWin", KeyboardKeys::rightWin},
+    {"apps", KeyboardKeys::apps},
+    {"sleep", KeyboardKeys::sleep},
+    {"numpad0", KeyboardKeys::numpad0},
+    {"numpad1", KeyboardKeys::numpad1},
+    {"numpad2", KeyboardKeys::numpad2},
+    {"numpad3", KeyboardKeys::numpad3},
+    {"numpad4", KeyboardKeys::numpad4},
+    {"numpad5", KeyboardKeys::numpad5},
+    {"numpad6", KeyboardKeys::numpad6},
+    {"numpad7", KeyboardKeys::numpad7},
+    {"numpad8", KeyboardKeys::numpad8},
+    {"numpad9", KeyboardKeys::numpad9},
+    {"multiply", KeyboardKeys::multiply},
+    {"add", KeyboardKeys::add},
+    {"separator", KeyboardKeys::separator},
+    {"subtract", KeyboardKeys::subtract},
+    {"decimal", KeyboardKeys::decimal},
+    {"divide", KeyboardKeys::divide},
+    {"f1", KeyboardKeys::f1},
+    {"f2", KeyboardKeys::f2},
+    {"f3", KeyboardKeys::f3},
+    {"f4", KeyboardKeys::f4},
+    {"f5", KeyboardKeys::f5},
+    {"f6", KeyboardKeys::f6},
+    {"f7", KeyboardKeys::f7},
+    {"f8", KeyboardKeys::f8},
+    {"f9", KeyboardKeys::f9},
+    {"f10", KeyboardKeys::f10},
+    {"f11", KeyboardKeys::f11},
+    {"f12", KeyboardKeys::f12},
+    {"numLock", KeyboardKeys::numLock},
+    {"scroll", KeyboardKeys::scroll},
+    {"lShift", KeyboardKeys::lShift},
+    {"rShift", KeyboardKeys::rShift},
+    {"lControl", KeyboardKeys::lControl},
+    {"rControl", KeyboardKeys::rControl},
+    {"lMenu", KeyboardKeys::lMenu},
+    {"rMenu", KeyboardKeys::rMenu},
+    {"oem1", KeyboardKeys::oem1},
+    {"oemPlus", KeyboardKeys::oemPlus},
+    {"oemComma", KeyboardKeys::oemComma},
+    {"oemMinus", KeyboardKeys::oemMinus},
+    {"oemPeriod", KeyboardKeys::oemPeriod},
+    {"oem2", KeyboardKeys::oem2},
+    {"oem3", KeyboardKeys::oem3},
+    {"oem4", KeyboardKeys::oem4},
+    {"oem5", KeyboardKeys::oem5},
+    {"oem6", KeyboardKeys::oem6},
+    {"oem7", KeyboardKeys::oem7},
+    {"oem8", KeyboardKeys::oem8},
+    {"oem9", KeyboardKeys::oem9},
+    {"processKey", KeyboardKeys::processKey},
+    {"packet", KeyboardKeys::packet},
+    {"attn", KeyboardKeys::attn},
+    {"crsel", KeyboardKeys::crsel},
+    {"exsel", KeyboardKeys::exsel},
+    {"ereof", KeyboardKeys::ereof},
+    {"play", KeyboardKeys::play},
+    {"zoom", KeyboardKeys::zoom},
+    {"noname", KeyboardKeys::noname},
+    {"pa1", KeyboardKeys::pa1},
+    {"oemClear", KeyboardKeys::oemClear}
+});
+
+inline constexpr auto c_mouseButtonNames = libraries::MakePerfectHashMap<MouseButtons>({
+    {"left", MouseButtons::left},
+    {"middle", MouseButtons::middle},
+    {"right", MouseButtons::right},
+    {"button4", MouseButtons::button4},
+    {"button5", MouseButtons::button5}
+});
+
+inline constexpr auto c_controllerButtonNames = libraries::MakePerfectHashMap<ControllerButtons>({
+    {"a", ControllerButtons::a},
+    {"b", ControllerButtons::b},
+    {"x", ControllerButtons::x},
+    {"y", ControllerButtons::y},
+    {"ex", ControllerButtons::ex},
+    {"circle", ControllerButtons::circle},
+    {"square", ControllerButtons::square},
+    {"triangle", ControllerButtons::triangle},
+    {"left", ControllerButtons::left},
+    {"right", ControllerButtons::right},
+    {"up", ControllerButtons::up},
+    {"down", ControllerButtons::down},
+    {"leftThumbstick", ControllerButtons::leftThumbstick},
+    {"rightThumbstick", ControllerButtons::rightThumbstick},
+    {"leftShoulder", ControllerButtons::leftShoulder},
+    {"rightShoulder", ControllerButtons::rightShoulder}
+});
+
+inline constexpr auto c_controllerStickNames = libraries::MakePerfectHashMap<ControllerSticks>({
+    {"left", ControllerSticks::left},
+    {"right", ControllerSticks::right}
+});
+
+inline constexpr auto c_controllerTriggerNames = libraries::MakePerfectHashMap<ControllerTriggers>({
+    {"left", ControllerTriggers::left},
+    {"right", ControllerTriggers::right}
+});
+
 }  // namespace Rake::core
 
 #define RK_KEYBOARD_KEY_0          Rake::core::KeyboardKeys::zero
@@ -1,6 +1,18 @@
 #pragma once
 
+#include <limits>
+#include <string>
+#include <charconv>
+#include <string_view>
+#include <vector>
+#include <optional>
+
 #include <glm/vec2.hpp>
+#include <nlohmann/json.hpp>
+
+#include <RKSTL/flat_hash_map.hpp>
+#include <RKSTL/perfect_hash_map.hpp>
+#include <RKSTL/string_id.hpp>
 
 #include "RKRuntime/base.hpp"
 
@@ -8,7 +20,126 @@
 
 namespace Rake::core {
 
-using Action = std::string;
+// Action literals are hashed at compile time, so the per-frame lookups compare 64-bit integers instead of strings.
+// Mappings are saved by name, actions that were never interned have none and are saved by hash instead.
+using Action = libraries::StringId;
+
+// Prefix of the keys saving actions by hash, followed by the 16 hexadecimal digits of the hash.
+inline constexpr char c_actionHashPrefix = '#';
+
+/**
+ * @brief Gets the key an action is saved under, its interned name or its prefixed hash if it has none.
+ */
+inline std::string GetActionKey(Action _action) {
+    const std::string_view name = _action.GetString();
+
+    if (!name.empty()) return std::string(name);
+
+    std::string key(17, '0');
+
+    key[0] = c_actionHashPrefix;
+
+    for (size_t i = 0; i < 16; ++i) key[16 - i] = "0123456789abcdef"[(_action.GetHash() >> (i * 4)) & 0xF];
+
+    return key;
+}
+
+/**
+ * @brief Parses a key written by GetActionKey, names are interned and prefixed hashes restore the action as is.
+ */
+inline Action ParseActionKey(std::string_view _key) {
+    if (_key.size() == 17 && _key[0] == c_actionHashPrefix) {
+        uint64_t hash = 0;
+
+        const char *last = _key.data() + _key.size();
+        const auto [end, error] = std::from_chars(_key.data() + 1, last, hash, 16);
+
+        if (error == std::errc() && end == last) return Action::FromHash(hash);
+    }
+
+    return Action::Intern(_key);
+}
+
+// Actions are looked up every frame, a flat table keeps the lookup on one control group and one slot.
+template <typename T>
+using InputMap = libraries::FlatHashMap<Action, T>;
+
+/**
+ * @brief Parses an input saved by name, or by value as in the mappings saved before inputs had names.
+ *
+ * @return std::optional<Input> The input, or std::nullopt if the entry is neither a known name nor a valid value.
+ */
+template <typename Input, size_t N>
+std::optional<Input> ParseInput(const nlohmann::json &_input,
+                                const libraries::PerfectHashMap<Input, N> &_names) noexcept {
+    using Value = std::underlying_type_t<Input>;
+
+    if (_input.is_string()) {
+        const Input *input = _names.Find(_input.get_ref<const std::string &>());
+
+        return input ? std::optional<Input>(*input) : std::nullopt;
+    }
+
+    if (_input.is_number_integer()) {
+        const int64_t value = _input.get<int64_t>();
+
+        if (value >= 0 && value <= std::numeric_limits<Value>::max()) return static_cast<Input>(value);
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Gets the name an input is saved under, or its value if it has none.
+ */
+template <typename Input, size_t N>
+nlohmann::json GetInputName(Input _input, const libraries::PerfectHashMap<Input, N> &_names) {
+    // Only used when saving, a scan of the entries spares a second table per input type.
+    for (const auto &[name, input] : _names) {
+        if (input == _input) return name;
+    }
+
+    return static_cast<std::underlying_type_t<Input>>(_input);
+}
+
+/**
+ * @brief Reads an input map saved in InputMappings.json, a bad entry is skipped without discarding the others.
+ *
+ * @return std::vector<std::string> The actions whose entry could not be read.
+ */
+template <typename Input, size_t N>
+std::vector<std::string> ReadInputMap(const nlohmann::json &_data, InputMap<Input> &_inputMap,
+                                      const libraries::PerfectHashMap<Input, N> &_names) {
+    std::vector<std::string> skipped;
+
+    if (!_data.is_object()) return skipped;
+
+    for (const auto &[action, input] : _data.items()) {
+        const std::optional<Input> parsed = ParseInput(input, _names);
+
+        if (parsed) {
+            _inputMap[ParseActionKey(action)] = *parsed;
+        } else {
+            skipped.push_back(action);
+        }
+    }
+
+    return skipped;
+}
+
+/**
+ * @brief Writes an input map in the InputMappings.json format.
+ *
+ * @note Actions that were never interned are saved by hash, see GetActionKey.
+ */
+template <typename Input, size_t N>
+nlohmann::json WriteInputMap(const InputMap<Input> &_inputMap, const libraries::PerfectHashMap<Input, N> &_names) {
+    nlohmann::json data = nlohmann::json::object();
+
+    for (const auto &[action, input] : _inputMap) data[GetActionKey(action)] = GetInputName(input, _names);
+
+    return data;
+}
 
 struct Keyboard {
     struct InputState {
@@ -16,7 +147,7 @@ struct Keyboard {
     };
 
     bool connected = false;
-    std::unordered_map<Action, KeyboardKeys> inputMap = {};
+    InputMap<KeyboardKeys> inputMap = {};
     InputState inputState = {};
     InputState lastInputState = {};
 };
@@ -30,7 +161,7 @@ struct Mouse {
 
     bool connected = false;
     float battery = 0.f;
-    std::unordered_map<Action, MouseButtons> inputMap = {};
+    InputMap<MouseButtons> inputMap = {};
     int8_t flipAxis[2] = {1, 1};
     int8_t flipWheel = 1;
     InputState inputState = {};
@@ -46,9 +177,9 @@ struct Controller {
 
     bool connected = false;
     float battery = 0.f;
-    std::unordered_map<Action, ControllerButtons> buttonsInputMap = {};
-    std::unordered_map<Action, ControllerTriggers> triggersInputMap = {};
-    std::unordered_map<Action, ControllerSticks> sticksInputMap = {};
+    InputMap<ControllerButtons> buttonsInputMap = {};
+    InputMap<ControllerTriggers> triggersInputMap = {};
+    InputMap<ControllerSticks> sticksInputMap = {};
     int8_t flipAxis[4] = {1, 1, 1, 1};
     InputState inputState = {};
     InputState lastInputState = {};
@@ -91,7 +222,7 @@ class InputSystem : public NonCopyable, NonMovable {
      * 
      * @param _inputMap The new keyboard input map.
      */
-    RK_API void SetKeyboardInputMap(const std::unordered_map<Action, KeyboardKeys> &_inputMap) noexcept;
+    RK_API void SetKeyboardInputMap(const InputMap<KeyboardKeys> &_inputMap) noexcept;
 
     /**
      * @brief Set the mouse input map.
@@ -100,7 +231,7 @@ class InputSystem : public NonCopyable, NonMovable {
      * @see MouseButtons
      * @see Action
 	 */
-    RK_API void SetMouseInputMap(const std::unordered_map<Action, MouseButtons> &_inputMap) noexcept;
+    RK_API void SetMouseInputMap(const InputMap<MouseButtons> &_inputMap) noexcept;
 
     /**
      * @brief Set the controller buttons input map.
@@ -109,7 +240,7 @@ class InputSystem : public NonCopyable, NonMovable {
      * @see ControllerButtons
      * @see Action
      */
-    RK_API void SetControllerButtonsInputMap(const std::unordered_map<Action, ControllerButtons> &_inputMap) noexcept;
+    RK_API void SetControllerButtonsInputMap(const InputMap<ControllerButtons> &_inputMap) noexcept;
 
     /**
 	 * @brief Set the controller sticks input map.
@@ -118,7 +249,7 @@ class InputSystem : public NonCopyable, NonMovable {
 	 * @see ControllerSticks
 	 * @see Action
      */
-    RK_API void SetControllerSticksInputMap(const std::unordered_map<Action, ControllerSticks> &_inputMap) noexcept;
+    RK_API void SetControllerSticksInputMap(const InputMap<ControllerSticks> &_inputMap) noexcept;
 
     /**
      * @brief Set the controller triggers input map.
@@ -127,7 +258,7 @@ class InputSystem : public NonCopyable, NonMovable {
      * @see ControllerTriggers
      * @see Action
      */
-    RK_API void SetControllerTriggersInputMap(const std::unordered_map<Action, ControllerTriggers> &_inputMap) noexcept;
+    RK_API void SetControllerTriggersInputMap(const InputMap<ControllerTriggers> &_inputMap) noexcept;
 
     /**
 	 * @brief Flip the mouse wheel scroll axis.
@@ -285,25 +416,21 @@ class InputSystem : public NonCopyable, NonMovable {
 	 * 
 	 * @return The keyboard keys input map.
      */
-    inline const std::unordered_map<Action, KeyboardKeys> &GetKeyboardInputMap() const noexcept {
-        return m_keyboard.inputMap;
-    }
+    inline const InputMap<KeyboardKeys> &GetKeyboardInputMap() const noexcept { return m_keyboard.inputMap; }
 
     /**
      * @brief Get the mouse buttons input map.
      * 
      * @return The mouse buttons input map.
 	 */
-    inline const std::unordered_map<Action, MouseButtons> &GetMouseInputMap() const noexcept {
-        return m_mouse.inputMap;
-    }
+    inline const InputMap<MouseButtons> &GetMouseInputMap() const noexcept { return m_mouse.inputMap; }
 
     /**
 	 * @brief Get the controller buttons input map.
 	 * 
 	 * @return The controller buttons input map.
      */
-    inline const std::unordered_map<Action, ControllerButtons> &GetControllerButtonsInputMap() const noexcept {
+    inline const InputMap<ControllerButtons> &GetControllerButtonsInputMap() const noexcept {
         return m_controller.buttonsInputMap;
     }
 
@@ -312,7 +439,7 @@ class InputSystem : public NonCopyable, NonMovable {
 	 * 
 	 * @return The controller sticks input map.
      */
-    inline const std::unordered_map<Action, ControllerSticks> &GetControllerSticksInputMap() const noexcept {
+    inline const InputMap<ControllerSticks> &GetControllerSticksInputMap() const noexcept {
         return m_controller.sticksInputMap;
     }
 
@@ -321,7 +448,7 @@ class InputSystem : public NonCopyable, NonMovable {
      * 
      * @return The controller triggers input map.
 	 */
-    inline const std::unordered_map<Action, ControllerTriggers> &GetControllerTriggersInputMap() const noexcept {
+    inline const InputMap<ControllerTriggers> &GetControllerTriggersInputMap() const noexcept {
         return m_controller.triggersInputMap;
     }
 
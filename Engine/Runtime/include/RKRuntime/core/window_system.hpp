@@ -2,6 +2,9 @@
 
 #include "RKRuntime/base.hpp"
 
+#include <RKSTL/small_vector.hpp>
+#include <RKSTL/memory_resource.hpp>
+
 #include <glm/vec2.hpp>
 
 namespace Rake::core {
@@ -225,6 +228,18 @@ class Window {
     NODISCARD inline const State &GetState() const noexcept { return m_state; }
 };
 
+/**
+ * @brief The window registry, window names mapped to their window handles.
+ */
+using WindowRegistry = libraries::PmrConcurrentStringMap<std::shared_ptr<Window>>;
+
+/**
+ * @brief The native window registry, native window handles mapped to their window names.
+ */
+using NativeWindowRegistry =
+    libraries::ConcurrentHashMap<void *, std::pmr::string, libraries::FlatHash<void *>, std::equal_to<>,
+                                 std::pmr::polymorphic_allocator<std::pair<void *, std::pmr::string>>>;
+
 /**
  * @brief The WindowSystem class is an abstract class that represents a windowing system.
  * 
@@ -239,9 +254,24 @@ class WindowSystem : public NonCopyable, NonMovable {
    protected:
     static inline WindowSystem *m_instance = nullptr;
 
-    std::vector<std::string> m_windowsToDestroy;
-    std::unordered_map<std::string, std::shared_ptr<Window>> m_windowRegistry;
-    std::unordered_map<void *, std::string> m_nativeWindowRegistry;
+    static constexpr size_t c_registryShards = 16;
+
+    // A pool block holds a shard table until it outgrows its first capacity, so a few windows never reach the heap.
+    libraries::PoolResource<std::max(WindowRegistry::map_type::GetAllocationSize(),
+                                     NativeWindowRegistry::map_type::GetAllocationSize())>
+        m_registryResource;
+
+    // Windows are destroyed a few at a time, the names queued during a frame stay inline. DestroyWindow may be called
+    // from any thread and from a window message handler while Update destroys another window.
+    std::mutex m_destroyMutex;
+    libraries::SmallVector<std::string, 4> m_windowsToDestroy;
+
+    // Kept next to the registry so that ShouldClose does not lock every shard each frame.
+    std::atomic<size_t> m_windowCount = 0;
+
+    // Windows are looked up from any thread, each shard of the registries is locked on its own.
+    WindowRegistry m_windowRegistry{c_registryShards, &m_registryResource};
+    NativeWindowRegistry m_nativeWindowRegistry{c_registryShards, &m_registryResource};
 
    public:
     WindowSystem();
@@ -265,7 +295,7 @@ class WindowSystem : public NonCopyable, NonMovable {
     bool ShouldClose() noexcept;
 
    public:
-    RK_API virtual const std::shared_ptr<Window> &CreateWindow(const std::string &_name) noexcept;
+    RK_API virtual std::shared_ptr<Window> CreateWindow(const std::string &_name) noexcept;
     RK_API virtual void DestroyWindow(const std::string &_name) noexcept;
 
    private:
@@ -315,8 +345,7 @@ class WindowSystem : public NonCopyable, NonMovable {
      * @return The window registry.
      * @note The window registry is a map of window names and their corresponding window handles.
 	 */
-    RK_API NODISCARD static const std::unordered_map<std::string, std::shared_ptr<Window>> &
-    GetWindowRegistry() noexcept;
+    RK_API NODISCARD static const WindowRegistry &GetWindowRegistry() noexcept;
 
     /**
      * @brief Get the native window registry.
@@ -324,7 +353,7 @@ class WindowSystem : public NonCopyable, NonMovable {
      * @return The native window registry.
      * @note The native window registry is a map of native window handles and their corresponding window names.
      */
-    RK_API NODISCARD static const std::unordered_map<void *, std::string> &GetNativeWindowRegistry() noexcept;
+    RK_API NODISCARD static const NativeWindowRegistry &GetNativeWindowRegistry() noexcept;
 
     /**
      * @brief Create a native window system.
@@ -4,6 +4,8 @@
 
 #include <entt/entt.hpp>
 
+#include <RKSTL/flat_hash_map.hpp>
+
 #include "Components.hpp"
 
 namespace Rake::engine::entity {
@@ -23,7 +25,7 @@ class Scene {
     std::string name = "";
 
     entt::registry m_registry;
-    std::unordered_map<uint64_t, entt::entity> m_entities;
+    libraries::FlatHashMap<uint64_t, entt::entity> m_entities;
 
    public:
     Scene();
@@ -55,9 +57,9 @@ class Scene {
         return m_registry.view<Components...>();
     }
 
-    NODISCARD inline std::unordered_map<uint64_t, entt::entity> &GetEntityMap() noexcept { m_entities; }
+    NODISCARD inline libraries::FlatHashMap<uint64_t, entt::entity> &GetEntityMap() noexcept { return m_entities; }
 
-    NODISCARD inline entt::entity &GetEntityWithUUID(uint64_t _UUID) noexcept { return m_entities.at(_UUID); }
+    NODISCARD inline entt::entity &GetEntityWithUUID(uint64_t _UUID) noexcept { return m_entities.At(_UUID); }
 };
 
 class SceneSerializer final {
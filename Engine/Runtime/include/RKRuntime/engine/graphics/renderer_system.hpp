@@ -32,6 +32,11 @@ class RenderingContext {
     virtual void Render() noexcept = 0;
 };
 
+/**
+ * @brief The context registry, context names mapped to their rendering contexts.
+ */
+using ContextRegistry = libraries::PmrConcurrentStringMap<std::shared_ptr<RenderingContext>>;
+
 /**
  * @brief The RendererSystem class is an abstract class that represents a rendering system.
  * 
@@ -54,7 +59,13 @@ class RendererSystem {
 
     static Config m_config;
 
-    std::unordered_map<std::string, std::shared_ptr<RenderingContext>> m_contextRegistry;
+    static constexpr size_t c_registryShards = 16;
+
+    // A pool block holds a shard table until it outgrows its first capacity, so a few contexts never reach the heap.
+    libraries::PoolResource<ContextRegistry::map_type::GetAllocationSize()> m_registryResource;
+
+    // Contexts are looked up from any thread, each shard of the registry is locked on its own.
+    ContextRegistry m_contextRegistry{c_registryShards, &m_registryResource};
 
    public:
     RendererSystem();
@@ -70,7 +81,7 @@ class RendererSystem {
     void Render() noexcept;
 
    public:
-    RK_API virtual const std::shared_ptr<RenderingContext>& CreateContext(
+    RK_API virtual std::shared_ptr<RenderingContext> CreateContext(
         const std::string& _name, const std::shared_ptr<core::Window>& _window) noexcept = 0;
     RK_API virtual void DestroyContext(const std::string& _name) noexcept = 0;
 
@@ -108,10 +119,9 @@ class RendererSystem {
     /**
 	 * @brief Get the context registry.
 	 * 
-	 * @return The context registry as a const reference to an unordered map.
+	 * @return The context registry as a const reference.
 	 */
-    RK_API NODISCARD static const std::unordered_map<std::string, std::shared_ptr<RenderingContext>>&
-    GetContextRegistry() noexcept;
+    RK_API NODISCARD static const ContextRegistry& GetContextRegistry() noexcept;
 
     /**
      * @brief Create the choosen rendering system.
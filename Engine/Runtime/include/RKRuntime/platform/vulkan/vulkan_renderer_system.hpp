@@ -34,7 +34,7 @@ class VulkanRendererSystem final : public engine::graphics::RendererSystem {
     ~VulkanRendererSystem() override;
 
    public:
-    std::shared_ptr<engine::graphics::RenderingContext>& CreateContext(
+    std::shared_ptr<engine::graphics::RenderingContext> CreateContext(
         const std::string& _name, const std::shared_ptr<core::Window>& _window) noexcept override;
     void DestroyContext(const std::string& _name) noexcept override;
 };
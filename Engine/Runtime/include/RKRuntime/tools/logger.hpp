@@ -8,6 +8,7 @@
 #include "RKRuntime/core/file_system.hpp"
 
 #include <RKSTL/string.hpp>
+#include <RKSTL/memory_budget.hpp>
 
 #define RESET   "\033[0m"
 #define RED     "\033[31m"
@@ -32,6 +33,10 @@ namespace Rake::tools {
  * @see The Logger class is a static class, so it doesn't need to be instantiated.
  */
 class RK_API Logger final {
+   public:
+    // Size in bytes of the buffered messages past which the logging functions flush them.
+    static constexpr size_t c_flushThreshold = RK_KIBIBYTES(20);
+
    private:
     static std::wstring m_sessionName;
     static std::wstring m_logsPath;
@@ -60,13 +65,32 @@ class RK_API Logger final {
 	 */
     static void Shutdown() noexcept;
 
+    /**
+     * @brief Flushes the message pool to the log file and releases it.
+     */
+    static void Flush() noexcept;
+
+    /**
+     * @brief Gets the size in bytes of the messages waiting in the message pool.
+     */
+    NODISCARD static size_t GetBufferedBytes() noexcept { return m_msgPoolSize * sizeof(wchar_t); }
+
+    /**
+     * @brief Registers the message pool under the logger memory tag, flushing it when it exceeds the budget.
+     * 
+     * @param _manager The manager enforcing the budget.
+     * @param _softLimit The pool size in bytes past which it is flushed.
+     * @param _hardLimit The pool size in bytes past which the flush is mandatory.
+     */
+    static void RegisterMemoryBudget(libraries::MemoryBudgetManager &_manager, size_t _softLimit, size_t _hardLimit);
+
    private:
     /**
-	 * @brief Flushes the message pool to the log file.
+	 * @brief Flushes the message pool to the log file once it reaches c_flushThreshold bytes.
 	 * 
-	 * @note This function is called automatically by the logging functions when the message pool reaches a certain size to avoid continuous writing to the file.
+	 * @note This function is called automatically by the logging functions to avoid continuous writing to the file.
 	 */
-    static void Flush() noexcept;
+    static void FlushIfFull() noexcept;
 
    public:
     template <typename... _Args>
@@ -103,7 +127,7 @@ void Logger::Fatal(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 template <typename... _Args>
@@ -117,7 +141,7 @@ void Logger::Error(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 template <typename... _Args>
@@ -131,7 +155,7 @@ void Logger::Warn(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 template <typename... _Args>
@@ -145,7 +169,7 @@ void Logger::Info(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 #ifdef RK_LOG_DEBUG_ENABLED
@@ -161,7 +185,7 @@ void Logger::Debug(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 #endif
@@ -179,7 +203,7 @@ void Logger::Trace(const std::wstring &_format, _Args &&..._args) noexcept {
     m_msgPool << msg;
     m_msgPoolSize += msg.size();
 
-    Flush();
+    FlushIfFull();
 }
 
 #endif
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <stack>
-#include <unordered_map>
+#include <utility>
+#include <string_view>
 #include <mutex>
 #include <thread>
 #include <atomic>
@@ -13,6 +15,7 @@
 #include "RKRuntime/core/file_system.hpp"
 
 #include <RKSTL/string.hpp>
+#include <RKSTL/memory_budget.hpp>
 
 namespace Rake::tools {
 
@@ -31,13 +34,22 @@ enum class ProfileCategory : uint8_t {
  * The Profiler class is responsible for profiling the application. It can profile functions and scopes, and save the data to a file.
  * The file name is the session name followed by the date and time of the session with the .json extension (e.g. "sessionName_2021-01-01_00;00;00.json").
  * The file is saved in the directory specified by the _profilesDir parameter of the Initialize function.
+ * Trace events are buffered and appended to the file whenever the buffer holds c_maxBufferedEvents of them, so a long
+ * session keeps a bounded amount of memory. The file is a valid trace once Shutdown closed the event array.
  * 
  * @see The Profiler class is a static class, so it doesn't need to be instantiated.
  */
 class RK_API Profiler final {
+   public:
+    using CounterSeries = std::pair<std::string_view, int64_t>;
+
    private:
     static inline std::string m_categories[2] = {"function", "scope"};
 
+    static constexpr size_t c_maxBufferedEvents = 4096;
+    // Rough heap footprint of a buffered trace event, a json object of up to seven members and the strings it owns.
+    static constexpr size_t c_bufferedEventSize = 512;
+
     struct Profile {
         ProfileCategory category;
         std::wstring name;
@@ -49,6 +61,7 @@ class RK_API Profiler final {
     static std::wstring m_sessionName;
     static std::wstring m_profilesPath;
     static std::stack<Profile> m_activeProfiles;
+    static size_t m_flushedEvents;
     static std::mutex m_mutex;
     static bool m_initialized;
 
@@ -88,6 +101,47 @@ class RK_API Profiler final {
      * @brief Ends profiling a function or scope.
      */
     static void EndProfile() noexcept;
+
+    /**
+     * @brief Records the current values of a counter track, drawn as a stacked graph by the trace viewer.
+     * 
+     * @param _name The name of the counter track.
+     * @param _series The name and the value of every series of the track.
+     */
+    static void RecordCounter(const std::wstring &_name, std::span<const CounterSeries> _series) noexcept;
+
+    /**
+     * @brief Appends the buffered trace events to the profile file and releases them.
+     * 
+     * @note The buffer is flushed automatically when it is full, flushing earlier bounds it further, e.g. under memory
+     * pressure.
+     */
+    static void Flush() noexcept;
+
+    /**
+     * @brief Gets the number of trace events waiting to be written to the profile file.
+     */
+    NODISCARD static size_t GetBufferedEventCount() noexcept;
+
+    /**
+     * @brief Gets an estimate of the memory in bytes held by the trace events waiting to be written.
+     */
+    NODISCARD static size_t GetBufferedBytes() noexcept { return GetBufferedEventCount() * c_bufferedEventSize; }
+
+    /**
+     * @brief Registers the trace event buffer under the profiler memory tag, flushing it when it exceeds the budget.
+     * 
+     * @param _manager The manager enforcing the budget.
+     * @param _softLimit The buffer size in bytes past which it is flushed.
+     * @param _hardLimit The buffer size in bytes past which the flush is mandatory.
+     */
+    static void RegisterMemoryBudget(libraries::MemoryBudgetManager &_manager, size_t _softLimit, size_t _hardLimit);
+
+   private:
+    /**
+     * @brief Appends the buffered trace events to the profile file, the caller must hold the profiler mutex.
+     */
+    static void FlushEvents() noexcept;
 };
 
 }  // namespace Rake::tools
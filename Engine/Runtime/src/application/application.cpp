@@ -13,17 +13,54 @@ Application::Application() {
 
     m_instance = this;
 
-    tools::Logger::Initialize(L"DebugSession", L"./logs");
-    tools::Profiler::Initialize(L"DebugSession", L"./profiles");
+    using libraries::MemoryTag;
+    using libraries::MemoryTagScope;
+
+    // The log and trace buffers are flushed to their files between frames once they exceed their budgets.
+    {
+        MemoryTagScope tagScope(MemoryTag::logger);
+        tools::Logger::Initialize(L"DebugSession", L"./logs");
+        tools::Logger::RegisterMemoryBudget(m_memoryBudgetManager, c_loggerBudget.first, c_loggerBudget.second);
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::profiler);
+        tools::Profiler::Initialize(L"DebugSession", L"./profiles");
+        tools::Profiler::RegisterMemoryBudget(m_memoryBudgetManager, c_profilerBudget.first, c_profilerBudget.second);
+    }
 
     Rake::tools::Profiler::BeginProfile(L"Initialization - Global", Rake::tools::ProfileCategory::function);
 
-    m_cVarSystem = std::make_unique<core::CVarSystem>();
-    m_windowSystem = core::WindowSystem::CreateNative();
-    m_inputSystem = core::InputSystem::CreateNative();
-    m_scene = std::make_unique<engine::entity::Scene>();
-    m_rendererSystem = engine::graphics::RendererSystem::CreateWithBackend();
-    m_pythonFFISystem = std::make_unique<engine::scripting::PythonFFISystem>();
+    // Allocators created by a subsystem account their memory to the tag current at their construction.
+    {
+        MemoryTagScope tagScope(MemoryTag::console);
+        m_cVarSystem = std::make_unique<core::CVarSystem>();
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::windowing);
+        m_windowSystem = core::WindowSystem::CreateNative();
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::input);
+        m_inputSystem = core::InputSystem::CreateNative();
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::ecs);
+        m_scene = std::make_unique<engine::entity::Scene>();
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::renderer);
+        m_rendererSystem = engine::graphics::RendererSystem::CreateWithBackend();
+    }
+
+    {
+        MemoryTagScope tagScope(MemoryTag::python);
+        m_pythonFFISystem = std::make_unique<engine::scripting::PythonFFISystem>();
+    }
 
     tools::Profiler::EndProfile();
 }
@@ -70,6 +107,18 @@ void Application::Update() noexcept {
     while (m_state.isRunning && !m_windowSystem->ShouldClose()) {
         if (m_state.isPaused) continue;
 
+        // Allocations from the frame before the previous one are released, the previous frame ones stay readable.
+        m_frameAllocator.BeginFrame();
+
+        RecordMemoryCounters();
+
+        // Subsystems past their budget evict between frames, before the process grows enough to be paged out.
+        try {
+            m_memoryBudgetManager.Enforce();
+        } catch (const std::exception &e) {
+            tools::Logger::Error(L"Memory budget eviction failed: {}", libraries::ByteToWideString(e.what()));
+        }
+
         m_timer.Tick();
 
         OnUpdate();
@@ -80,6 +129,44 @@ void Application::Update() noexcept {
     }
 }
 
+void Application::RecordMemoryCounters() noexcept {
+    const std::chrono::milliseconds now = m_timer.GetElapsedTime();
+
+    if (now - m_lastMemorySampleTime < c_memorySampleInterval) return;
+
+    m_lastMemorySampleTime = now;
+
+    const libraries::MemorySnapshot snapshot = libraries::MemoryTracker::GetSnapshot();
+
+    bool changed = false;
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        changed |= snapshot[i].churn > 0 || snapshot[i].liveBytes != m_lastMemorySnapshot[i].liveBytes;
+    }
+
+    if (!changed) return;
+
+    m_lastMemorySnapshot = snapshot;
+
+    using CounterSeries = tools::Profiler::CounterSeries;
+
+    // The series only live until the profiler serialized them, the frame allocator serves them without the heap.
+    CounterSeries *liveBytes = m_frameAllocator.AllocateArray<CounterSeries>(snapshot.size());
+    CounterSeries *churn = m_frameAllocator.AllocateArray<CounterSeries>(snapshot.size());
+
+    for (size_t i = 0; i < snapshot.size(); ++i) {
+        const std::string_view name = libraries::MemoryTracker::GetTagName(static_cast<libraries::MemoryTag>(i));
+
+        std::construct_at(liveBytes + i, name, static_cast<int64_t>(snapshot[i].liveBytes));
+        std::construct_at(churn + i, name, static_cast<int64_t>(snapshot[i].churn));
+    }
+
+    tools::Profiler::RecordCounter(L"Memory - Live bytes", {liveBytes, snapshot.size()});
+    tools::Profiler::RecordCounter(L"Memory - Churn per sample", {churn, snapshot.size()});
+
+    libraries::MemoryTracker::ResetChurn();
+}
+
 void Application::Stop() noexcept {
     if (m_state.isRunning) {
         std::lock_guard<std::mutex> lock(m_state.mutex);
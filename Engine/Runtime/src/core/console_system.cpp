@@ -31,42 +31,48 @@ void CVarSystem::CreateBoolCVar(
     const std::string &_name, const std::string &_description, CVarPermissionFlags _flags, bool _data) {
     if (m_boolCVarReg.size() >= MAX_CVAR_REGISTRY_SIZE) throw RkException(L"Bool CVar registry is full!");
 
-    auto cVar = std::make_shared<BoolCVar>(_data, _flags, _description);
+    auto cVar = std::allocate_shared<BoolCVar>(
+        libraries::SlabStlAllocator<BoolCVar>(m_cVarAllocator), _data, _flags, _description);
 
-    m_boolCVarReg.insert({_name, cVar});
+    m_boolCVarReg.emplace(_name, cVar);
 }
 
 void CVarSystem::CreateIntCVar(
     const std::string &_name, const std::string &_description, CVarPermissionFlags _flags, int _data) {
     if (m_intCVarReg.size() >= MAX_CVAR_REGISTRY_SIZE) throw RkException(L"Int CVar registry is full!");
 
-    auto cVar = std::make_shared<IntCVar>(_data, _flags, _description);
+    auto cVar = std::allocate_shared<IntCVar>(
+        libraries::SlabStlAllocator<IntCVar>(m_cVarAllocator), _data, _flags, _description);
 
-    m_intCVarReg.insert({_name, cVar});
+    m_intCVarReg.emplace(_name, cVar);
 }
 
 void CVarSystem::CreateFloatCVar(
     const std::string &_name, const std::string &_description, CVarPermissionFlags _flags, float _data) {
     if (m_floatCVarReg.size() >= MAX_CVAR_REGISTRY_SIZE) throw RkException(L"Float CVar registry is full!");
 
-    auto cVar = std::make_shared<FloatCVar>(_data, _flags, _description);
+    auto cVar = std::allocate_shared<FloatCVar>(
+        libraries::SlabStlAllocator<FloatCVar>(m_cVarAllocator), _data, _flags, _description);
 
-    m_floatCVarReg.insert({_name, cVar});
+    m_floatCVarReg.emplace(_name, cVar);
 }
 
 void CVarSystem::CreateStringCVar(
     const std::string &_name, const std::string &_description, CVarPermissionFlags _flags, const std::string &_data) {
     if (m_stringCVarReg.size() >= MAX_CVAR_REGISTRY_SIZE) throw RkException(L"String CVar registry is full!");
 
-    auto cVar = std::make_shared<StringCVar>(_data, _flags, _description);
+    auto cVar = std::allocate_shared<StringCVar>(
+        libraries::SlabStlAllocator<StringCVar>(m_cVarAllocator), _data, _flags, _description);
 
-    m_stringCVarReg.insert({_name, cVar});
+    m_stringCVarReg.emplace(_name, cVar);
 }
 
 void CVarSystem::SetBoolCVar(const std::string &_name, bool _data) {
-    if (m_boolCVarReg.find(_name) == m_boolCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_boolCVarReg.find(_name);
 
-    auto cVar = m_boolCVarReg.at(_name);
+    if (it == m_boolCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+
+    auto cVar = it->second;
 
     if (cVar->flags & CVarPermissionFlags::write) {
         cVar->oldData = cVar->data;
@@ -75,9 +81,11 @@ void CVarSystem::SetBoolCVar(const std::string &_name, bool _data) {
 }
 
 void CVarSystem::SetIntCVar(const std::string &_name, int _data) {
-    if (m_intCVarReg.find(_name) == m_intCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_intCVarReg.find(_name);
+
+    if (it == m_intCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
 
-    auto cVar = m_boolCVarReg.at(_name);
+    auto cVar = it->second;
 
     if (cVar->flags & CVarPermissionFlags::write) {
         cVar->oldData = cVar->data;
@@ -86,9 +94,11 @@ void CVarSystem::SetIntCVar(const std::string &_name, int _data) {
 }
 
 void CVarSystem::SetFloatCVar(const std::string &_name, float _data) {
-    if (m_floatCVarReg.find(_name) == m_floatCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_floatCVarReg.find(_name);
 
-    auto cVar = m_floatCVarReg.at(_name);
+    if (it == m_floatCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+
+    auto cVar = it->second;
 
     if (cVar->flags & CVarPermissionFlags::write) {
         cVar->oldData = cVar->data;
@@ -97,9 +107,11 @@ void CVarSystem::SetFloatCVar(const std::string &_name, float _data) {
 }
 
 void CVarSystem::SetStringCVar(const std::string &_name, const std::string &_data) {
-    if (m_stringCVarReg.find(_name) == m_stringCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_stringCVarReg.find(_name);
+
+    if (it == m_stringCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
 
-    auto cVar = m_stringCVarReg.at(_name);
+    auto cVar = it->second;
 
     if (cVar->flags & CVarPermissionFlags::write) {
         cVar->oldData = cVar->data;
@@ -108,9 +120,11 @@ void CVarSystem::SetStringCVar(const std::string &_name, const std::string &_dat
 }
 
 const bool CVarSystem::GetBoolCVar(const std::string &_name) const {
-    if (m_boolCVarReg.find(_name) == m_boolCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_boolCVarReg.find(_name);
 
-    auto cVar = m_boolCVarReg.at(_name);
+    if (it == m_boolCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+
+    auto cVar = it->second;
 
     if (!(cVar->flags & CVarPermissionFlags::read)) throw RkException("CVar '{}' is not readable!");
 
@@ -118,9 +132,11 @@ const bool CVarSystem::GetBoolCVar(const std::string &_name) const {
 }
 
 const int CVarSystem::GetIntCVar(const std::string &_name) const {
-    if (m_intCVarReg.find(_name) == m_intCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_intCVarReg.find(_name);
+
+    if (it == m_intCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
 
-    auto cVar = m_intCVarReg.at(_name);
+    auto cVar = it->second;
 
     if (!(cVar->flags & CVarPermissionFlags::read)) throw RkException("CVar '{}' is not readable!", _name);
 
@@ -128,9 +144,11 @@ const int CVarSystem::GetIntCVar(const std::string &_name) const {
 }
 
 const float CVarSystem::GetFloatCVar(const std::string &_name) const {
-    if (m_floatCVarReg.find(_name) == m_floatCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_floatCVarReg.find(_name);
 
-    auto cVar = m_floatCVarReg.at(_name);
+    if (it == m_floatCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+
+    auto cVar = it->second;
 
     if (!(cVar->flags & CVarPermissionFlags::read)) throw RkException("CVar '{}' is not readable!", _name);
 
@@ -138,9 +156,11 @@ const float CVarSystem::GetFloatCVar(const std::string &_name) const {
 }
 
 const std::string &CVarSystem::GetStringCVar(const std::string &_name) const {
-    if (m_stringCVarReg.find(_name) == m_stringCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
+    const auto it = m_stringCVarReg.find(_name);
+
+    if (it == m_stringCVarReg.end()) throw RkException("CVar '{}' does not exist!", _name);
 
-    auto cVar = m_stringCVarReg.at(_name);
+    auto cVar = it->second;
 
     if (!(cVar->flags & CVarPermissionFlags::read)) throw RkException("CVar '{}' is not readable!", _name);
 
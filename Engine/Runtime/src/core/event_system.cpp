@@ -2,4 +2,12 @@
 
 #include "core/event_system.hpp"
 
-namespace Rake::core {}  // namespace Rake::core
+namespace Rake::core {
+
+libraries::SlabAllocator &GetEventAllocator() noexcept {
+    static libraries::SlabAllocator allocator;
+
+    return allocator;
+}
+
+}  // namespace Rake::core
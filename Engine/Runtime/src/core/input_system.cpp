@@ -24,25 +24,43 @@ InputSystem::~InputSystem() {
     delete (m_instance);
 }
 
-void InputSystem::SetKeyboardInputMap(const std::unordered_map<Action, KeyboardKeys> &_inputMap) noexcept {
+// Literal actions are only hashed, they keep their binding in InputMappings.json but under their hash.
+template <typename Input>
+static void LogUnnamedActions(const InputMap<Input> &_inputMap) noexcept {
+    for (const auto &[action, input] : _inputMap) {
+        if (action.GetString().empty()) {
+            RK_LOG_WARN(L"Action {:#018x} was never interned, InputMappings.json saves it by hash!", action.GetHash());
+        }
+    }
+}
+
+void InputSystem::SetKeyboardInputMap(const InputMap<KeyboardKeys> &_inputMap) noexcept {
+    LogUnnamedActions(_inputMap);
+
     m_keyboard.inputMap = _inputMap;
 }
 
-void InputSystem::SetMouseInputMap(const std::unordered_map<Action, MouseButtons> &_inputMap) noexcept {
+void InputSystem::SetMouseInputMap(const InputMap<MouseButtons> &_inputMap) noexcept {
+    LogUnnamedActions(_inputMap);
+
     m_mouse.inputMap = _inputMap;
 }
 
-void InputSystem::SetControllerButtonsInputMap(
-    const std::unordered_map<Action, ControllerButtons> &_inputMap) noexcept {
+void InputSystem::SetControllerButtonsInputMap(const InputMap<ControllerButtons> &_inputMap) noexcept {
+    LogUnnamedActions(_inputMap);
+
     m_controller.buttonsInputMap = _inputMap;
 }
 
-void InputSystem::SetControllerSticksInputMap(const std::unordered_map<Action, ControllerSticks> &_inputMap) noexcept {
+void InputSystem::SetControllerSticksInputMap(const InputMap<ControllerSticks> &_inputMap) noexcept {
+    LogUnnamedActions(_inputMap);
+
     m_controller.sticksInputMap = _inputMap;
 }
 
-void InputSystem::SetControllerTriggersInputMap(
-    const std::unordered_map<Action, ControllerTriggers> &_inputMap) noexcept {
+void InputSystem::SetControllerTriggersInputMap(const InputMap<ControllerTriggers> &_inputMap) noexcept {
+    LogUnnamedActions(_inputMap);
+
     m_controller.triggersInputMap = _inputMap;
 }
 
@@ -52,36 +70,48 @@ void InputSystem::FlipMouseAxis(MouseAxis _axis) noexcept { m_mouse.flipAxis[(ui
 
 void InputSystem::FlipControllerAxis(ControllerAxis _axis) noexcept { m_controller.flipAxis[(uint8_t)_axis] *= -1; }
 
+// Unmapped actions read as released instead of inserting an entry that would be saved without a name.
+template <typename Input>
+static const Input *FindInput(const InputMap<Input> &_inputMap, Action _action) noexcept {
+    const auto it = _inputMap.Find(_action);
+
+    return it != _inputMap.end() ? &it->second : nullptr;
+}
+
 bool InputSystem::IsKeyboardKeyPressed(Action _action) noexcept {
-    return m_keyboard.inputState.keyDown[(uint8_t)m_keyboard.inputMap[_action]];
+    const KeyboardKeys *key = FindInput(m_keyboard.inputMap, _action);
+
+    return key && m_keyboard.inputState.keyDown[(uint8_t)*key];
 }
 
 bool InputSystem::IsKeyboardKeyFirstPressed(Action _action) noexcept {
-    const uint8_t &key = (uint8_t)m_keyboard.inputMap[_action];
+    const KeyboardKeys *key = FindInput(m_keyboard.inputMap, _action);
 
-    return m_keyboard.inputState.keyDown[key] && !m_keyboard.lastInputState.keyDown[key];
+    return key && m_keyboard.inputState.keyDown[(uint8_t)*key] && !m_keyboard.lastInputState.keyDown[(uint8_t)*key];
 }
 
 bool InputSystem::IsKeyboardKeyFirstReleased(Action _action) noexcept {
-    const uint8_t &key = (uint8_t)m_keyboard.inputMap[_action];
+    const KeyboardKeys *key = FindInput(m_keyboard.inputMap, _action);
 
-    return !m_keyboard.inputState.keyDown[key] && m_keyboard.lastInputState.keyDown[key];
+    return key && !m_keyboard.inputState.keyDown[(uint8_t)*key] && m_keyboard.lastInputState.keyDown[(uint8_t)*key];
 }
 
 bool InputSystem::IsMouseButtonPressed(Action _action) noexcept {
-    return m_mouse.inputState.buttons[(uint8_t)m_mouse.inputMap[_action]];
+    const MouseButtons *button = FindInput(m_mouse.inputMap, _action);
+
+    return button && m_mouse.inputState.buttons[(uint8_t)*button];
 }
 
 bool InputSystem::IsMouseButtonFirstPressed(Action _action) noexcept {
-    const uint8_t &button = (uint8_t)m_mouse.inputMap[_action];
+    const MouseButtons *button = FindInput(m_mouse.inputMap, _action);
 
-    return m_mouse.inputState.buttons[button] && !m_mouse.lastInputState.buttons[button];
+    return button && m_mouse.inputState.buttons[(uint8_t)*button] && !m_mouse.lastInputState.buttons[(uint8_t)*button];
 }
 
 bool InputSystem::IsMouseButtonFirstReleased(Action _action) noexcept {
-    const uint8_t &button = (uint8_t)m_mouse.inputMap[_action];
+    const MouseButtons *button = FindInput(m_mouse.inputMap, _action);
 
-    return !m_mouse.inputState.buttons[button] && m_mouse.lastInputState.buttons[button];
+    return button && !m_mouse.inputState.buttons[(uint8_t)*button] && m_mouse.lastInputState.buttons[(uint8_t)*button];
 }
 
 float InputSystem::GetMouseWheelDelta() noexcept { return m_mouse.inputState.wheelDelta * m_mouse.flipWheel; }
@@ -92,32 +122,46 @@ glm::vec2 InputSystem::GetMouseCursorDelta() noexcept {
 }
 
 bool InputSystem::IsControllerButtonPressed(Action _action) noexcept {
-    return m_controller.inputState.buttons[(uint8_t)m_controller.buttonsInputMap[_action]];
+    const ControllerButtons *button = FindInput(m_controller.buttonsInputMap, _action);
+
+    return button && m_controller.inputState.buttons[(uint8_t)*button];
 }
 
 bool InputSystem::IsControllerButtonFirstPressed(Action _action) noexcept {
-    const uint8_t &button = (uint8_t)m_controller.buttonsInputMap[_action];
+    const ControllerButtons *button = FindInput(m_controller.buttonsInputMap, _action);
 
-    return m_controller.inputState.buttons[button] && !m_controller.lastInputState.buttons[button];
+    return button && m_controller.inputState.buttons[(uint8_t)*button] &&
+           !m_controller.lastInputState.buttons[(uint8_t)*button];
 }
 
 bool InputSystem::IsControllerButtonFirstReleased(Action _action) noexcept {
-    const uint8_t &button = (uint8_t)m_controller.buttonsInputMap[_action];
+    const ControllerButtons *button = FindInput(m_controller.buttonsInputMap, _action);
 
-    return !m_controller.inputState.buttons[button] && m_controller.lastInputState.buttons[button];
+    return button && !m_controller.inputState.buttons[(uint8_t)*button] &&
+           m_controller.lastInputState.buttons[(uint8_t)*button];
 }
 
 float InputSystem::GetControllerTriggerValue(Action _action) noexcept {
-    return m_controller.inputState.triggers[(uint8_t)m_controller.triggersInputMap[_action]];
+    const ControllerTriggers *trigger = FindInput(m_controller.triggersInputMap, _action);
+
+    return trigger ? m_controller.inputState.triggers[(uint8_t)*trigger] : 0.0f;
 }
 
 glm::vec2 InputSystem::GetControllerSticksDelta(Action _action) noexcept {
-    const uint8_t &stick = (uint8_t)m_controller.sticksInputMap[_action];
+    const ControllerSticks *stick = FindInput(m_controller.sticksInputMap, _action);
 
-    return (m_controller.inputState.sticks[stick] - m_controller.lastInputState.sticks[stick]) *
+    if (!stick) return {};
+
+    return (m_controller.inputState.sticks[(uint8_t)*stick] - m_controller.lastInputState.sticks[(uint8_t)*stick]) *
            glm::vec2{m_controller.flipAxis[0], m_controller.flipAxis[1]};
 }
 
+static void LogSkippedInputs(const std::vector<std::string> &_actions) {
+    for (const std::string &action : _actions) {
+        RK_LOG_WARN(L"Skipped the input of action '{}' in InputMappings.json!", libraries::ByteToWideString(action));
+    }
+}
+
 void InputSystem::LoadInputMappings() noexcept {
     try {
         if (!core::FileExists(L"InputMappings.json")) core::CreateFile(L"InputMappings.json");
@@ -131,29 +175,17 @@ void InputSystem::LoadInputMappings() noexcept {
         m_controller.flipAxis[2] = data["Controller"]["FlipAxisXR"] == 1 ? 1 : -1;
         m_controller.flipAxis[3] = data["Controller"]["FlipAxisYR"] == 1 ? 1 : -1;
 
-        for (const auto &[k, v] : data["Keyboard"]["InputMap"].items()) {
-            m_keyboard.inputMap[k] = v;
-        }
-
-        for (const auto &[k, v] : data["Mouse"]["InputMap"].items()) {
-            m_mouse.inputMap[k] = v;
-        }
-
-        for (const auto &[k, v] : data["Controller"]["ButtonsInputMap"].items()) {
-            m_controller.buttonsInputMap[k] = v;
-        }
-
-        for (const auto &[k, v] : data["Controller"]["SticksInputMap"].items()) {
-            m_controller.sticksInputMap[k] = v;
-        }
-
-        for (const auto &[k, v] : data["Controller"]["TriggersInputMap"].items()) {
-            m_controller.triggersInputMap[k] = v;
-        }
-
-        for (const auto &[k, v] : data["Controller"]["AxisInputMap"].items()) {
-            m_controller.sticksInputMap[k] = v;
-        }
+        // Entries are read one by one, a bad one is logged and skipped without discarding the rest of the file.
+        LogSkippedInputs(ReadInputMap(data["Keyboard"]["InputMap"], m_keyboard.inputMap, c_keyboardKeyNames));
+        LogSkippedInputs(ReadInputMap(data["Mouse"]["InputMap"], m_mouse.inputMap, c_mouseButtonNames));
+        LogSkippedInputs(ReadInputMap(data["Controller"]["ButtonsInputMap"], m_controller.buttonsInputMap,
+                                      c_controllerButtonNames));
+        LogSkippedInputs(ReadInputMap(data["Controller"]["SticksInputMap"], m_controller.sticksInputMap,
+                                      c_controllerStickNames));
+        LogSkippedInputs(ReadInputMap(data["Controller"]["TriggersInputMap"], m_controller.triggersInputMap,
+                                      c_controllerTriggerNames));
+        LogSkippedInputs(ReadInputMap(data["Controller"]["AxisInputMap"], m_controller.sticksInputMap,
+                                      c_controllerStickNames));
     } catch (const std::exception &) {
         SaveInputMappings();
     }
@@ -165,11 +197,6 @@ void InputSystem::SaveInputMappings() noexcept {
     data["Keyboard"] = nlohmann::json::object();
     data["Mouse"] = nlohmann::json::object();
     data["Controller"] = nlohmann::json::object();
-    data["Keyboard"]["InputMap"] = nlohmann::json::object();
-    data["Mouse"]["InputMap"] = nlohmann::json::object();
-    data["Controller"]["ButtonsInputMap"] = nlohmann::json::object();
-    data["Controller"]["SticksInputMap"] = nlohmann::json::object();
-    data["Controller"]["TriggersInputMap"] = nlohmann::json::object();
 
     data["Mouse"]["FlipAxisX"] = m_mouse.flipAxis[0];
     data["Mouse"]["FlipAxisY"] = m_mouse.flipAxis[1];
@@ -178,11 +205,11 @@ void InputSystem::SaveInputMappings() noexcept {
     data["Controller"]["FlipAxisXR"] = m_controller.flipAxis[2];
     data["Controller"]["FlipAxisYR"] = m_controller.flipAxis[3];
 
-    for (const auto &[k, v] : m_keyboard.inputMap) data["Keyboard"]["InputMap"][k] = v;
-    for (const auto &[k, v] : m_mouse.inputMap) data["Mouse"]["InputMap"][k] = v;
-    for (const auto &[k, v] : m_controller.buttonsInputMap) data["Controller"]["ButtonsInputMap"][k] = v;
-    for (const auto &[k, v] : m_controller.sticksInputMap) data["Controller"]["SticksInputMap"][k] = v;
-    for (const auto &[k, v] : m_controller.triggersInputMap) data["Controller"]["TriggersInputMap"][k] = v;
+    data["Keyboard"]["InputMap"] = WriteInputMap(m_keyboard.inputMap, c_keyboardKeyNames);
+    data["Mouse"]["InputMap"] = WriteInputMap(m_mouse.inputMap, c_mouseButtonNames);
+    data["Controller"]["ButtonsInputMap"] = WriteInputMap(m_controller.buttonsInputMap, c_controllerButtonNames);
+    data["Controller"]["SticksInputMap"] = WriteInputMap(m_controller.sticksInputMap, c_controllerStickNames);
+    data["Controller"]["TriggersInputMap"] = WriteInputMap(m_controller.triggersInputMap, c_controllerTriggerNames);
 
     core::CreateFile(L"InputMappings.json");
     core::WriteJSON(L"InputMappings.json", data);
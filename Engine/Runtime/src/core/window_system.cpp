@@ -14,8 +14,8 @@ WindowSystem::WindowSystem() {
 
     m_instance = this;
 
-    m_windowRegistry.reserve(8);
-    m_nativeWindowRegistry.reserve(8);
+    m_windowRegistry.Reserve(8);
+    m_nativeWindowRegistry.Reserve(8);
 };
 
 WindowSystem::~WindowSystem() {
@@ -24,23 +24,42 @@ WindowSystem::~WindowSystem() {
 }
 
 void WindowSystem::Update() noexcept {
-    for (const auto &windowName : m_windowsToDestroy) {
-        const auto &windowHandle = m_windowRegistry[windowName]->GetNativeHandle();
-        m_windowRegistry.erase(windowName);
-        m_nativeWindowRegistry.erase(windowHandle);
+    // The queue is taken out of the lock first, destroying a window runs its message handler, which may queue more.
+    libraries::SmallVector<std::string, 4> windowsToDestroy;
+
+    {
+        std::lock_guard lock(m_destroyMutex);
+
+        windowsToDestroy = std::move(m_windowsToDestroy);
     }
 
-    m_windowsToDestroy.clear();
+    for (const auto &windowName : windowsToDestroy) {
+        const auto window = m_windowRegistry.Find(windowName);
+
+        if (!window) continue;
 
-    for (auto &[name, window] : m_windowRegistry) {
+        m_nativeWindowRegistry.Erase((*window)->GetNativeHandle());
+
+        if (m_windowRegistry.Erase(windowName)) m_windowCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Windows are updated outside the registry locks, their message handlers look the registries up again.
+    libraries::SmallVector<std::shared_ptr<Window>, 8> windows;
+
+    m_windowRegistry.ForEach(
+        [&](const auto &, const std::shared_ptr<Window> &_window) { windows.PushBack(_window); });
+
+    for (auto &window : windows) {
         window->Update();
     }
 }
 
-bool Rake::core::WindowSystem::ShouldClose() noexcept { return m_windowRegistry.size() == 0; }
+bool Rake::core::WindowSystem::ShouldClose() noexcept { return m_windowCount.load(std::memory_order_relaxed) == 0; }
 
 void WindowSystem::LoadWindowState(const std::string &_name) noexcept {
-    auto &window = m_windowRegistry[_name];
+    const auto window = m_windowRegistry.Find(_name).value_or(nullptr);
+
+    if (!window) return;
 
     try {
         auto data = ReadJSON(L"WindowStates.json");
@@ -72,7 +91,11 @@ void WindowSystem::LoadWindowState(const std::string &_name) noexcept {
 }
 
 void WindowSystem::SaveWindowState(const std::string &_name) noexcept {
-    const auto &windowState = m_windowRegistry[_name]->GetState();
+    const auto window = m_windowRegistry.Find(_name).value_or(nullptr);
+
+    if (!window) return;
+
+    const auto &windowState = window->GetState();
 
     nlohmann::json data;
 
@@ -92,52 +115,44 @@ void WindowSystem::SaveWindowState(const std::string &_name) noexcept {
     WriteJSON(L"WindowStates.json", data);
 }
 
-const std::shared_ptr<Window> &WindowSystem::CreateWindow(const std::string &_name) noexcept {
+std::shared_ptr<Window> WindowSystem::CreateWindow(const std::string &_name) noexcept {
 #ifdef PLATFORM_WINDOWS
-    auto window = std::make_shared<platform::Win32::Win32Window>();
+    std::shared_ptr<Window> window = std::make_shared<platform::Win32::Win32Window>();
 #endif
 
-    m_nativeWindowRegistry[window->GetNativeHandle()] = _name;
-    m_windowRegistry[_name] = std::move(window);
+    m_nativeWindowRegistry.InsertOrAssign(window->GetNativeHandle(), _name);
+    if (m_windowRegistry.InsertOrAssign(_name, window)) m_windowCount.fetch_add(1, std::memory_order_relaxed);
 
     LoadWindowState(_name);
 
-    return m_windowRegistry[_name];
+    return window;
 }
 
 void WindowSystem::DestroyWindow(const std::string &_name) noexcept {
     SaveWindowState(_name);
 
-    m_windowsToDestroy.push_back(_name);
+    std::lock_guard lock(m_destroyMutex);
+
+    m_windowsToDestroy.PushBack(_name);
 }
 
 WindowSystem *WindowSystem::Get() noexcept { return m_instance; }
 
 const std::shared_ptr<Window> WindowSystem::GetWindowHandleByName(const std::string &_name) noexcept {
-    auto it = m_instance->m_windowRegistry.find(_name);
-
-    if (it != m_instance->m_windowRegistry.end()) {
-        return it->second;
-    } else {
-        return nullptr;
-    }
+    return m_instance->m_windowRegistry.Find(_name).value_or(nullptr);
 }
 
 const std::string WindowSystem::GetWindowNameByNativeHandle(void *_nativeHandle) noexcept {
-    auto it = m_instance->m_nativeWindowRegistry.find(_nativeHandle);
+    std::string name;
 
-    if (it != m_instance->m_nativeWindowRegistry.end()) {
-        return it->second;
-    } else {
-        return "";
-    }
-}
+    m_instance->m_nativeWindowRegistry.Visit(_nativeHandle, [&](const std::pmr::string &_name) { name = _name; });
 
-const std::unordered_map<std::string, std::shared_ptr<Window>> &WindowSystem::GetWindowRegistry() noexcept {
-    return m_instance->m_windowRegistry;
+    return name;
 }
 
-const std::unordered_map<void *, std::string> &WindowSystem::GetNativeWindowRegistry() noexcept {
+const WindowRegistry &WindowSystem::GetWindowRegistry() noexcept { return m_instance->m_windowRegistry; }
+
+const NativeWindowRegistry &WindowSystem::GetNativeWindowRegistry() noexcept {
     return m_instance->m_nativeWindowRegistry;
 }
 
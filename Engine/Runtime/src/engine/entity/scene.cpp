@@ -34,7 +34,7 @@ Entity Scene::CreateEntityWithUUID(uint64_t _UUID, const std::string &_name, Ent
 }
 
 void Scene::DestroyEntity(Entity _entity) noexcept {
-    m_entities.erase(_entity.GetUUID());
+    m_entities.Erase(_entity.GetUUID());
     m_registry.destroy(_entity.GetEnttHandle());
 }
 
@@ -13,7 +13,7 @@ RendererSystem::RendererSystem() {
 
     m_instance = this;
 
-    m_contextRegistry.reserve(8);
+    m_contextRegistry.Reserve(8);
 }
 
 RendererSystem::~RendererSystem() {
@@ -34,7 +34,13 @@ bool RendererSystem::ParseOptionArguments(const std::string &_arg) noexcept {
 }
 
 void RendererSystem::Render() noexcept {
-    for (auto &[name, context] : m_contextRegistry) {
+    // Contexts render outside the registry locks, so that rendering never blocks lookups from other threads.
+    libraries::SmallVector<std::shared_ptr<RenderingContext>, 8> contexts;
+
+    m_contextRegistry.ForEach(
+        [&](const auto &, const std::shared_ptr<RenderingContext> &_context) { contexts.PushBack(_context); });
+
+    for (auto &context : contexts) {
         context->Render();
     }
 }
@@ -49,18 +55,9 @@ std::unique_ptr<RendererSystem> RendererSystem::CreateWithBackend() noexcept {
 }
 
 const std::shared_ptr<RenderingContext> RendererSystem::GetContextByName(const std::string &_name) noexcept {
-    auto it = m_instance->m_contextRegistry.find(_name);
-
-    if (it != m_instance->m_contextRegistry.end()) {
-        return it->second;
-    } else {
-        return nullptr;
-    }
+    return m_instance->m_contextRegistry.Find(_name).value_or(nullptr);
 }
 
-const std::unordered_map<std::string, std::shared_ptr<RenderingContext>> &
-RendererSystem::GetContextRegistry() noexcept {
-    return m_instance->m_contextRegistry;
-}
+const ContextRegistry &RendererSystem::GetContextRegistry() noexcept { return m_instance->m_contextRegistry; }
 
 }  // namespace Rake::engine::graphics
@@ -33,20 +33,21 @@ VulkanRendererSystem::VulkanRendererSystem() {
 }
 
 VulkanRendererSystem::~VulkanRendererSystem() {
-    m_contextRegistry.clear();
+    m_contextRegistry.Clear();
 
     DestroyVulkanInstance(m_instance);
 }
 
-std::shared_ptr<engine::graphics::RenderingContext>& VulkanRendererSystem::CreateContext(
+std::shared_ptr<engine::graphics::RenderingContext> VulkanRendererSystem::CreateContext(
     const std::string& _name, const std::shared_ptr<core::Window>& _window) noexcept {
-    auto context = std::make_unique<VulkanRenderingContext>(_window, m_instance);
+    std::shared_ptr<engine::graphics::RenderingContext> context =
+        std::make_shared<VulkanRenderingContext>(_window, m_instance);
 
-    m_contextRegistry[_name] = std::move(context);
+    m_contextRegistry.InsertOrAssign(_name, context);
 
-    return m_contextRegistry[_name];
+    return context;
 }
 
-void VulkanRendererSystem::DestroyContext(const std::string& _name) noexcept { m_contextRegistry.erase(_name); }
+void VulkanRendererSystem::DestroyContext(const std::string& _name) noexcept { m_contextRegistry.Erase(_name); }
 
 }  // namespace Rake::platform::Vulkan
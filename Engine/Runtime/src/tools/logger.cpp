@@ -31,7 +31,7 @@ void Logger::Shutdown() noexcept {
 
     m_initialized = false;
 
-    core::WriteFile(m_logsPath, m_msgPool.str(), core::FileOpenMode::truncate);
+    Flush();
 
     const auto footer = L"<<<<<<<<<< Ending session >>>>>>>>>>\n";
 
@@ -39,14 +39,29 @@ void Logger::Shutdown() noexcept {
 }
 
 void Logger::Flush() noexcept {
+    if (m_logsPath.empty() || m_msgPoolSize == 0) return;
+
+    core::WriteFile(m_logsPath, m_msgPool.str(), core::FileOpenMode::append);
+
+    // Assigning an empty string releases the pool, clear only resets the stream state.
+    m_msgPool.str(std::wstring());
+    m_msgPoolSize = 0;
+    std::wcout.flush();
+}
+
+void Logger::FlushIfFull() noexcept {
     if (!m_initialized) return;
 
-    if (m_msgPoolSize >= RK_KIBIBYTES(10)) {
-        core::WriteFile(m_logsPath, m_msgPool.str(), core::FileOpenMode::append);
-        m_msgPool.clear();
-        m_msgPoolSize = 0;
-        std::wcout.flush();
-    }
+    if (GetBufferedBytes() >= c_flushThreshold) Flush();
+}
+
+void Logger::RegisterMemoryBudget(libraries::MemoryBudgetManager &_manager, size_t _softLimit, size_t _hardLimit) {
+    _manager.SetBudget(
+        libraries::MemoryTag::logger,
+        _softLimit,
+        _hardLimit,
+        [](size_t, libraries::BudgetPressure) { Flush(); },
+        [] { return GetBufferedBytes(); });
 }
 
 }  // namespace Rake::tools
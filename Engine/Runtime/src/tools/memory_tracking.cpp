@@ -0,0 +1,100 @@
+#include "pch.hpp"
+
+#include <RKSTL/memory_tracker.hpp>
+
+// Opt-in replacement of the global operator new and delete of the runtime module accounting every heap allocation to
+// the current memory tag of the calling thread. Each block is prefixed by a header recording its size and tag, so the
+// deallocation is accounted to the tag of the allocation even if the current tag changed in the meantime.
+//
+// The replacement only binds inside the runtime DLL, the executable and the other modules keep the CRT operators. A
+// block allocated on one side of the boundary and freed on the other (e.g. a std::string built by an inline function
+// in the application and released by the runtime) is handed to the wrong operator and corrupts the heap, so only
+// define RK_TRACK_GLOBAL_ALLOCATIONS in builds where no heap object crosses the DLL boundary, or link statically.
+#ifdef RK_TRACK_GLOBAL_ALLOCATIONS
+
+#include <new>
+#include <cstdlib>
+
+namespace {
+
+using Rake::libraries::MemoryTag;
+using Rake::libraries::MemoryTracker;
+
+struct AllocationHeader {
+    size_t size;
+    MemoryTag tag;
+};
+
+constexpr size_t c_headerSize = alignof(std::max_align_t);
+
+static_assert(sizeof(AllocationHeader) <= c_headerSize);
+
+void *TrackAllocation(void *_block, size_t _offset, size_t _size) noexcept {
+    std::byte *ptr = static_cast<std::byte *>(_block) + _offset;
+
+    AllocationHeader *header = reinterpret_cast<AllocationHeader *>(ptr - c_headerSize);
+
+    header->size = _size;
+    header->tag = MemoryTracker::GetCurrentTag();
+
+    MemoryTracker::RecordAllocation(header->tag, _size);
+
+    return ptr;
+}
+
+void *UntrackAllocation(void *_ptr, size_t _offset) noexcept {
+    std::byte *ptr = static_cast<std::byte *>(_ptr);
+
+    const AllocationHeader *header = reinterpret_cast<const AllocationHeader *>(ptr - c_headerSize);
+
+    MemoryTracker::RecordDeallocation(header->tag, header->size);
+
+    return ptr - _offset;
+}
+
+void *AllocateAligned(size_t _size, size_t _alignment) noexcept {
+#if defined(PLATFORM_WINDOWS)
+    return _aligned_malloc(_size, _alignment);
+#else
+    return std::aligned_alloc(_alignment, (_size + _alignment - 1) / _alignment * _alignment);
+#endif
+}
+
+void FreeAligned(void *_block) noexcept {
+#if defined(PLATFORM_WINDOWS)
+    _aligned_free(_block);
+#else
+    std::free(_block);
+#endif
+}
+
+}  // namespace
+
+void *operator new(size_t _size) {
+    void *block = std::malloc(c_headerSize + _size);
+
+    if (!block) throw std::bad_alloc();
+
+    return TrackAllocation(block, c_headerSize, _size);
+}
+
+void *operator new(size_t _size, std::align_val_t _alignment) {
+    // The header sits right before the returned pointer, the offset keeps both the header and the pointer aligned.
+    const size_t offset = std::max(c_headerSize, static_cast<size_t>(_alignment));
+
+    void *block = AllocateAligned(offset + _size, static_cast<size_t>(_alignment));
+
+    if (!block) throw std::bad_alloc();
+
+    return TrackAllocation(block, offset, _size);
+}
+
+void operator delete(void *_ptr) noexcept {
+    if (_ptr) std::free(UntrackAllocation(_ptr, c_headerSize));
+}
+
+void operator delete(void *_ptr, std::align_val_t _alignment) noexcept {
+    if (_ptr) FreeAligned(UntrackAllocation(_ptr, std::max(c_headerSize, static_cast<size_t>(_alignment))));
+}
+
+#endif
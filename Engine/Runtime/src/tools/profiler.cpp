@@ -8,6 +8,7 @@ nlohmann::json Profiler::m_data;
 std::wstring Profiler::m_sessionName;
 std::wstring Profiler::m_profilesPath;
 std::stack<Profiler::Profile> Profiler::m_activeProfiles;
+size_t Profiler::m_flushedEvents;
 std::mutex Profiler::m_mutex;
 bool Profiler::m_initialized;
 
@@ -26,8 +27,11 @@ void Profiler::Initialize(const std::wstring &_sessionName, const std::wstring &
     core::CreateDirectory(_profilesDir);
     core::CreateFile(m_profilesPath);
 
-    m_data["otherData"] = nlohmann::json::object();
+    // The file is written as it goes, the event array stays open until Shutdown.
+    core::WriteFile(m_profilesPath, L"{\"otherData\":{},\"traceEvents\":[", core::FileOpenMode::truncate);
+
     m_data["traceEvents"] = nlohmann::json::array();
+    m_flushedEvents = 0;
 }
 
 void Profiler::Shutdown() noexcept {
@@ -37,7 +41,13 @@ void Profiler::Shutdown() noexcept {
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    core::WriteJSON(m_profilesPath, m_data);
+    FlushEvents();
+
+    try {
+        core::WriteFile(m_profilesPath, L"\n]}\n", core::FileOpenMode::append);
+    } catch (const std::exception &e) {
+        RK_LOG_ERROR(L"Failed to close the profile file: {}", libraries::ByteToWideString(e.what()));
+    }
 
     m_initialized = false;
 }
@@ -80,6 +90,72 @@ void Profiler::EndProfile() noexcept {
     m_data["traceEvents"].push_back(traceEvent);
 
     m_activeProfiles.pop();
+
+    if (m_data["traceEvents"].size() >= c_maxBufferedEvents) FlushEvents();
+}
+
+void Profiler::RecordCounter(const std::wstring &_name, std::span<const CounterSeries> _series) noexcept {
+    if (!m_initialized) return;
+
+    const auto now = std::chrono::high_resolution_clock::now();
+
+    nlohmann::json traceEvent;
+    traceEvent["args"] = nlohmann::json::object();
+
+    for (const auto &[name, value] : _series) traceEvent["args"][std::string(name)] = value;
+    traceEvent["name"] = libraries::WideToByteString(_name);
+    traceEvent["ph"] = "C";
+    traceEvent["pid"] = 0;
+    traceEvent["ts"] = std::chrono::time_point_cast<std::chrono::microseconds>(now).time_since_epoch().count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_data["traceEvents"].push_back(traceEvent);
+
+    if (m_data["traceEvents"].size() >= c_maxBufferedEvents) FlushEvents();
+}
+
+void Profiler::Flush() noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FlushEvents();
+}
+
+size_t Profiler::GetBufferedEventCount() noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_data["traceEvents"].size();
+}
+
+void Profiler::RegisterMemoryBudget(libraries::MemoryBudgetManager &_manager, size_t _softLimit, size_t _hardLimit) {
+    _manager.SetBudget(
+        libraries::MemoryTag::profiler,
+        _softLimit,
+        _hardLimit,
+        [](size_t, libraries::BudgetPressure) { Flush(); },
+        [] { return GetBufferedBytes(); });
+}
+
+void Profiler::FlushEvents() noexcept {
+    auto &traceEvents = m_data["traceEvents"];
+
+    if (m_profilesPath.empty() || traceEvents.empty()) return;
+
+    std::string text;
+
+    for (const auto &traceEvent : traceEvents) {
+        text += m_flushedEvents++ > 0 ? ",\n" : "\n";
+        text += traceEvent.dump();
+    }
+
+    // Events that cannot be written are dropped all the same, the buffer must not grow past its limit.
+    try {
+        core::WriteFile(m_profilesPath, libraries::ByteToWideString(text), core::FileOpenMode::append);
+    } catch (const std::exception &e) {
+        RK_LOG_ERROR(L"Failed to write the profile file: {}", libraries::ByteToWideString(e.what()));
+    }
+
+    traceEvents = nlohmann::json::array();
 }
 
 }  // namespace Rake::tools
@@ -7,6 +7,8 @@
 #ifdef COMPILER_MSVC
 #include <intrin.h>
 #define RK_DEBUG_BREAK __debugbreak()
+#elif defined(COMPILER_CLANG)
+#define RK_DEBUG_BREAK __builtin_debugtrap()
 #else
 #error "Unknown or not supported compiler toolchain!"
 #endif
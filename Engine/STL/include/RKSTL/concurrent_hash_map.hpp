@@ -0,0 +1,295 @@
+#pragma once
+
+#include <bit>
+#include <mutex>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <functional>
+#include <shared_mutex>
+#include <type_traits>
+
+#include "defines.hpp"
+#include "flat_hash_map.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A thread-safe hash map split in independently locked shards, for registries read from many threads and
+ * written rarely.
+ *
+ * Every key belongs to one shard, picked from the high bits of its hash, and every shard is a FlatHashMap guarded by
+ * its own reader-writer lock on its own cache line. Readers of a shard only share its lock word, readers of different
+ * shards share nothing, and a writer only blocks the keys of its shard. A shard grows under its exclusive lock, so
+ * growing never stops the whole map.
+ *
+ * Elements are never exposed outside the shard lock: lookups return a copy of the value (cheap for the shared_ptr or
+ * handle values of registries), and Visit and Update run a function on the value while the lock is held.
+ *
+ * The shard count is fixed at construction. Lookups accept any type the hash and the equality predicate accept when
+ * both define is_transparent, as FlatHashMap does. Every shard map allocates through a copy of the allocator given at
+ * construction, so a std::pmr::polymorphic_allocator over a thread-safe resource keeps the elements in that resource.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The mapped type.
+ * @tparam Hash The hash function of the keys.
+ * @tparam Equal The equality predicate of the keys.
+ * @tparam Allocator The allocator of the elements, shared by the shard maps.
+ *
+ * @multithreading Thread-safe. The functions passed to Visit, Update and ForEach must not access the map.
+ */
+template <typename Key, typename Value, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>,
+    typename Allocator = std::allocator<std::pair<Key, Value>>>
+class ConcurrentHashMap final : public NonCopyable {
+   public:
+    using map_type = FlatHashMap<Key, Value, Hash, Equal, Allocator>;
+
+   private:
+    static constexpr size_t c_defaultShardCount = 64;
+
+    static constexpr bool c_transparent = requires {
+        typename Hash::is_transparent;
+        typename Equal::is_transparent;
+    };
+
+    template <typename K>
+    using LookupKey = std::conditional_t<c_transparent, K, Key>;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        map_type map;
+
+        explicit Shard(const Allocator &_allocator) : map(_allocator) {}
+    };
+
+    // Shards are built in place with the allocator, they hold a mutex and can be neither copied nor moved.
+    struct ShardDeleter {
+        size_t count;
+
+        void operator()(Shard *_shards) const noexcept {
+            std::destroy_n(_shards, count);
+            std::allocator<Shard>().deallocate(_shards, count);
+        }
+    };
+
+    std::unique_ptr<Shard[], ShardDeleter> m_shards;
+    size_t m_shardMask;
+    Hash m_hash;
+
+   public:
+    /**
+     * @brief Constructs a ConcurrentHashMap.
+     *
+     * @param _shardCount The number of shards, rounded up to a power of two. More shards than threads keeps the
+     * chance of two threads meeting on one lock low.
+     * @param _allocator The allocator copied into every shard map.
+     * @throw std::invalid_argument If the shard count is zero.
+     */
+    explicit ConcurrentHashMap(size_t _shardCount = c_defaultShardCount, const Allocator &_allocator = Allocator()) {
+        if (_shardCount == 0) throw std::invalid_argument("ConcurrentHashMap shard count must be greater than zero");
+
+        const size_t shardCount = std::bit_ceil(_shardCount);
+        Shard *shards = std::allocator<Shard>().allocate(shardCount);
+
+        size_t constructed = 0;
+
+        try {
+            for (; constructed < shardCount; ++constructed) std::construct_at(shards + constructed, _allocator);
+        } catch (...) {
+            std::destroy_n(shards, constructed);
+            std::allocator<Shard>().deallocate(shards, shardCount);
+            throw;
+        }
+
+        m_shards = std::unique_ptr<Shard[], ShardDeleter>(shards, ShardDeleter{shardCount});
+        m_shardMask = shardCount - 1;
+    }
+
+   public:
+    /**
+     * @brief Inserts an element constructed from _args if the key is not present, nothing is constructed otherwise.
+     *
+     * @return bool True if the element was inserted.
+     */
+    template <typename K, typename... Args>
+    bool TryEmplace(K &&_key, Args &&..._args) {
+        Shard &shard = GetShard(_key);
+        std::unique_lock lock(shard.mutex);
+
+        return shard.map.TryEmplace(std::forward<K>(_key), std::forward<Args>(_args)...).second;
+    }
+
+    /**
+     * @brief Inserts an element or assigns the value of the element already holding the key.
+     *
+     * @return bool True if the element was inserted, false if it was assigned.
+     */
+    template <typename K, typename V>
+    bool InsertOrAssign(K &&_key, V &&_value) {
+        Shard &shard = GetShard(_key);
+        std::unique_lock lock(shard.mutex);
+
+        return shard.map.InsertOrAssign(std::forward<K>(_key), std::forward<V>(_value)).second;
+    }
+
+    /**
+     * @brief Erases the element holding a key.
+     *
+     * @return size_t The number of elements erased, 0 or 1.
+     */
+    template <typename K>
+    size_t Erase(const K &_key) {
+        const LookupKey<K> &key = _key;
+        Shard &shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+
+        return shard.map.Erase(key);
+    }
+
+    /**
+     * @brief Looks up a key under the shared lock of its shard.
+     *
+     * @return std::optional<Value> A copy of the value, or std::nullopt if the key is not present.
+     */
+    template <typename K>
+    NODISCARD std::optional<Value> Find(const K &_key) const {
+        const LookupKey<K> &key = _key;
+        const Shard &shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        auto it = shard.map.Find(key);
+
+        if (it == shard.map.end()) return std::nullopt;
+
+        return it->second;
+    }
+
+    template <typename K>
+    NODISCARD bool Contains(const K &_key) const {
+        const LookupKey<K> &key = _key;
+        const Shard &shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        return shard.map.Contains(key);
+    }
+
+    /**
+     * @brief Calls a function on the value of a key under the shared lock of its shard.
+     *
+     * @param _function A callable taking a const reference to the value.
+     * @return bool True if the key was present and the function called.
+     */
+    template <typename K, typename Function>
+    bool Visit(const K &_key, Function &&_function) const {
+        const LookupKey<K> &key = _key;
+        const Shard &shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        auto it = shard.map.Find(key);
+
+        if (it == shard.map.end()) return false;
+
+        std::invoke(std::forward<Function>(_function), std::as_const(it->second));
+
+        return true;
+    }
+
+    /**
+     * @brief Calls a function on the value of a key under the exclusive lock of its shard.
+     *
+     * @param _function A callable taking a reference to the value.
+     * @return bool True if the key was present and the function called.
+     */
+    template <typename K, typename Function>
+    bool Update(const K &_key, Function &&_function) {
+        const LookupKey<K> &key = _key;
+        Shard &shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+
+        auto it = shard.map.Find(key);
+
+        if (it == shard.map.end()) return false;
+
+        std::invoke(std::forward<Function>(_function), it->second);
+
+        return true;
+    }
+
+    /**
+     * @brief Calls a function on every element, one shard at a time under its shared lock.
+     *
+     * @note Not a snapshot, elements inserted or erased in shards not yet visited may or may not be seen.
+     *
+     * @param _function A callable taking a const reference to the key and a const reference to the value.
+     */
+    template <typename Function>
+    void ForEach(Function &&_function) const {
+        for (size_t i = 0; i <= m_shardMask; ++i) {
+            std::shared_lock lock(m_shards[i].mutex);
+
+            for (const auto &[key, value] : m_shards[i].map) std::invoke(_function, key, value);
+        }
+    }
+
+    /**
+     * @brief Erases every element, one shard at a time.
+     */
+    void Clear() {
+        for (size_t i = 0; i <= m_shardMask; ++i) {
+            std::unique_lock lock(m_shards[i].mutex);
+
+            m_shards[i].map.Clear();
+        }
+    }
+
+    /**
+     * @brief Reserves room for a number of elements spread evenly over the shards.
+     */
+    void Reserve(size_t _capacity) {
+        const size_t shardCapacity = _capacity / (m_shardMask + 1) + 1;
+
+        for (size_t i = 0; i <= m_shardMask; ++i) {
+            std::unique_lock lock(m_shards[i].mutex);
+
+            m_shards[i].map.Reserve(shardCapacity);
+        }
+    }
+
+    /**
+     * @brief Gets the number of elements, summed shard by shard, so it is only exact while no thread writes.
+     */
+    NODISCARD size_t size() const {
+        size_t count = 0;
+
+        for (size_t i = 0; i <= m_shardMask; ++i) {
+            std::shared_lock lock(m_shards[i].mutex);
+
+            count += m_shards[i].map.size();
+        }
+
+        return count;
+    }
+
+    NODISCARD inline bool empty() const { return size() == 0; }
+
+    NODISCARD inline size_t GetShardCount() const noexcept { return m_shardMask + 1; }
+
+    NODISCARD inline Allocator GetAllocator() const noexcept { return m_shards[0].map.GetAllocator(); }
+
+   private:
+    /**
+     * @brief Picks the shard of a key from the high bits of its hash, the shard table probes with the low ones.
+     */
+    template <typename K>
+    NODISCARD inline Shard &GetShard(const K &_key) const {
+        const LookupKey<K> &key = _key;
+        const uint64_t hash = static_cast<uint64_t>(m_hash(key)) * 0x9e3779b97f4a7c15ull;
+
+        return m_shards[(hash >> 40) & m_shardMask];
+    }
+};
+
+}  // namespace Rake::libraries
@@ -12,6 +12,15 @@
 #define CURRENT_FUNCTION __func__
 #define RESTRICT         __restrict
 #define INTERFACE        __interface
+#elif defined(COMPILER_CLANG)
+#define DLL_EXPORT       __attribute__((visibility("default")))
+#define DLL_IMPORT
+#define FORCE_INLINE     inline __attribute__((always_inline))
+#define PROHIBIT_INLINE  __attribute__((noinline))
+#define VECTORCALL
+#define CURRENT_FUNCTION __func__
+#define RESTRICT         __restrict
+#define INTERFACE        struct
 #else
 #error "Unknown or not supported compiler toolchain!"
 #endif
@@ -66,6 +66,10 @@
 #define PLATFORM_NAME    "Android"
 #define PLATFORM_ANDROID 1
 #define MOBILE_DEVICE    1
+#elif defined(__linux__)
+#define PLATFORM_NAME  "Linux"
+#define PLATFORM_LINUX 1
+#define DESKTOP_DEVICE 1
 #endif
 
 #if __cplusplus == 202002L
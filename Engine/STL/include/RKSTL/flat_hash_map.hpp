@@ -0,0 +1,938 @@
+#pragma once
+
+#include <bit>
+#include <new>
+#include <tuple>
+#include <memory>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <initializer_list>
+
+#include "defines.hpp"
+
+#if defined(__SSE2__) || defined(ARCHITECTURE_X86_64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RK_FLAT_HASH_SSE2
+#endif
+
+namespace Rake::libraries {
+
+/**
+ * @brief Transparent hash for string keys, so that tables keyed by std::string can be probed with a std::string_view
+ * or a string literal without building a temporary string.
+ */
+struct StringHash {
+    using is_transparent = void;
+
+    NODISCARD size_t operator()(std::string_view _string) const noexcept {
+        return std::hash<std::string_view>{}(_string);
+    }
+};
+
+/**
+ * @brief Transparent equality for string keys, compares strings of any allocator (std::pmr::string and std::string
+ * have no operator== between them).
+ */
+struct StringEqual {
+    using is_transparent = void;
+
+    NODISCARD bool operator()(std::string_view _lhs, std::string_view _rhs) const noexcept { return _lhs == _rhs; }
+};
+
+/**
+ * @brief Default hash of the flat hash tables, std::hash except for string keys that get the transparent StringHash.
+ */
+template <typename Key>
+struct FlatHash : std::hash<Key> {};
+
+template <>
+struct FlatHash<std::string> : StringHash {};
+
+template <>
+struct FlatHash<std::string_view> : StringHash {};
+
+/**
+ * @brief Open-addressing hash table storing its elements inline, in the Swiss table layout.
+ *
+ * Every slot has a control byte holding either the 7 low bits of the element hash or an empty/deleted marker. Slots
+ * are probed in groups of 16: the control bytes of a group are compared against the hash byte of the key at once
+ * (with SSE2 where available), so most lookups touch one control group and one slot, and the elements are never
+ * reached through a node pointer. Groups are aligned and probed along a triangular sequence, which visits every group
+ * of the power-of-two table. The table grows by doubling at a load factor of 7/8.
+ *
+ * Erasing leaves a tombstone only when the group of the slot is full, since a probe would otherwise have stopped at
+ * that group anyway. Tombstones are reused by insertions and purged by rehashing in place when they crowd the table.
+ *
+ * The hash returned by Hash is mixed before use, so identity hashes of integers and pointers are safe. When both Hash
+ * and Equal define is_transparent, lookups accept any type they can hash and compare, string_view for string keys.
+ *
+ * Inserting may rehash and invalidates every iterator and reference, erasing only invalidates the erased element.
+ *
+ * The control bytes and the slots are one allocation made through Allocator, rebound to blocks of the slot alignment,
+ * and the elements are constructed through it, so a std::pmr::polymorphic_allocator also hands its resource to
+ * allocator-aware keys and values. Allocators propagate on copy, move and swap as their traits ask, like the
+ * standard containers.
+ *
+ * @tparam Key The key type.
+ * @tparam Value The mapped type, or void for a set.
+ * @tparam Hash The hash function of the keys.
+ * @tparam Equal The equality predicate of the keys.
+ * @tparam Allocator The allocator of the elements.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+class FlatHashTable {
+   public:
+    using key_type = Key;
+    using value_type = std::conditional_t<std::is_void_v<Value>, Key, std::pair<Key, Value>>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+    using allocator_type = Allocator;
+
+   protected:
+    static constexpr size_t c_groupWidth = 16;
+    static constexpr size_t c_minCapacity = c_groupWidth;
+    static constexpr size_t c_slotAlignment = std::max(alignof(value_type), c_groupWidth);
+    static constexpr size_t c_notFound = std::numeric_limits<size_t>::max();
+
+    static constexpr int8_t c_empty = -128;
+    static constexpr int8_t c_deleted = -2;
+
+    static constexpr bool c_transparent = requires {
+        typename Hash::is_transparent;
+        typename Equal::is_transparent;
+    };
+
+    // Non-transparent tables convert the lookup key to a Key first, as std::unordered_map does.
+    template <typename K>
+    using LookupKey = std::conditional_t<c_transparent, K, Key>;
+
+    struct alignas(c_slotAlignment) StorageBlock {
+        std::byte bytes[c_slotAlignment];
+    };
+
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+    using StorageAllocator = typename AllocatorTraits::template rebind_alloc<StorageBlock>;
+    using StorageTraits = std::allocator_traits<StorageAllocator>;
+
+    static constexpr bool c_propagateOnCopy = AllocatorTraits::propagate_on_container_copy_assignment::value;
+    static constexpr bool c_propagateOnMove = AllocatorTraits::propagate_on_container_move_assignment::value;
+    static constexpr bool c_propagateOnSwap = AllocatorTraits::propagate_on_container_swap::value;
+    static constexpr bool c_alwaysEqual = AllocatorTraits::is_always_equal::value;
+
+    class Group {
+       private:
+#ifdef RK_FLAT_HASH_SSE2
+        __m128i m_control;
+#else
+        int8_t m_control[c_groupWidth];
+#endif
+
+       public:
+        explicit Group(const int8_t *_control) noexcept {
+#ifdef RK_FLAT_HASH_SSE2
+            m_control = _mm_load_si128(reinterpret_cast<const __m128i *>(_control));
+#else
+            std::memcpy(m_control, _control, c_groupWidth);
+#endif
+        }
+
+        /**
+         * @brief Gets the bitmask of the slots whose control byte equals _byte.
+         */
+        NODISCARD inline uint32_t Match(int8_t _byte) const noexcept {
+#ifdef RK_FLAT_HASH_SSE2
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(_byte), m_control)));
+#else
+            uint32_t mask = 0;
+
+            for (size_t i = 0; i < c_groupWidth; ++i) mask |= uint32_t(m_control[i] == _byte) << i;
+
+            return mask;
+#endif
+        }
+
+        NODISCARD inline uint32_t MatchEmpty() const noexcept { return Match(c_empty); }
+
+        /**
+         * @brief Gets the bitmask of the free slots, the markers are the only negative control bytes.
+         */
+        NODISCARD inline uint32_t MatchFree() const noexcept {
+#ifdef RK_FLAT_HASH_SSE2
+            return static_cast<uint32_t>(_mm_movemask_epi8(m_control));
+#else
+            uint32_t mask = 0;
+
+            for (size_t i = 0; i < c_groupWidth; ++i) mask |= uint32_t(m_control[i] < 0) << i;
+
+            return mask;
+#endif
+        }
+    };
+
+    int8_t *m_control = nullptr;
+    value_type *m_slots = nullptr;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+    size_t m_growthLeft = 0;
+
+    Hash m_hash;
+    Equal m_equal;
+    Allocator m_allocator;
+
+   public:
+    /**
+     * @brief Forward iterator over the elements of a FlatHashTable, in slot order.
+     */
+    template <bool Const>
+    class BasicIterator final {
+        friend class FlatHashTable;
+
+        template <bool>
+        friend class BasicIterator;
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename FlatHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const || std::is_void_v<Value>, const value_type *, value_type *>;
+        using reference = std::conditional_t<Const || std::is_void_v<Value>, const value_type &, value_type &>;
+
+       private:
+        const int8_t *m_control = nullptr;
+        const int8_t *m_controlEnd = nullptr;
+        value_type *m_slot = nullptr;
+
+       public:
+        BasicIterator() = default;
+
+        BasicIterator(const int8_t *_control, const int8_t *_controlEnd, value_type *_slot) noexcept
+            : m_control(_control), m_controlEnd(_controlEnd), m_slot(_slot) {}
+
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst> &_other) noexcept
+            : m_control(_other.m_control), m_controlEnd(_other.m_controlEnd), m_slot(_other.m_slot) {}
+
+        BasicIterator &operator++() noexcept {
+            ++m_control;
+            ++m_slot;
+            SkipFree();
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        reference operator*() const noexcept { return *m_slot; }
+
+        pointer operator->() const noexcept { return m_slot; }
+
+        template <bool OtherConst>
+        bool operator==(const BasicIterator<OtherConst> &_other) const noexcept {
+            return m_slot == _other.m_slot;
+        }
+
+       private:
+        void SkipFree() noexcept {
+            while (m_control != m_controlEnd && *m_control < 0) {
+                ++m_control;
+                ++m_slot;
+            }
+        }
+    };
+
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+   public:
+    FlatHashTable() = default;
+
+    explicit FlatHashTable(const Allocator &_allocator) noexcept : m_allocator(_allocator) {}
+
+    /**
+     * @brief Constructs a FlatHashTable able to hold _capacity elements without rehashing.
+     */
+    explicit FlatHashTable(size_t _capacity, const Allocator &_allocator = Allocator()) : FlatHashTable(_allocator) {
+        Reserve(_capacity);
+    }
+
+    // Delegating to the allocator constructor makes the table complete before the first element is copied, so the
+    // destructor releases the elements already copied and the storage if a copy throws.
+    FlatHashTable(std::initializer_list<value_type> _values, const Allocator &_allocator = Allocator())
+        : FlatHashTable(_allocator) {
+        Reserve(_values.size());
+
+        for (const value_type &value : _values) Insert(value);
+    }
+
+    FlatHashTable(const FlatHashTable &_other)
+        : FlatHashTable(_other, AllocatorTraits::select_on_container_copy_construction(_other.m_allocator)) {}
+
+    FlatHashTable(const FlatHashTable &_other, const Allocator &_allocator) : FlatHashTable(_allocator) {
+        m_hash = _other.m_hash;
+        m_equal = _other.m_equal;
+
+        Reserve(_other.m_size);
+
+        for (const value_type &value : _other) InsertUnique(HashKey(GetKey(value)), value);
+    }
+
+    FlatHashTable(FlatHashTable &&_other) noexcept
+        : m_control(std::exchange(_other.m_control, nullptr)),
+          m_slots(std::exchange(_other.m_slots, nullptr)),
+          m_capacity(std::exchange(_other.m_capacity, 0)),
+          m_size(std::exchange(_other.m_size, 0)),
+          m_growthLeft(std::exchange(_other.m_growthLeft, 0)),
+          m_hash(std::move(_other.m_hash)),
+          m_equal(std::move(_other.m_equal)),
+          m_allocator(std::move(_other.m_allocator)) {}
+
+    FlatHashTable &operator=(const FlatHashTable &_other) {
+        if (this != &_other) {
+            // Built before anything is released, a throwing copy leaves this table untouched.
+            FlatHashTable copy(_other, c_propagateOnCopy ? _other.m_allocator : m_allocator);
+
+            Release();
+
+            if constexpr (c_propagateOnCopy) m_allocator = _other.m_allocator;
+
+            TakeStorage(copy);
+        }
+
+        return *this;
+    }
+
+    FlatHashTable &operator=(FlatHashTable &&_other) noexcept(c_propagateOnMove || c_alwaysEqual) {
+        if (this == &_other) return *this;
+
+        if constexpr (!c_propagateOnMove && !c_alwaysEqual) {
+            // The storage of _other cannot be freed through this allocator, its elements are moved one by one.
+            if (m_allocator != _other.m_allocator) {
+                FlatHashTable moved(m_allocator);
+
+                moved.m_hash = _other.m_hash;
+                moved.m_equal = _other.m_equal;
+                moved.Reserve(_other.m_size);
+
+                for (value_type &value : _other) moved.InsertUnique(HashKey(GetKey(value)), std::move(value));
+
+                _other.Release();
+                Release();
+                TakeStorage(moved);
+
+                return *this;
+            }
+        }
+
+        Release();
+
+        if constexpr (c_propagateOnMove) m_allocator = std::move(_other.m_allocator);
+
+        TakeStorage(_other);
+
+        return *this;
+    }
+
+    ~FlatHashTable() { Release(); }
+
+   public:
+    /**
+     * @brief Finds the element with the given key.
+     *
+     * @return iterator The element, or end() if the key is not present.
+     */
+    template <typename K>
+    NODISCARD iterator Find(const K &_key) {
+        const size_t index = FindIndex(_key);
+        return index == c_notFound ? end() : MakeIterator(index);
+    }
+
+    template <typename K>
+    NODISCARD const_iterator Find(const K &_key) const {
+        const size_t index = FindIndex(_key);
+        return index == c_notFound ? end() : MakeIterator(index);
+    }
+
+    template <typename K>
+    NODISCARD bool Contains(const K &_key) const {
+        return FindIndex(_key) != c_notFound;
+    }
+
+    /**
+     * @brief Inserts an element if its key is not present.
+     *
+     * @return std::pair<iterator, bool> The element with the key and whether it was inserted.
+     */
+    std::pair<iterator, bool> Insert(const value_type &_value) { return Emplace(_value); }
+
+    std::pair<iterator, bool> Insert(value_type &&_value) { return Emplace(std::move(_value)); }
+
+    /**
+     * @brief Constructs an element and inserts it if its key is not present, the element is discarded otherwise.
+     *
+     * @return std::pair<iterator, bool> The element with the key and whether it was inserted.
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> Emplace(Args &&..._args);
+
+    /**
+     * @brief Erases the element at the given position.
+     *
+     * @return iterator The element following the erased one.
+     */
+    iterator Erase(const_iterator _position) noexcept;
+
+    /**
+     * @brief Erases the element with the given key.
+     *
+     * @return size_t The number of erased elements, 0 or 1.
+     */
+    template <typename K>
+        requires(!std::is_convertible_v<const K &, const_iterator>)
+    size_t Erase(const K &_key) {
+        const size_t index = FindIndex(_key);
+
+        if (index == c_notFound) return 0;
+
+        EraseIndex(index);
+
+        return 1;
+    }
+
+    /**
+     * @brief Destroys every element, keeping the allocated capacity.
+     */
+    void Clear() noexcept;
+
+    /**
+     * @brief Makes room for _count elements without rehashing.
+     */
+    void Reserve(size_t _count);
+
+    /**
+     * @brief Swaps the contents of two tables, their allocators must be equal unless they propagate on swap.
+     */
+    void Swap(FlatHashTable &_other) noexcept {
+        if constexpr (c_propagateOnSwap) std::swap(m_allocator, _other.m_allocator);
+
+        std::swap(m_control, _other.m_control);
+        std::swap(m_slots, _other.m_slots);
+        std::swap(m_capacity, _other.m_capacity);
+        std::swap(m_size, _other.m_size);
+        std::swap(m_growthLeft, _other.m_growthLeft);
+        std::swap(m_hash, _other.m_hash);
+        std::swap(m_equal, _other.m_equal);
+    }
+
+    NODISCARD inline iterator begin() noexcept { return MakeIterator(0, true); }
+
+    NODISCARD inline const_iterator begin() const noexcept { return MakeIterator(0, true); }
+
+    NODISCARD inline iterator end() noexcept { return MakeIterator(m_capacity); }
+
+    NODISCARD inline const_iterator end() const noexcept { return MakeIterator(m_capacity); }
+
+    NODISCARD inline size_t size() const noexcept { return m_size; }
+
+    NODISCARD inline bool empty() const noexcept { return m_size == 0; }
+
+    NODISCARD inline size_t capacity() const noexcept { return m_capacity; }
+
+    NODISCARD inline float GetLoadFactor() const noexcept {
+        return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f;
+    }
+
+    NODISCARD inline Allocator GetAllocator() const noexcept { return m_allocator; }
+
+    /**
+     * @brief Gets the bytes the single allocation of a table of a capacity takes, by default the first one made.
+     *
+     * @note A pool whose blocks are this large serves a table as long as it does not grow.
+     */
+    NODISCARD static constexpr size_t GetAllocationSize(size_t _capacity = c_minCapacity) noexcept {
+        return GetStorageBlockCount(_capacity) * c_slotAlignment;
+    }
+
+   protected:
+    NODISCARD static inline const Key &GetKey(const value_type &_value) noexcept {
+        if constexpr (std::is_void_v<Value>) {
+            return _value;
+        } else {
+            return _value.first;
+        }
+    }
+
+    NODISCARD static constexpr size_t GetMaxLoad(size_t _capacity) noexcept { return _capacity - _capacity / 8; }
+
+    /**
+     * @brief Gets the bytes taken by the control bytes of a table, rounded up so that the slots stay aligned.
+     */
+    NODISCARD static constexpr size_t GetControlBytes(size_t _capacity) noexcept {
+        return (_capacity + c_slotAlignment - 1) / c_slotAlignment * c_slotAlignment;
+    }
+
+    /**
+     * @brief Gets the number of storage blocks holding the control bytes and the slots of a table.
+     */
+    NODISCARD static constexpr size_t GetStorageBlockCount(size_t _capacity) noexcept {
+        return (GetControlBytes(_capacity) + _capacity * sizeof(value_type) + c_slotAlignment - 1) / c_slotAlignment;
+    }
+
+    void DeallocateStorage(int8_t *_control, size_t _capacity) noexcept {
+        StorageAllocator allocator(m_allocator);
+
+        StorageTraits::deallocate(
+            allocator, reinterpret_cast<StorageBlock *>(_control), GetStorageBlockCount(_capacity));
+    }
+
+    /**
+     * @brief Takes the storage, hash and equality of an empty or released table, leaving the other one empty.
+     */
+    void TakeStorage(FlatHashTable &_other) noexcept {
+        m_control = std::exchange(_other.m_control, nullptr);
+        m_slots = std::exchange(_other.m_slots, nullptr);
+        m_capacity = std::exchange(_other.m_capacity, 0);
+        m_size = std::exchange(_other.m_size, 0);
+        m_growthLeft = std::exchange(_other.m_growthLeft, 0);
+        m_hash = std::move(_other.m_hash);
+        m_equal = std::move(_other.m_equal);
+    }
+
+    /**
+     * @brief Spreads the user hash over all the bits, the low 7 become the control byte and the rest pick the group.
+     */
+    template <typename K>
+    NODISCARD inline uint64_t HashKey(const K &_key) const noexcept {
+        uint64_t hash = static_cast<uint64_t>(m_hash(_key));
+
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+
+        return hash;
+    }
+
+    NODISCARD static inline int8_t GetControlByte(uint64_t _hash) noexcept { return static_cast<int8_t>(_hash & 0x7f); }
+
+    NODISCARD inline size_t GetFirstGroup(uint64_t _hash) const noexcept {
+        return static_cast<size_t>(_hash >> 7) & (m_capacity / c_groupWidth - 1);
+    }
+
+    NODISCARD inline size_t GetNextGroup(size_t _group, size_t _step) const noexcept {
+        return (_group + _step) & (m_capacity / c_groupWidth - 1);
+    }
+
+    iterator MakeIterator(size_t _index, bool _skipFree = false) noexcept {
+        iterator it(m_control + _index, m_control + m_capacity, m_slots + _index);
+
+        if (_skipFree) it.SkipFree();
+
+        return it;
+    }
+
+    const_iterator MakeIterator(size_t _index, bool _skipFree = false) const noexcept {
+        const_iterator it(m_control + _index, m_control + m_capacity, m_slots + _index);
+
+        if (_skipFree) it.SkipFree();
+
+        return it;
+    }
+
+    template <typename K>
+    NODISCARD size_t FindIndex(const K &_lookupKey) const;
+
+    /**
+     * @brief Finds the key or reserves a free slot for it, the slot is left unconstructed.
+     *
+     * @return std::pair<size_t, bool> The index of the slot and whether it was reserved.
+     */
+    template <typename K>
+    std::pair<size_t, bool> FindOrPrepareInsert(const K &_key);
+
+    NODISCARD size_t FindFreeSlot(uint64_t _hash) const noexcept;
+
+    size_t PrepareInsert(uint64_t _hash);
+
+    /**
+     * @brief Undoes PrepareInsert when constructing the element threw.
+     */
+    void AbandonSlot(size_t _index) noexcept;
+
+    template <typename... Args>
+    size_t InsertUnique(uint64_t _hash, Args &&..._args);
+
+    void EraseIndex(size_t _index) noexcept;
+
+    /**
+     * @brief Moves every element to a new table of the given capacity, purging the tombstones.
+     *
+     * @note Elements whose move constructor may throw are copied, the old table is only released once every copy
+     * succeeded.
+     *
+     * @throw std::bad_alloc If the new table cannot be allocated, the table is left unchanged.
+     * @throw Any exception thrown by copying an element, the table is left unchanged.
+     */
+    void Rehash(size_t _capacity);
+
+    void Release() noexcept;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+template <typename K>
+size_t FlatHashTable<Key, Value, Hash, Equal, Allocator>::FindIndex(const K &_lookupKey) const {
+    if (m_size == 0) return c_notFound;
+
+    const LookupKey<K> &key = _lookupKey;
+    const uint64_t hash = HashKey(key);
+    const int8_t controlByte = GetControlByte(hash);
+
+    size_t group = GetFirstGroup(hash);
+
+    for (size_t step = 1;; ++step) {
+        const Group controls(m_control + group * c_groupWidth);
+
+        for (uint32_t match = controls.Match(controlByte); match; match &= match - 1) {
+            const size_t index = group * c_groupWidth + std::countr_zero(match);
+
+            if (m_equal(GetKey(m_slots[index]), key)) return index;
+        }
+
+        // A group with an empty slot ends the probe, the key would have been inserted there.
+        if (controls.MatchEmpty()) return c_notFound;
+
+        group = GetNextGroup(group, step);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+size_t FlatHashTable<Key, Value, Hash, Equal, Allocator>::FindFreeSlot(uint64_t _hash) const noexcept {
+    size_t group = GetFirstGroup(_hash);
+
+    for (size_t step = 1;; ++step) {
+        if (const uint32_t freeSlots = Group(m_control + group * c_groupWidth).MatchFree()) {
+            return group * c_groupWidth + std::countr_zero(freeSlots);
+        }
+
+        group = GetNextGroup(group, step);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+size_t FlatHashTable<Key, Value, Hash, Equal, Allocator>::PrepareInsert(uint64_t _hash) {
+    size_t index = m_capacity ? FindFreeSlot(_hash) : 0;
+
+    // Reusing a tombstone does not consume growth, only filling an empty slot does.
+    if (m_capacity == 0 || (m_growthLeft == 0 && m_control[index] == c_empty)) {
+        // Mostly tombstones: purge them in place rather than doubling.
+        if (m_capacity && m_size * 2 < GetMaxLoad(m_capacity)) {
+            Rehash(m_capacity);
+        } else {
+            Rehash(std::max(m_capacity * 2, c_minCapacity));
+        }
+
+        index = FindFreeSlot(_hash);
+    }
+
+    if (m_control[index] == c_empty) m_growthLeft--;
+
+    m_control[index] = GetControlByte(_hash);
+    m_size++;
+
+    return index;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::AbandonSlot(size_t _index) noexcept {
+    m_control[_index] = c_deleted;
+    m_size--;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+template <typename K>
+std::pair<size_t, bool> FlatHashTable<Key, Value, Hash, Equal, Allocator>::FindOrPrepareInsert(const K &_key) {
+    const size_t index = FindIndex(_key);
+
+    if (index != c_notFound) return {index, false};
+
+    const LookupKey<K> &key = _key;
+
+    return {PrepareInsert(HashKey(key)), true};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+template <typename... Args>
+size_t FlatHashTable<Key, Value, Hash, Equal, Allocator>::InsertUnique(uint64_t _hash, Args &&..._args) {
+    const size_t index = PrepareInsert(_hash);
+
+    try {
+        AllocatorTraits::construct(m_allocator, m_slots + index, std::forward<Args>(_args)...);
+    } catch (...) {
+        AbandonSlot(index);
+        throw;
+    }
+
+    return index;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatHashTable<Key, Value, Hash, Equal, Allocator>::iterator, bool>
+FlatHashTable<Key, Value, Hash, Equal, Allocator>::Emplace(Args &&..._args) {
+    // The key is only known once the element is built, it is moved into its slot if the key is new.
+    value_type value(std::forward<Args>(_args)...);
+
+    const size_t index = FindIndex(GetKey(value));
+
+    if (index != c_notFound) return {MakeIterator(index), false};
+
+    return {MakeIterator(InsertUnique(HashKey(GetKey(value)), std::move(value))), true};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::EraseIndex(size_t _index) noexcept {
+    AllocatorTraits::destroy(m_allocator, m_slots + _index);
+
+    const size_t group = _index / c_groupWidth;
+
+    // Probes only go past a group that has no empty slot, so only a full group needs a tombstone.
+    if (Group(m_control + group * c_groupWidth).MatchEmpty()) {
+        m_control[_index] = c_empty;
+        m_growthLeft++;
+    } else {
+        m_control[_index] = c_deleted;
+    }
+
+    m_size--;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+typename FlatHashTable<Key, Value, Hash, Equal, Allocator>::iterator
+FlatHashTable<Key, Value, Hash, Equal, Allocator>::Erase(const_iterator _position) noexcept {
+    const size_t index = static_cast<size_t>(_position.m_slot - m_slots);
+
+    EraseIndex(index);
+
+    return MakeIterator(index + 1, true);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::Clear() noexcept {
+    if (m_capacity == 0) return;
+
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_control[i] >= 0) AllocatorTraits::destroy(m_allocator, m_slots + i);
+        }
+    }
+
+    std::memset(m_control, c_empty, m_capacity);
+
+    m_size = 0;
+    m_growthLeft = GetMaxLoad(m_capacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::Reserve(size_t _count) {
+    if (_count <= m_size + m_growthLeft) return;
+
+    size_t capacity = c_minCapacity;
+
+    while (GetMaxLoad(capacity) < _count) capacity *= 2;
+
+    Rehash(capacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::Rehash(size_t _capacity) {
+    // Control bytes and slots share one allocation, the control bytes first so that groups stay aligned.
+    StorageAllocator allocator(m_allocator);
+    std::byte *memory = reinterpret_cast<std::byte *>(
+        std::to_address(StorageTraits::allocate(allocator, GetStorageBlockCount(_capacity))));
+
+    int8_t *oldControl = m_control;
+    value_type *oldSlots = m_slots;
+    const size_t oldCapacity = m_capacity;
+    const size_t oldGrowthLeft = m_growthLeft;
+
+    m_control = reinterpret_cast<int8_t *>(memory);
+    m_slots = reinterpret_cast<value_type *>(memory + GetControlBytes(_capacity));
+    m_capacity = _capacity;
+    m_growthLeft = GetMaxLoad(_capacity) - m_size;
+
+    std::memset(m_control, c_empty, _capacity);
+
+    try {
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControl[i] < 0) continue;
+
+            const uint64_t hash = HashKey(GetKey(oldSlots[i]));
+            const size_t index = FindFreeSlot(hash);
+
+            AllocatorTraits::construct(m_allocator, m_slots + index, std::move_if_noexcept(oldSlots[i]));
+            m_control[index] = GetControlByte(hash);
+        }
+    } catch (...) {
+        // Only a copy can throw, so the old elements are still intact: drop the partial table and put the old one back.
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_t i = 0; i < _capacity; ++i) {
+                if (m_control[i] >= 0) AllocatorTraits::destroy(m_allocator, m_slots + i);
+            }
+        }
+
+        DeallocateStorage(m_control, _capacity);
+
+        m_control = oldControl;
+        m_slots = oldSlots;
+        m_capacity = oldCapacity;
+        m_growthLeft = oldGrowthLeft;
+
+        throw;
+    }
+
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldControl[i] >= 0) AllocatorTraits::destroy(m_allocator, oldSlots + i);
+        }
+    }
+
+    if (oldControl) DeallocateStorage(oldControl, oldCapacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename Allocator>
+void FlatHashTable<Key, Value, Hash, Equal, Allocator>::Release() noexcept {
+    if (!m_control) return;
+
+    Clear();
+
+    DeallocateStorage(m_control, m_capacity);
+
+    m_control = nullptr;
+    m_slots = nullptr;
+    m_capacity = 0;
+    m_growthLeft = 0;
+}
+
+/**
+ * @brief A flat hash map built on FlatHashTable, see FlatHashTable for the layout and the lookup rules.
+ *
+ * The elements are std::pair<Key, Value> stored in the table slots: the key must not be modified through an iterator.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename Key, typename Value, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>,
+    typename Allocator = std::allocator<std::pair<Key, Value>>>
+class FlatHashMap final : public FlatHashTable<Key, Value, Hash, Equal, Allocator> {
+    using Base = FlatHashTable<Key, Value, Hash, Equal, Allocator>;
+
+   public:
+    using mapped_type = Value;
+    using typename Base::iterator;
+    using typename Base::value_type;
+
+   public:
+    using Base::Base;
+
+   public:
+    /**
+     * @brief Inserts an element constructed from _args if the key is not present, nothing is constructed otherwise.
+     *
+     * @return std::pair<iterator, bool> The element with the key and whether it was inserted.
+     */
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> TryEmplace(K &&_key, Args &&..._args) {
+        const auto [index, inserted] = this->FindOrPrepareInsert(_key);
+
+        if (inserted) {
+            try {
+                Base::AllocatorTraits::construct(
+                    this->m_allocator,
+                    this->m_slots + index,
+                    std::piecewise_construct,
+                    std::forward_as_tuple(Key(std::forward<K>(_key))),
+                    std::forward_as_tuple(std::forward<Args>(_args)...));
+            } catch (...) {
+                this->AbandonSlot(index);
+                throw;
+            }
+        }
+
+        return {this->MakeIterator(index), inserted};
+    }
+
+    /**
+     * @brief Inserts an element or assigns the value of the element already holding the key.
+     *
+     * @return std::pair<iterator, bool> The element with the key and whether it was inserted.
+     */
+    template <typename K, typename V>
+    std::pair<iterator, bool> InsertOrAssign(K &&_key, V &&_value) {
+        auto result = TryEmplace(std::forward<K>(_key), std::forward<V>(_value));
+
+        if (!result.second) result.first->second = std::forward<V>(_value);
+
+        return result;
+    }
+
+    /**
+     * @brief Gets the value of a key, inserting a value-initialized one if the key is not present.
+     */
+    template <typename K>
+    Value &operator[](K &&_key) {
+        return TryEmplace(std::forward<K>(_key)).first->second;
+    }
+
+    /**
+     * @brief Gets the value of a key.
+     *
+     * @throw std::out_of_range If the key is not present.
+     */
+    template <typename K>
+    NODISCARD Value &At(const K &_key) {
+        auto it = this->Find(_key);
+
+        if (it == this->end()) throw std::out_of_range("FlatHashMap key not found");
+
+        return it->second;
+    }
+
+    template <typename K>
+    NODISCARD const Value &At(const K &_key) const {
+        auto it = this->Find(_key);
+
+        if (it == this->end()) throw std::out_of_range("FlatHashMap key not found");
+
+        return it->second;
+    }
+};
+
+/**
+ * @brief A flat hash set built on FlatHashTable, see FlatHashTable for the layout and the lookup rules.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename Key, typename Hash = FlatHash<Key>, typename Equal = std::equal_to<>,
+    typename Allocator = std::allocator<Key>>
+class FlatHashSet final : public FlatHashTable<Key, void, Hash, Equal, Allocator> {
+    using Base = FlatHashTable<Key, void, Hash, Equal, Allocator>;
+
+   public:
+    using Base::Base;
+};
+
+}  // namespace Rake::libraries
@@ -6,6 +6,7 @@
 #include "defines.hpp"
 
 #include "pool.hpp"
+#include "small_vector.hpp"
 
 namespace Rake::libraries {
 
@@ -22,6 +23,9 @@ namespace Rake::libraries {
 template <typename T, typename U>
 class BidirectionalGraph {
    private:
+    // Most nodes have only a few edges, their links then live inside the node without a heap allocation.
+    static constexpr size_t c_inlineLinks = 8;
+
     struct Node;
 
     struct Link {
@@ -34,9 +38,9 @@ class BidirectionalGraph {
 
     struct Node {
         T data;
-        std::vector<Link> links;
+        SmallVector<Link, c_inlineLinks> links;
 
-        Node() : data(T{}), links({}) {}
+        Node() : data(T{}) {}
         Node(const T& _value) : data(_value) {}
 
         NODISCARD inline size_t degree() const noexcept { return links.size(); }
@@ -54,7 +58,7 @@ class BidirectionalGraph {
      *
      * @param _capacity The initial capacity of the graph.
      */
-    BidirectionalGraph(size_t _capacity) : m_size(0), m_pool(_capacity) {}
+    BidirectionalGraph(size_t _capacity) : m_size(0), m_pool(_capacity, PoolLayout::segmented) {}
 
     /**
      * @brief Destroys the BidirectionalGraph and releases allocated memory.
@@ -131,9 +135,9 @@ typename BidirectionalGraph<T, U>::Node* BidirectionalGraph<T, U>::InsertNode(co
 template <typename T, typename U>
 void BidirectionalGraph<T, U>::LinkNodes(Node* _node1, Node* _node2, const U& _linkData) {
     auto toNode2Link = Link(_linkData, _node2);
-    _node1->links.push_back(toNode2Link);
+    _node1->links.PushBack(toNode2Link);
     auto toNode1Link = Link(_linkData, _node1);
-    _node2->links.push_back(toNode1Link);
+    _node2->links.PushBack(toNode1Link);
 }
 
 template <typename T, typename U>
@@ -146,11 +150,11 @@ void BidirectionalGraph<T, U>::EraseNode(Node* _node) {
         });
 
         if (it != link.ptr->links.end()) {
-            link.ptr->links.erase(it);
+            link.ptr->links.Erase(it);
         }
     }
 
-    _node->links.clear();
+    _node->links.Clear();
 
     m_pool.Deallocate(_node);
     m_size--;
@@ -159,7 +163,7 @@ void BidirectionalGraph<T, U>::EraseNode(Node* _node) {
 template <typename T, typename U>
 void BidirectionalGraph<T, U>::EraseLink(Node* _node, size_t _index) {
     if (_index < _node->links.size()) {
-        _node->links.erase(_node->links.begin() + _index);
+        _node->links.Erase(_node->links.begin() + _index);
     }
 }
 
@@ -176,6 +180,9 @@ void BidirectionalGraph<T, U>::EraseLink(Node* _node, size_t _index) {
 template <typename T, typename U>
 class UnidirectionalGraph {
    private:
+    // Most nodes have only a few edges, their links then live inside the node without a heap allocation.
+    static constexpr size_t c_inlineLinks = 8;
+
     struct Node;
 
     struct Link {
@@ -188,10 +195,10 @@ class UnidirectionalGraph {
 
     struct Node {
         T data;
-        std::vector<Link> links;
-        std::vector<Link> ghostLinks;
+        SmallVector<Link, c_inlineLinks> links;
+        SmallVector<Link, c_inlineLinks> ghostLinks;
 
-        Node() : data(T{}), links({}), ghostLinks({}) {}
+        Node() : data(T{}) {}
         Node(const T& _value) : data(_value) {}
 
         NODISCARD inline size_t degree() const noexcept { return links.size(); }
@@ -210,7 +217,7 @@ class UnidirectionalGraph {
      *
      * @param _capacity The initial capacity of the graph.
      */
-    UnidirectionalGraph(size_t _capacity) : m_size(0), m_pool(_capacity) {}
+    UnidirectionalGraph(size_t _capacity) : m_size(0), m_pool(_capacity, PoolLayout::segmented) {}
 
     /**
      * @brief Destroys the UnidirectionalGraph and releases allocated memory.
@@ -287,9 +294,9 @@ typename UnidirectionalGraph<T, U>::Node* UnidirectionalGraph<T, U>::InsertNode(
 template <typename T, typename U>
 void UnidirectionalGraph<T, U>::LinkNodes(Node* _node1, Node* _node2, const U& _linkData) {
     auto toNode2Link = Link(_linkData, _node2);
-    _node1->links.push_back(toNode2Link);
+    _node1->links.PushBack(toNode2Link);
     auto toNode1Link = Link(_linkData, _node1);
-    _node2->ghostLinks.push_back(toNode1Link);
+    _node2->ghostLinks.PushBack(toNode1Link);
 }
 
 template <typename T, typename U>
@@ -302,12 +309,12 @@ void UnidirectionalGraph<T, U>::EraseNode(Node* _node) {
         });
 
         if (it != link.ptr->ghostLinks.end()) {
-            link.ptr->ghostLinks.erase(it);
+            link.ptr->ghostLinks.Erase(it);
         }
     }
 
-    _node->links.clear();
-    _node->ghostLinks.clear();
+    _node->links.Clear();
+    _node->ghostLinks.Clear();
 
     m_pool.Deallocate(_node);
     m_size--;
@@ -316,7 +323,7 @@ void UnidirectionalGraph<T, U>::EraseNode(Node* _node) {
 template <typename T, typename U>
 void UnidirectionalGraph<T, U>::EraseLink(Node* _node, size_t _index) {
     if (_index < _node->links.size()) {
-        _node->links.erase(_node->links.begin() + _index);
+        _node->links.Erase(_node->links.begin() + _index);
     }
 }
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
 #include "defines.hpp"
 
 #include "string.hpp"
@@ -32,7 +36,7 @@ void HashCombine(std::size_t &_seed, const T &_value, const R &..._rest) {
  * @param _seed The seed value for the MurmurHash3 algorithm.
  * @return The MurmurHash3 hash value.
  */
-const uint32_t MurmurHash3(const unsigned char *_data, uint64_t _lenght, uint64_t _seed) noexcept {
+inline uint32_t MurmurHash3(const unsigned char *_data, uint64_t _lenght, uint64_t _seed) noexcept {
     const uint32_t m = 0x5bd1e995;
     const int r = 24;
 
@@ -114,6 +118,31 @@ inline consteval T FNV1aHash(StringType _string, T _hash = (sizeof(T)==4) ? fnvO
     return (*_string == '\0') ? _hash : FNV1aHash<T>(_string + 1, (_hash ^ static_cast<T>(*_string)) * ((sizeof(T)==4) ? fnvPrime32 : fnvPrime64));
 }
 
+/**
+ * @brief Computes the FNV-1a hash of a string view, at compile time or at runtime.
+ *
+ * Gives the same value as the consteval overload for the same characters, so strings only known at runtime can be
+ * matched against hashes of literals computed at compile time.
+ *
+ * @tparam T The type of the hash value.
+ * @tparam CharType The character type of the string view.
+ * @param _string The string view for which to compute the FNV-1a hash.
+ * @param _hash The initial hash value (default is FNV-1 offset value).
+ * @return The FNV-1a hash value of the input string.
+ */
+template <typename T, typename CharType>
+inline constexpr T FNV1aHash(std::basic_string_view<CharType> _string, T _hash = (sizeof(T)==4) ? fnvOffset32 : fnvOffset64) noexcept
+{
+    constexpr T prime = (sizeof(T) == 4) ? static_cast<T>(fnvPrime32) : static_cast<T>(fnvPrime64);
+
+    for (const CharType c : _string) {
+        _hash ^= static_cast<T>(c);
+        _hash *= prime;
+    }
+
+    return _hash;
+}
+
 // clang-format on
 
 }  // namespace Rake::libraries
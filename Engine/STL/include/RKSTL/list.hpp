@@ -1,5 +1,13 @@
 #pragma once
 
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
 #include "defines.hpp"
 
 #include "pool.hpp"
@@ -218,7 +226,8 @@ class DoublyLinkedList {
 };
 
 template <typename T>
-DoublyLinkedList<T>::DoublyLinkedList(size_t _capacity) : m_head(nullptr), m_tail(nullptr), m_pool(_capacity) {}
+DoublyLinkedList<T>::DoublyLinkedList(size_t _capacity)
+    : m_head(nullptr), m_tail(nullptr), m_pool(_capacity, PoolLayout::segmented) {}
 
 template <typename T>
 DoublyLinkedList<T>::DoublyLinkedList(MemoryPool<T> &_pool) : m_head(nullptr), m_tail(nullptr), m_pool(_pool) {}
@@ -349,4 +358,534 @@ void DoublyLinkedList<T>::ShrinkToFit() {
     }
 }
 
+/**
+ * @brief The links an element embeds to be stored in an IntrusiveList.
+ *
+ * An element type derives from one hook per list it can belong to at the same time, each with a different tag.
+ * Copying an element does not copy its links, the copy starts unlinked.
+ *
+ * @tparam Tag Distinguishes the hooks of an element that belongs to several lists.
+ */
+template <typename Tag = void>
+class IntrusiveListHook {
+    template <typename, typename, bool>
+    friend class IntrusiveList;
+
+   private:
+    IntrusiveListHook *m_next = nullptr;
+    IntrusiveListHook *m_prev = nullptr;
+    uint64_t m_label = 0;
+
+   public:
+    IntrusiveListHook() = default;
+
+    IntrusiveListHook(const IntrusiveListHook &) noexcept {}
+
+    IntrusiveListHook &operator=(const IntrusiveListHook &) noexcept { return *this; }
+
+   public:
+    /**
+     * @brief Checks whether the element currently belongs to a list.
+     */
+    NODISCARD inline bool IsLinked() const noexcept { return m_next != nullptr; }
+};
+
+/**
+ * @brief A doubly linked list threading elements through the hooks they embed, without allocating or storing indices.
+ *
+ * The list never owns its elements: inserting links an existing element in O(1), erasing unlinks it in O(1) and the
+ * element must outlive its membership. Whole lists are merged in O(1) by splicing, spliced nodes keep their address.
+ *
+ * With OrderLabels enabled every element also carries an order-maintenance label, so that Precedes answers whether an
+ * element comes before another in O(1). Labels are assigned between the neighbours of the inserted element and, when
+ * no gap is left, the smallest enclosing label range that is not too dense is evenly relabeled, as in the simplified
+ * order-maintenance algorithm of Bender et al., which keeps insertion amortized O(log n). Splicing into a non-empty
+ * labeled list labels every moved element and is O(k log n).
+ *
+ * @tparam T The element type, deriving from IntrusiveListHook<Tag>.
+ * @tparam Tag The tag of the hook the list threads its elements through.
+ * @tparam OrderLabels Whether to maintain order labels for Precedes.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename T, typename Tag = void, bool OrderLabels = false>
+class IntrusiveList final : public NonCopyable {
+   public:
+    using Hook = IntrusiveListHook<Tag>;
+
+   private:
+    static constexpr uint32_t c_labelBits = 63;
+    static constexpr uint64_t c_labelSpace = uint64_t(1) << c_labelBits;
+    static constexpr uint64_t c_labelGap = uint64_t(1) << 40;
+    static constexpr double c_densityThreshold = 1.5;
+
+    Hook m_sentinel;
+    size_t m_size = 0;
+
+   public:
+    /**
+     * @brief Bidirectional iterator over the elements of an IntrusiveList.
+     */
+    template <bool Const>
+    class BasicIterator final {
+        friend class IntrusiveList;
+
+        template <bool>
+        friend class BasicIterator;
+
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+       private:
+        Hook *m_hook = nullptr;
+
+       public:
+        BasicIterator() = default;
+
+        explicit BasicIterator(Hook *_hook) noexcept : m_hook(_hook) {}
+
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst> &_other) noexcept : m_hook(_other.m_hook) {}
+
+        BasicIterator &operator++() noexcept {
+            m_hook = m_hook->m_next;
+            return *this;
+        }
+
+        BasicIterator &operator--() noexcept {
+            m_hook = m_hook->m_prev;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator it(*this);
+            --*this;
+            return it;
+        }
+
+        NODISCARD inline reference operator*() const noexcept { return ToElement(m_hook); }
+        NODISCARD inline pointer operator->() const noexcept { return &ToElement(m_hook); }
+
+        NODISCARD inline bool operator==(const BasicIterator &_other) const noexcept {
+            return m_hook == _other.m_hook;
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+   public:
+    IntrusiveList() noexcept { Reset(); }
+
+    /**
+     * @brief Unlinks every element, the elements themselves are left alive.
+     */
+    ~IntrusiveList() { Clear(); }
+
+    IntrusiveList(IntrusiveList &&_other) noexcept {
+        Reset();
+        TakeNodes(_other);
+    }
+
+    IntrusiveList &operator=(IntrusiveList &&_other) noexcept {
+        if (this == &_other) return *this;
+
+        Clear();
+        TakeNodes(_other);
+
+        return *this;
+    }
+
+   public:
+    /**
+     * @brief Links an element at the end of the list.
+     *
+     * @param _element The element to link, it must not belong to a list through the same hook.
+     * @return Iterator An iterator to the element.
+     */
+    Iterator PushBack(T &_element) { return Insert(end(), _element); }
+
+    /**
+     * @brief Links an element at the beginning of the list.
+     *
+     * @param _element The element to link, it must not belong to a list through the same hook.
+     * @return Iterator An iterator to the element.
+     */
+    Iterator PushFront(T &_element) { return Insert(begin(), _element); }
+
+    /**
+     * @brief Links an element before the specified position in O(1), amortized O(log n) with order labels.
+     *
+     * @param _pos The position before which the element is linked.
+     * @param _element The element to link, it must not belong to a list through the same hook.
+     * @return Iterator An iterator to the element.
+     * @throws std::invalid_argument if the element is already linked.
+     */
+    Iterator Insert(Iterator _pos, T &_element) {
+        Hook *hook = ToHook(_element);
+
+        if (hook->IsLinked()) throw std::invalid_argument("Element already linked!");
+
+        LinkBefore(_pos.m_hook, hook);
+
+        return Iterator(hook);
+    }
+
+    /**
+     * @brief Unlinks the element at the specified position.
+     *
+     * @param _pos The position of the element, it must not be end().
+     * @return Iterator An iterator to the element that followed it.
+     */
+    Iterator Erase(Iterator _pos) noexcept {
+        Hook *next = _pos.m_hook->m_next;
+
+        Unlink(_pos.m_hook);
+
+        return Iterator(next);
+    }
+
+    /**
+     * @brief Unlinks an element of the list.
+     *
+     * @param _element The element to unlink, it must belong to this list.
+     */
+    void Remove(T &_element) noexcept { Unlink(ToHook(_element)); }
+
+    /**
+     * @brief Unlinks the first element, the list must not be empty.
+     *
+     * @return T& The unlinked element.
+     */
+    T &PopFront() noexcept {
+        T &element = Front();
+        Unlink(m_sentinel.m_next);
+        return element;
+    }
+
+    /**
+     * @brief Unlinks the last element, the list must not be empty.
+     *
+     * @return T& The unlinked element.
+     */
+    T &PopBack() noexcept {
+        T &element = Back();
+        Unlink(m_sentinel.m_prev);
+        return element;
+    }
+
+    /**
+     * @brief Moves every element of another list before the specified position, O(1) without order labels.
+     *
+     * @param _pos The position before which the elements are moved.
+     * @param _other The list to empty, the moved elements keep their order.
+     */
+    void Splice(Iterator _pos, IntrusiveList &_other);
+
+    /**
+     * @brief Moves an element of another list, or of this one, before the specified position.
+     *
+     * @param _pos The position before which the element is moved.
+     * @param _other The list the element belongs to.
+     * @param _it The position of the element in the other list.
+     */
+    void Splice(Iterator _pos, IntrusiveList &_other, Iterator _it);
+
+    /**
+     * @brief Moves a range of elements of another list, or of this one, before the specified position.
+     *
+     * @note The range is counted to keep the sizes in sync, so the move is O(k) like std::list::splice.
+     *
+     * @param _pos The position before which the elements are moved, it must not lie in the range.
+     * @param _other The list the elements belong to.
+     * @param _first The first element of the range.
+     * @param _last The end of the range.
+     */
+    void Splice(Iterator _pos, IntrusiveList &_other, Iterator _first, Iterator _last);
+
+    /**
+     * @brief Checks in O(1) whether an element comes before another in the list.
+     *
+     * @param _left An element of the list.
+     * @param _right An element of the list.
+     * @return bool True if the left element precedes the right one.
+     */
+    NODISCARD bool Precedes(const T &_left, const T &_right) const noexcept
+        requires OrderLabels
+    {
+        return ToHook(_left)->m_label < ToHook(_right)->m_label;
+    }
+
+    /**
+     * @brief Unlinks every element in O(n).
+     */
+    void Clear() noexcept;
+
+   public:
+    NODISCARD inline T &Front() noexcept { return ToElement(m_sentinel.m_next); }
+
+    NODISCARD inline T &Back() noexcept { return ToElement(m_sentinel.m_prev); }
+
+    NODISCARD inline bool empty() const noexcept { return m_size == 0; }
+
+    NODISCARD inline size_t size() const noexcept { return m_size; }
+
+    NODISCARD inline Iterator begin() noexcept { return Iterator(m_sentinel.m_next); }
+
+    NODISCARD inline ConstIterator begin() const noexcept { return ConstIterator(m_sentinel.m_next); }
+
+    NODISCARD inline ConstIterator cbegin() const noexcept { return begin(); }
+
+    NODISCARD inline Iterator end() noexcept { return Iterator(&m_sentinel); }
+
+    NODISCARD inline ConstIterator end() const noexcept { return ConstIterator(const_cast<Hook *>(&m_sentinel)); }
+
+    NODISCARD inline ConstIterator cend() const noexcept { return end(); }
+
+    /**
+     * @brief Gets an iterator to an element of the list in O(1).
+     */
+    NODISCARD static inline Iterator GetIterator(T &_element) noexcept { return Iterator(ToHook(_element)); }
+
+   private:
+    NODISCARD static inline Hook *ToHook(T &_element) noexcept { return static_cast<Hook *>(std::addressof(_element)); }
+
+    NODISCARD static inline const Hook *ToHook(const T &_element) noexcept {
+        return static_cast<const Hook *>(std::addressof(_element));
+    }
+
+    NODISCARD static inline T &ToElement(Hook *_hook) noexcept { return *static_cast<T *>(_hook); }
+
+    /**
+     * @brief Makes the list empty without touching the elements it linked.
+     */
+    void Reset() noexcept {
+        m_sentinel.m_next = m_sentinel.m_prev = &m_sentinel;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Moves every element of another list into this empty one, keeping their labels.
+     */
+    void TakeNodes(IntrusiveList &_other) noexcept;
+
+    /**
+     * @brief Links a hook before another and labels it.
+     */
+    void LinkBefore(Hook *_pos, Hook *_hook);
+
+    /**
+     * @brief Unlinks a hook, leaving it unlinked.
+     */
+    void Unlink(Hook *_hook) noexcept;
+
+    /**
+     * @brief Labels a freshly linked hook between its neighbours, relabeling a range around it if they leave no gap.
+     *
+     * @throws std::length_error if the label space is exhausted.
+     */
+    void AssignLabel(Hook *_hook);
+};
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::Splice(Iterator _pos, IntrusiveList &_other) {
+    if (this == &_other || _other.empty()) return;
+
+    if (empty() && _pos.m_hook == &m_sentinel) return TakeNodes(_other);
+
+    if constexpr (OrderLabels) {
+        while (!_other.empty()) {
+            Hook *hook = _other.m_sentinel.m_next;
+
+            _other.Unlink(hook);
+            LinkBefore(_pos.m_hook, hook);
+        }
+    } else {
+        Hook *first = _other.m_sentinel.m_next;
+        Hook *last = _other.m_sentinel.m_prev;
+        Hook *next = _pos.m_hook;
+        Hook *prev = next->m_prev;
+
+        prev->m_next = first;
+        first->m_prev = prev;
+        last->m_next = next;
+        next->m_prev = last;
+
+        m_size += _other.m_size;
+
+        _other.Reset();
+    }
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::Splice(Iterator _pos, IntrusiveList &_other, Iterator _it) {
+    if (_pos == _it || _pos.m_hook == _it.m_hook->m_next) return;
+
+    _other.Unlink(_it.m_hook);
+    LinkBefore(_pos.m_hook, _it.m_hook);
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::Splice(Iterator _pos, IntrusiveList &_other, Iterator _first, Iterator _last) {
+    if (_first == _last) return;
+
+    if constexpr (OrderLabels) {
+        while (_first != _last) {
+            Hook *hook = (_first++).m_hook;
+
+            _other.Unlink(hook);
+            LinkBefore(_pos.m_hook, hook);
+        }
+    } else {
+        if (this != &_other) {
+            size_t count = 0;
+
+            for (Iterator it = _first; it != _last; ++it) ++count;
+
+            _other.m_size -= count;
+            m_size += count;
+        }
+
+        Hook *first = _first.m_hook;
+        Hook *last = _last.m_hook->m_prev;
+
+        first->m_prev->m_next = _last.m_hook;
+        _last.m_hook->m_prev = first->m_prev;
+
+        Hook *next = _pos.m_hook;
+        Hook *prev = next->m_prev;
+
+        prev->m_next = first;
+        first->m_prev = prev;
+        last->m_next = next;
+        next->m_prev = last;
+    }
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::Clear() noexcept {
+    Hook *hook = m_sentinel.m_next;
+
+    while (hook != &m_sentinel) {
+        Hook *next = hook->m_next;
+
+        hook->m_next = hook->m_prev = nullptr;
+        hook = next;
+    }
+
+    Reset();
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::TakeNodes(IntrusiveList &_other) noexcept {
+    if (_other.empty()) return;
+
+    m_sentinel.m_next = _other.m_sentinel.m_next;
+    m_sentinel.m_prev = _other.m_sentinel.m_prev;
+    m_sentinel.m_next->m_prev = &m_sentinel;
+    m_sentinel.m_prev->m_next = &m_sentinel;
+    m_size = _other.m_size;
+
+    _other.Reset();
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::LinkBefore(Hook *_pos, Hook *_hook) {
+    Hook *prev = _pos->m_prev;
+
+    _hook->m_next = _pos;
+    _hook->m_prev = prev;
+    prev->m_next = _hook;
+    _pos->m_prev = _hook;
+
+    m_size++;
+
+    if constexpr (OrderLabels) {
+        try {
+            AssignLabel(_hook);
+        } catch (...) {
+            Unlink(_hook);
+            throw;
+        }
+    }
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::Unlink(Hook *_hook) noexcept {
+    _hook->m_prev->m_next = _hook->m_next;
+    _hook->m_next->m_prev = _hook->m_prev;
+    _hook->m_next = _hook->m_prev = nullptr;
+
+    m_size--;
+}
+
+template <typename T, typename Tag, bool OrderLabels>
+void IntrusiveList<T, Tag, OrderLabels>::AssignLabel(Hook *_hook) {
+    const uint64_t lower = _hook->m_prev == &m_sentinel ? 0 : _hook->m_prev->m_label + 1;
+    const uint64_t upper = _hook->m_next == &m_sentinel ? c_labelSpace : _hook->m_next->m_label;
+
+    if (lower < upper) {
+        const bool isFirst = _hook->m_prev == &m_sentinel;
+        const bool isLast = _hook->m_next == &m_sentinel;
+
+        // Pushes at either end step by a fixed gap rather than halving it, so that they rarely run out of labels.
+        const uint64_t step = std::min(c_labelGap, (upper - lower) / 2);
+
+        if (isLast && !isFirst) {
+            _hook->m_label = lower + step;
+        } else if (isFirst && !isLast) {
+            _hook->m_label = upper - 1 - step;
+        } else {
+            _hook->m_label = lower + (upper - lower) / 2;
+        }
+
+        return;
+    }
+
+    // Find the smallest aligned label range around the neighbour holding at most 1.5^bits elements and spread them.
+    const Hook *anchor = _hook->m_prev != &m_sentinel ? _hook->m_prev : _hook->m_next;
+
+    double threshold = 1.0;
+
+    for (uint32_t bits = 1; bits <= c_labelBits; ++bits) {
+        threshold *= c_densityThreshold;
+
+        const uint64_t rangeSize = uint64_t(1) << bits;
+        const uint64_t base = anchor->m_label & ~(rangeSize - 1);
+
+        auto inRange = [&](const Hook *_other) {
+            return _other == _hook || (_other->m_label >= base && _other->m_label - base < rangeSize);
+        };
+
+        Hook *first = const_cast<Hook *>(anchor);
+
+        while (first->m_prev != &m_sentinel && inRange(first->m_prev)) first = first->m_prev;
+
+        size_t count = 0;
+
+        for (const Hook *hook = first; hook != &m_sentinel && inRange(hook); hook = hook->m_next) ++count;
+
+        if (static_cast<double>(count) > threshold) continue;
+
+        const uint64_t spacing = rangeSize / count;
+
+        for (uint64_t label = base; count > 0; --count, label += spacing, first = first->m_next) first->m_label = label;
+
+        return;
+    }
+
+    throw std::length_error("Order labels exhausted!");
+}
+
 }  // namespace Rake::libraries
@@ -1,8 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 #include "defines.hpp"
+#include "virtual_memory.hpp"
+#include "memory_tracker.hpp"
 
 namespace Rake::libraries {
 
@@ -33,4 +44,583 @@ constexpr void Swap(T &_left, T &_right) noexcept {
     _left ^= _right;
 }
 
+/**
+ * @brief Rounds an address or a size up to the next multiple of a power of two alignment.
+ *
+ * @param _value The value to round up.
+ * @param _alignment The alignment, must be a power of two.
+ * @return size_t The aligned value.
+ */
+NODISCARD constexpr size_t AlignUp(size_t _value, size_t _alignment) noexcept {
+    return (_value + _alignment - 1) & ~(_alignment - 1);
+}
+
+/**
+ * @brief A bump-pointer arena that hands out memory from a preallocated block and releases it all at once.
+ *
+ * Allocating is a pointer increment, individual allocations are never freed and Reset rewinds the arena in O(1).
+ * When the block runs out the arena chains overflow pages from the global heap instead of failing, and the next Reset
+ * grows the block to the peak usage so that a steady workload stops overflowing after one reset.
+ *
+ * An arena can instead place its block in a reserved virtual address range: the block is committed as the bump pointer
+ * advances and only overflows once the whole range is used, and Trim returns the committed tail to the OS.
+ *
+ * @note Destructors of objects created with Construct are not run by Reset, the arena is meant for trivially
+ * destructible temporaries or for objects whose owner destroys them explicitly.
+ *
+ * @multithreading Not thread-safe, use one arena per thread.
+ */
+class LinearArena final : public NonCopyable {
+   private:
+    struct Page {
+        Page *next = nullptr;
+        size_t capacity = 0;
+
+        NODISCARD inline std::byte *GetData() noexcept { return reinterpret_cast<std::byte *>(this + 1); }
+    };
+
+    static constexpr size_t c_pageAlignment = alignof(std::max_align_t);
+    static constexpr size_t c_hugePageThreshold = RK_MEBIBYTES(size_t(64));
+
+    VirtualReservation m_reservation;
+    MemoryTag m_tag = MemoryTracker::GetCurrentTag();
+    Page *m_block = nullptr;
+    Page *m_overflow = nullptr;
+    size_t m_offset = 0;
+    size_t m_overflowOffset = 0;
+    size_t m_usedMemory = 0;
+    size_t m_peakMemory = 0;
+    size_t m_overflowCount = 0;
+
+   public:
+    /**
+     * @brief Constructs a LinearArena with a block of the specified capacity.
+     *
+     * @param _capacity The capacity of the block in bytes.
+     * @throws std::bad_alloc if the block cannot be allocated.
+     */
+    LinearArena(size_t _capacity) : m_block(AllocatePage(_capacity)) {}
+
+    /**
+     * @brief Constructs a LinearArena whose block lives in a reserved virtual address range.
+     *
+     * @param _capacity The number of bytes committed up front.
+     * @param _reservation The size of the address range in bytes, large ranges ask for transparent huge pages.
+     * @throws std::bad_alloc if the range cannot be reserved or committed.
+     */
+    LinearArena(size_t _capacity, size_t _reservation)
+        : m_reservation(std::max(_reservation, sizeof(Page) + _capacity), _reservation >= c_hugePageThreshold) {
+        m_reservation.Commit(sizeof(Page) + _capacity);
+
+        m_block = new (m_reservation.GetData()) Page();
+        m_block->capacity = m_reservation.GetCommittedSize() - sizeof(Page);
+
+        MemoryTracker::RecordAllocation(m_tag, m_reservation.GetCommittedSize());
+    }
+
+    /**
+     * @brief Releases the block and every overflow page.
+     */
+    ~LinearArena() {
+        ReleaseOverflowPages();
+
+        if (m_reservation.GetData()) {
+            MemoryTracker::RecordDeallocation(m_tag, m_reservation.GetCommittedSize());
+        } else {
+            FreePage(m_block);
+        }
+    }
+
+    LinearArena(LinearArena &&_other) noexcept
+        : m_reservation(std::move(_other.m_reservation)),
+          m_tag(_other.m_tag),
+          m_block(std::exchange(_other.m_block, nullptr)),
+          m_overflow(std::exchange(_other.m_overflow, nullptr)),
+          m_offset(std::exchange(_other.m_offset, 0)),
+          m_overflowOffset(std::exchange(_other.m_overflowOffset, 0)),
+          m_usedMemory(std::exchange(_other.m_usedMemory, 0)),
+          m_peakMemory(std::exchange(_other.m_peakMemory, 0)),
+          m_overflowCount(std::exchange(_other.m_overflowCount, 0)) {}
+
+   public:
+    /**
+     * @brief Allocates uninitialized memory from the arena.
+     *
+     * @param _size The size of the allocation in bytes.
+     * @param _alignment The alignment of the allocation, must be a power of two.
+     * @return void* A pointer to the allocated memory, valid until the next Reset.
+     * @throws std::invalid_argument if the alignment is not a power of two.
+     * @throws std::bad_alloc if an overflow page cannot be allocated.
+     */
+    NODISCARD void *Allocate(size_t _size, size_t _alignment = alignof(std::max_align_t)) {
+        if (_alignment == 0 || (_alignment & (_alignment - 1)))
+            throw std::invalid_argument("Arena alignment must be a power of two!");
+
+        if (m_block) {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(m_block->GetData());
+            const size_t offset = AlignUp(base + m_offset, _alignment) - base;
+
+            if (offset + _size > m_block->capacity && m_reservation.GetData()) CommitBlock(offset + _size);
+
+            if (offset + _size <= m_block->capacity) {
+                m_usedMemory += offset + _size - m_offset;
+                m_peakMemory = std::max(m_peakMemory, m_usedMemory);
+                m_offset = offset + _size;
+
+                return m_block->GetData() + offset;
+            }
+        }
+
+        return AllocateOverflow(_size, _alignment);
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for an array of objects of type T.
+     *
+     * @param _count The number of elements.
+     * @return T* A pointer to the first element, valid until the next Reset.
+     */
+    template <typename T>
+    NODISCARD T *AllocateArray(size_t _count) {
+        if (_count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+        return static_cast<T *>(Allocate(_count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Constructs an object of type T in the arena.
+     *
+     * @tparam Args The types of the arguments to be forwarded to the constructor.
+     * @param _args The arguments to be forwarded to the constructor of type T.
+     * @return T* A pointer to the object, valid until the next Reset.
+     */
+    template <typename T, typename... Args>
+    T *Construct(Args &&..._args) {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(_args)...);
+    }
+
+    /**
+     * @brief Releases every allocation at once.
+     *
+     * @note If the previous cycle overflowed, the block is reallocated to fit the peak usage. Reserved blocks cannot
+     * grow past their range and keep it.
+     */
+    void Reset() {
+        if (m_overflow && m_reservation.GetData()) {
+            ReleaseOverflowPages();
+        } else if (m_overflow) {
+            const size_t blockCapacity = AlignUp(std::max(m_peakMemory, capacity()), c_pageAlignment);
+
+            ReleaseOverflowPages();
+            FreePage(std::exchange(m_block, nullptr));
+
+            m_block = AllocatePage(blockCapacity);
+        }
+
+        m_offset = 0;
+        m_usedMemory = 0;
+    }
+
+    /**
+     * @brief Returns the committed memory of a reserved block past the current allocations to the OS.
+     *
+     * @note Arenas not backed by a reservation are left untouched.
+     */
+    void Trim() noexcept {
+        if (!m_reservation.GetData()) return;
+
+        const size_t committedSize = m_reservation.GetCommittedSize();
+
+        m_reservation.Decommit(sizeof(Page) + m_offset);
+        m_block->capacity = m_reservation.GetCommittedSize() - sizeof(Page);
+
+        MemoryTracker::RecordResize(m_tag, committedSize, m_reservation.GetCommittedSize());
+    }
+
+    /**
+     * @brief Gets the number of bytes allocated since the last Reset, padding included.
+     */
+    NODISCARD inline size_t GetUsedMemory() const noexcept { return m_usedMemory; }
+
+    /**
+     * @brief Gets the highest number of bytes allocated between two Resets.
+     */
+    NODISCARD inline size_t GetPeakMemory() const noexcept { return m_peakMemory; }
+
+    /**
+     * @brief Gets the number of overflow pages allocated since the arena was created.
+     */
+    NODISCARD inline size_t GetOverflowCount() const noexcept { return m_overflowCount; }
+
+    /**
+     * @brief Gets the capacity of the block in bytes.
+     */
+    NODISCARD inline size_t capacity() const noexcept { return m_block ? m_block->capacity : 0; }
+
+   private:
+    /**
+     * @brief Allocates a page header followed by the specified number of bytes.
+     */
+    NODISCARD Page *AllocatePage(size_t _capacity) {
+        Page *page = new (::operator new(sizeof(Page) + _capacity, std::align_val_t(c_pageAlignment))) Page();
+
+        page->capacity = _capacity;
+
+        MemoryTracker::RecordAllocation(m_tag, sizeof(Page) + _capacity);
+
+        return page;
+    }
+
+    /**
+     * @brief Frees a page allocated with AllocatePage, null pages are ignored.
+     */
+    void FreePage(Page *_page) noexcept {
+        if (!_page) return;
+
+        MemoryTracker::RecordDeallocation(m_tag, sizeof(Page) + _page->capacity);
+
+        ::operator delete(_page, std::align_val_t(c_pageAlignment));
+    }
+
+    /**
+     * @brief Commits enough of a reserved block for the given capacity, at least doubling the committed size, as long
+     * as the range allows it.
+     */
+    void CommitBlock(size_t _capacity) {
+        const size_t committedSize = m_reservation.GetCommittedSize();
+        const size_t reservedSize = m_reservation.GetReservedSize();
+
+        if (sizeof(Page) + _capacity > reservedSize) return;
+
+        m_reservation.Commit(std::min(std::max(sizeof(Page) + _capacity, committedSize * 2), reservedSize));
+        m_block->capacity = m_reservation.GetCommittedSize() - sizeof(Page);
+
+        MemoryTracker::RecordResize(m_tag, committedSize, m_reservation.GetCommittedSize());
+    }
+
+    /**
+     * @brief Frees the chain of overflow pages.
+     */
+    void ReleaseOverflowPages() noexcept {
+        while (m_overflow) FreePage(std::exchange(m_overflow, m_overflow->next));
+
+        m_overflowOffset = 0;
+    }
+
+    /**
+     * @brief Serves an allocation that does not fit in the block from the current overflow page or a new one.
+     */
+    void *AllocateOverflow(size_t _size, size_t _alignment) {
+        uintptr_t base = m_overflow ? reinterpret_cast<uintptr_t>(m_overflow->GetData()) : 0;
+        size_t offset = m_overflow ? AlignUp(base + m_overflowOffset, _alignment) - base : 0;
+
+        // Page data is only aligned to c_pageAlignment, the extra _alignment bytes cover the padding of larger ones.
+        if (!m_overflow || offset + _size > m_overflow->capacity) {
+            Page *page = AllocatePage(std::max(capacity(), _size + _alignment));
+
+            page->next = m_overflow;
+            m_overflow = page;
+            m_overflowOffset = 0;
+            m_overflowCount++;
+
+            base = reinterpret_cast<uintptr_t>(page->GetData());
+            offset = AlignUp(base, _alignment) - base;
+        }
+
+        m_usedMemory += offset + _size - m_overflowOffset;
+        m_peakMemory = std::max(m_peakMemory, m_usedMemory);
+        m_overflowOffset = offset + _size;
+
+        return m_overflow->GetData() + offset;
+    }
+};
+
+/**
+ * @brief A double-buffered frame allocator made of two LinearArena.
+ *
+ * BeginFrame flips the arenas and resets the one that becomes current, so memory allocated during a frame stays valid
+ * through the following frame. This lets per-frame temporaries (formatted strings, query results, command lists) be
+ * consumed one frame later, e.g. by the renderer, without going through the global heap.
+ *
+ * @multithreading Not thread-safe, allocate from the thread that calls BeginFrame.
+ */
+class FrameAllocator final : public NonCopyable {
+   private:
+    LinearArena m_arenas[2];
+    size_t m_frameIndex = 0;
+
+   public:
+    /**
+     * @brief Constructs a FrameAllocator with two arenas of the specified capacity.
+     *
+     * @param _capacity The capacity of each arena in bytes.
+     */
+    FrameAllocator(size_t _capacity) : m_arenas{LinearArena(_capacity), LinearArena(_capacity)} {}
+
+    /**
+     * @brief Constructs a FrameAllocator with two arenas living in reserved virtual address ranges.
+     *
+     * @param _capacity The number of bytes committed up front by each arena.
+     * @param _reservation The size of the address range of each arena in bytes.
+     */
+    FrameAllocator(size_t _capacity, size_t _reservation)
+        : m_arenas{LinearArena(_capacity, _reservation), LinearArena(_capacity, _reservation)} {}
+
+   public:
+    /**
+     * @brief Flips the arenas and releases the allocations made two frames ago.
+     */
+    inline void BeginFrame() {
+        m_frameIndex ^= 1;
+        m_arenas[m_frameIndex].Reset();
+    }
+
+    /**
+     * @brief Allocates uninitialized memory valid until the end of the next frame.
+     *
+     * @see LinearArena::Allocate
+     */
+    NODISCARD inline void *Allocate(size_t _size, size_t _alignment = alignof(std::max_align_t)) {
+        return m_arenas[m_frameIndex].Allocate(_size, _alignment);
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for an array valid until the end of the next frame.
+     *
+     * @see LinearArena::AllocateArray
+     */
+    template <typename T>
+    NODISCARD inline T *AllocateArray(size_t _count) {
+        return m_arenas[m_frameIndex].AllocateArray<T>(_count);
+    }
+
+    /**
+     * @brief Constructs an object valid until the end of the next frame.
+     *
+     * @see LinearArena::Construct
+     */
+    template <typename T, typename... Args>
+    inline T *Construct(Args &&..._args) {
+        return m_arenas[m_frameIndex].Construct<T>(std::forward<Args>(_args)...);
+    }
+
+    /**
+     * @brief Gets the arena serving the current frame.
+     */
+    NODISCARD inline LinearArena &GetCurrentArena() noexcept { return m_arenas[m_frameIndex]; }
+
+    /**
+     * @brief Gets the arena holding the allocations of the previous frame.
+     */
+    NODISCARD inline LinearArena &GetPreviousArena() noexcept { return m_arenas[m_frameIndex ^ 1]; }
+};
+
+/**
+ * @brief A LIFO stack allocator for nested scratch allocations released in O(1) by rewinding to a marker.
+ *
+ * GetMarker captures the top of the stack and FreeToMarker rewinds it, releasing everything allocated since in one
+ * step. StackAllocatorScope wraps the pair so a deep call chain can release its scratch memory on scope exit.
+ *
+ * In RK_DEBUG builds every allocation is followed by a canary that FreeToMarker validates, and the released bytes are
+ * poisoned, so writes past the end of a scratch buffer and reads after release are caught early. The high-water mark
+ * records the deepest the stack has been to size it per thread.
+ *
+ * @multithreading Not thread-safe, use one stack allocator per thread.
+ */
+class StackAllocator final : public NonCopyable {
+   public:
+    using Marker = size_t;
+
+   private:
+#ifdef RK_DEBUG
+    struct Canary {
+        uint64_t magic;
+        size_t previous;
+    };
+
+    static constexpr uint64_t c_canaryMagic = 0xC0FFEE0DDBA11A57;
+    static constexpr uint8_t c_poisonByte = 0xDD;
+    static constexpr size_t c_noCanary = std::numeric_limits<size_t>::max();
+
+    size_t m_lastCanary = c_noCanary;
+#endif
+
+    MemoryTag m_tag = MemoryTracker::GetCurrentTag();
+    std::byte *m_data = nullptr;
+    size_t m_capacity = 0;
+    size_t m_top = 0;
+    size_t m_highWaterMark = 0;
+
+   public:
+    /**
+     * @brief Constructs a StackAllocator with the specified capacity.
+     *
+     * @param _capacity The capacity of the stack in bytes.
+     * @throws std::bad_alloc if the stack cannot be allocated.
+     */
+    StackAllocator(size_t _capacity)
+        : m_data(static_cast<std::byte *>(::operator new(_capacity, std::align_val_t(alignof(std::max_align_t))))),
+          m_capacity(_capacity) {
+        MemoryTracker::RecordAllocation(m_tag, _capacity);
+    }
+
+    /**
+     * @brief Releases the stack memory.
+     */
+    ~StackAllocator() {
+        ::operator delete(m_data, std::align_val_t(alignof(std::max_align_t)));
+
+        MemoryTracker::RecordDeallocation(m_tag, m_capacity);
+    }
+
+   public:
+    /**
+     * @brief Allocates uninitialized memory on top of the stack.
+     *
+     * @param _size The size of the allocation in bytes.
+     * @param _alignment The alignment of the allocation, must be a power of two.
+     * @return void* A pointer to the allocated memory, valid until the stack is rewound below it.
+     * @throws std::invalid_argument if the alignment is not a power of two.
+     * @throws std::bad_alloc if the stack is exhausted.
+     */
+    NODISCARD void *Allocate(size_t _size, size_t _alignment = alignof(std::max_align_t)) {
+        if (_alignment == 0 || (_alignment & (_alignment - 1)))
+            throw std::invalid_argument("Stack alignment must be a power of two!");
+
+        const uintptr_t base = reinterpret_cast<uintptr_t>(m_data);
+        const size_t offset = AlignUp(base + m_top, _alignment) - base;
+
+#ifdef RK_DEBUG
+        const size_t canaryOffset = AlignUp(base + offset + _size, alignof(Canary)) - base;
+        const size_t top = canaryOffset + sizeof(Canary);
+#else
+        const size_t top = offset + _size;
+#endif
+
+        if (top > m_capacity) throw std::bad_alloc();
+
+#ifdef RK_DEBUG
+        new (m_data + canaryOffset) Canary{c_canaryMagic, m_lastCanary};
+        m_lastCanary = canaryOffset;
+#endif
+
+        m_top = top;
+        m_highWaterMark = std::max(m_highWaterMark, m_top);
+
+        return m_data + offset;
+    }
+
+    /**
+     * @brief Allocates uninitialized storage for an array of objects of type T on top of the stack.
+     *
+     * @param _count The number of elements.
+     * @return T* A pointer to the first element.
+     */
+    template <typename T>
+    NODISCARD T *AllocateArray(size_t _count) {
+        if (_count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+        return static_cast<T *>(Allocate(_count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief Gets a marker to the current top of the stack.
+     *
+     * @return Marker The marker to rewind to with FreeToMarker.
+     */
+    NODISCARD inline Marker GetMarker() const noexcept { return m_top; }
+
+    /**
+     * @brief Releases every allocation made after the marker was taken.
+     *
+     * @note Destructors are not run, objects placed on the stack must be trivially destructible or destroyed first.
+     *
+     * @param _marker A marker previously returned by GetMarker and not rewound past yet.
+     * @throws std::out_of_range if the marker lies above the top of the stack.
+     * @throws std::runtime_error in RK_DEBUG builds if an allocation overran its canary.
+     */
+    void FreeToMarker(Marker _marker) {
+        if (_marker > m_top) throw std::out_of_range("Stack marker above the top of the stack!");
+
+#ifdef RK_DEBUG
+        while (m_lastCanary != c_noCanary && m_lastCanary >= _marker) {
+            const Canary *canary = reinterpret_cast<const Canary *>(m_data + m_lastCanary);
+
+            if (canary->magic != c_canaryMagic) throw std::runtime_error("Stack allocator canary overwritten!");
+
+            m_lastCanary = canary->previous;
+        }
+
+        std::memset(m_data + _marker, c_poisonByte, m_top - _marker);
+#endif
+
+        m_top = _marker;
+    }
+
+    /**
+     * @brief Releases every allocation.
+     */
+    inline void Reset() { FreeToMarker(0); }
+
+    /**
+     * @brief Gets the number of bytes currently allocated, padding and canaries included.
+     */
+    NODISCARD inline size_t GetUsedMemory() const noexcept { return m_top; }
+
+    /**
+     * @brief Gets the highest number of bytes ever allocated at once.
+     */
+    NODISCARD inline size_t GetHighWaterMark() const noexcept { return m_highWaterMark; }
+
+    /**
+     * @brief Gets the capacity of the stack in bytes.
+     */
+    NODISCARD inline size_t capacity() const noexcept { return m_capacity; }
+};
+
+/**
+ * @brief RAII guard rewinding a StackAllocator to the marker taken at construction when it goes out of scope.
+ *
+ * @note A canary failure detected on scope exit terminates the program, since the destructor cannot throw.
+ */
+class StackAllocatorScope final : public NonCopyable, NonMovable {
+   private:
+    StackAllocator &m_allocator;
+    StackAllocator::Marker m_marker;
+
+   public:
+    /**
+     * @brief Captures the current top of the stack.
+     *
+     * @param _allocator The stack allocator to rewind on scope exit.
+     */
+    explicit StackAllocatorScope(StackAllocator &_allocator) noexcept
+        : m_allocator(_allocator), m_marker(_allocator.GetMarker()) {}
+
+    /**
+     * @brief Releases every allocation made in the scope.
+     */
+    ~StackAllocatorScope() { m_allocator.FreeToMarker(m_marker); }
+
+   public:
+    /**
+     * @brief Allocates scratch memory released when the scope ends.
+     *
+     * @see StackAllocator::Allocate
+     */
+    NODISCARD inline void *Allocate(size_t _size, size_t _alignment = alignof(std::max_align_t)) {
+        return m_allocator.Allocate(_size, _alignment);
+    }
+
+    /**
+     * @brief Allocates scratch storage for an array released when the scope ends.
+     *
+     * @see StackAllocator::AllocateArray
+     */
+    template <typename T>
+    NODISCARD inline T *AllocateArray(size_t _count) {
+        return m_allocator.AllocateArray<T>(_count);
+    }
+};
+
 }  // namespace Rake::libraries
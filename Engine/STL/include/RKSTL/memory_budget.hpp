@@ -0,0 +1,245 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+
+#include "defines.hpp"
+#include "memory_tracker.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief How far the usage of a tag is past its budget.
+ */
+enum class BudgetPressure : uint8_t {
+    none,
+    soft,
+    hard,
+};
+
+/**
+ * @brief Eviction statistics of a memory budget.
+ */
+struct MemoryBudgetStatistics {
+    size_t usage = 0;                               /**< Bytes in use at the last check. */
+    size_t softEvictions = 0;                       /**< Evictions triggered past the soft limit only. */
+    size_t hardEvictions = 0;                       /**< Evictions triggered past the hard limit. */
+    size_t bytesEvicted = 0;                        /**< Bytes released by the evictions. */
+    BudgetPressure pressure = BudgetPressure::none; /**< Pressure left after the last check. */
+};
+
+/**
+ * @brief Keeps the memory of the subsystems within byte budgets by asking them to evict when they grow past them.
+ *
+ * A subsystem registers a soft and a hard limit for its MemoryTag together with an eviction callback. Enforce compares
+ * the usage of each tag, its live bytes in the MemoryTracker unless the budget provides its own usage callback, with
+ * the limits and calls the eviction callback with the bytes to free to get back under the soft limit. Past the soft
+ * limit eviction is opportunistic (drop cold cache entries), past the hard limit it is mandatory (flush buffers, run
+ * a garbage collection), the callback gets the pressure to tell the two apart.
+ *
+ * Checks are polled, usually once per frame, so that eviction runs at a known point of the frame and never inside an
+ * allocation.
+ *
+ * @multithreading Thread-safe, callbacks run without the manager lock held and may register or check budgets. A tag
+ * being evicted is not evicted again until its callback returns.
+ */
+class MemoryBudgetManager final : public NonCopyable {
+   public:
+    using EvictionCallback = std::function<void(size_t _bytesToFree, BudgetPressure _pressure)>;
+    using UsageCallback = std::function<size_t()>;
+
+   private:
+    struct Budget {
+        size_t softLimit = 0;
+        size_t hardLimit = 0;
+        EvictionCallback evictionCallback;
+        UsageCallback usageCallback;
+        MemoryBudgetStatistics statistics;
+        bool active = false;
+        bool evicting = false;
+    };
+
+    std::array<Budget, static_cast<size_t>(MemoryTag::count)> m_budgets;
+    mutable std::mutex m_mutex;
+
+   public:
+    MemoryBudgetManager() = default;
+
+   public:
+    /**
+     * @brief Registers or replaces the budget of a tag.
+     *
+     * @param _tag The tag to budget.
+     * @param _softLimit The usage in bytes past which eviction is requested.
+     * @param _hardLimit The usage in bytes past which eviction is mandatory, at least the soft limit.
+     * @param _evictionCallback The callback releasing memory of the tag.
+     * @param _usageCallback Measures the usage of the tag, defaults to its live bytes in the MemoryTracker.
+     * @throws std::invalid_argument if the soft limit exceeds the hard limit or the eviction callback is empty.
+     */
+    void SetBudget(
+        MemoryTag _tag,
+        size_t _softLimit,
+        size_t _hardLimit,
+        EvictionCallback _evictionCallback,
+        UsageCallback _usageCallback = {}) {
+        if (_softLimit > _hardLimit) throw std::invalid_argument("Soft limit exceeds the hard limit!");
+        if (!_evictionCallback) throw std::invalid_argument("Eviction callback is empty!");
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        Budget &budget = m_budgets[static_cast<size_t>(_tag)];
+
+        budget.softLimit = _softLimit;
+        budget.hardLimit = _hardLimit;
+        budget.evictionCallback = std::move(_evictionCallback);
+        budget.usageCallback = std::move(_usageCallback);
+        budget.statistics = MemoryBudgetStatistics();
+        budget.active = true;
+    }
+
+    /**
+     * @brief Unregisters the budget of a tag, an eviction already running completes.
+     */
+    void RemoveBudget(MemoryTag _tag) noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        Budget &budget = m_budgets[static_cast<size_t>(_tag)];
+
+        budget.active = false;
+        budget.evictionCallback = nullptr;
+        budget.usageCallback = nullptr;
+    }
+
+    /**
+     * @brief Checks whether a tag has a budget.
+     */
+    NODISCARD bool HasBudget(MemoryTag _tag) const noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_budgets[static_cast<size_t>(_tag)].active;
+    }
+
+    /**
+     * @brief Checks the usage of a tag against its budget and evicts if it is exceeded.
+     *
+     * @param _tag The tag to check, tags without a budget are never under pressure.
+     * @return BudgetPressure The pressure left once the eviction callback returned.
+     */
+    BudgetPressure Enforce(MemoryTag _tag) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        Budget &budget = m_budgets[static_cast<size_t>(_tag)];
+
+        if (!budget.active) return BudgetPressure::none;
+        if (budget.evicting) return budget.statistics.pressure;
+
+        const size_t softLimit = budget.softLimit;
+        const size_t hardLimit = budget.hardLimit;
+        const UsageCallback usageCallback = budget.usageCallback;
+
+        lock.unlock();
+
+        const size_t usage = MeasureUsage(_tag, usageCallback);
+        const BudgetPressure pressure = GetPressure(usage, softLimit, hardLimit);
+
+        if (pressure == BudgetPressure::none) {
+            lock.lock();
+
+            budget.statistics.usage = usage;
+            budget.statistics.pressure = pressure;
+
+            return pressure;
+        }
+
+        lock.lock();
+
+        // The budget may have been removed or replaced while measuring.
+        if (!budget.active) return BudgetPressure::none;
+        if (budget.evicting) return budget.statistics.pressure;
+
+        const EvictionCallback evictionCallback = budget.evictionCallback;
+
+        budget.evicting = true;
+
+        lock.unlock();
+
+        try {
+            evictionCallback(usage - softLimit, pressure);
+        } catch (...) {
+            lock.lock();
+            budget.evicting = false;
+            throw;
+        }
+
+        const size_t remainingUsage = MeasureUsage(_tag, usageCallback);
+
+        lock.lock();
+
+        budget.evicting = false;
+
+        if (pressure == BudgetPressure::hard) {
+            budget.statistics.hardEvictions++;
+        } else {
+            budget.statistics.softEvictions++;
+        }
+
+        if (remainingUsage < usage) budget.statistics.bytesEvicted += usage - remainingUsage;
+
+        budget.statistics.usage = remainingUsage;
+        budget.statistics.pressure = GetPressure(remainingUsage, softLimit, hardLimit);
+
+        return budget.statistics.pressure;
+    }
+
+    /**
+     * @brief Checks every budgeted tag, evicting the ones that exceed their budget.
+     *
+     * @return BudgetPressure The highest pressure left among the tags.
+     */
+    BudgetPressure Enforce() {
+        BudgetPressure highestPressure = BudgetPressure::none;
+
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::count); ++i) {
+            highestPressure = std::max(highestPressure, Enforce(static_cast<MemoryTag>(i)));
+        }
+
+        return highestPressure;
+    }
+
+    /**
+     * @brief Gets the eviction statistics of a tag as of its last check.
+     */
+    NODISCARD MemoryBudgetStatistics GetStatistics(MemoryTag _tag) const noexcept {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_budgets[static_cast<size_t>(_tag)].statistics;
+    }
+
+   private:
+    /**
+     * @brief Measures the usage of a tag with the budget usage callback or the MemoryTracker.
+     */
+    NODISCARD static size_t MeasureUsage(MemoryTag _tag, const UsageCallback &_usageCallback) {
+        return _usageCallback ? _usageCallback() : MemoryTracker::GetStatistics(_tag).liveBytes;
+    }
+
+    /**
+     * @brief Classifies a usage against the limits of a budget.
+     */
+    NODISCARD static constexpr BudgetPressure GetPressure(
+        size_t _usage,
+        size_t _softLimit,
+        size_t _hardLimit) noexcept {
+        if (_usage > _hardLimit) return BudgetPressure::hard;
+        if (_usage > _softLimit) return BudgetPressure::soft;
+
+        return BudgetPressure::none;
+    }
+};
+
+}  // namespace Rake::libraries
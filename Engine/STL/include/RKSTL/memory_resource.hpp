@@ -0,0 +1,151 @@
+#pragma once
+
+#include <memory_resource>
+#include <unordered_map>
+#include <cstddef>
+#include <string>
+
+#include "defines.hpp"
+#include "pool.hpp"
+#include "memory.hpp"
+#include "flat_hash_map.hpp"
+#include "concurrent_hash_map.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A std::pmr::memory_resource serving fixed-size blocks from a segmented MemoryPool.
+ *
+ * Requests that fit a block (container nodes, small strings, control blocks) are served by the pool, larger or
+ * over-aligned requests (bucket arrays, vector storage) are forwarded to the upstream resource. Every block lives in
+ * the pool pages, so the allocations of a registry stay close in memory and the pages are released in one go when the
+ * resource is destroyed.
+ *
+ * @tparam BlockSize The size of a pool block in bytes.
+ * @tparam BlockAlignment The alignment of a pool block, must be a power of two.
+ *
+ * @multithreading Thread-safe as long as the upstream resource is, the pool takes care of its own synchronization.
+ */
+template <size_t BlockSize, size_t BlockAlignment = alignof(std::max_align_t)>
+class PoolResource final : public std::pmr::memory_resource, NonCopyable {
+   private:
+    static constexpr size_t c_defaultBlocksPerPage = 64;
+
+    struct Block {
+        alignas(BlockAlignment) std::byte bytes[BlockSize];
+
+        Block() noexcept {}
+    };
+
+    MemoryPool<Block> m_pool;
+    std::pmr::memory_resource *m_upstream;
+
+   public:
+    /**
+     * @brief Constructs a PoolResource.
+     *
+     * @param _blocksPerPage The number of blocks per pool page, rounded up to a power of two of at least 64.
+     * @param _upstream The resource serving the requests that do not fit a block.
+     */
+    explicit PoolResource(size_t _blocksPerPage = c_defaultBlocksPerPage,
+                          std::pmr::memory_resource *_upstream = std::pmr::get_default_resource())
+        : m_pool(_blocksPerPage, PoolLayout::segmented, _blocksPerPage), m_upstream(_upstream) {}
+
+   public:
+    /**
+     * @brief Gets the number of blocks currently allocated from the pool.
+     */
+    NODISCARD inline size_t GetBlockCount() const noexcept { return m_pool.size(); }
+
+    /**
+     * @brief Gets the number of blocks the pool can hold before appending a page.
+     */
+    NODISCARD inline size_t GetBlockCapacity() const noexcept { return m_pool.capacity(); }
+
+    /**
+     * @brief Gets the resource serving the requests that do not fit a block.
+     */
+    NODISCARD inline std::pmr::memory_resource *GetUpstream() const noexcept { return m_upstream; }
+
+   private:
+    NODISCARD static constexpr bool FitsBlock(size_t _bytes, size_t _alignment) noexcept {
+        return _bytes <= BlockSize && _alignment <= BlockAlignment;
+    }
+
+    void *do_allocate(size_t _bytes, size_t _alignment) override {
+        if (!FitsBlock(_bytes, _alignment)) return m_upstream->allocate(_bytes, _alignment);
+
+        return m_pool.Construct()->bytes;
+    }
+
+    void do_deallocate(void *_ptr, size_t _bytes, size_t _alignment) override {
+        if (!FitsBlock(_bytes, _alignment)) return m_upstream->deallocate(_ptr, _bytes, _alignment);
+
+        m_pool.Deallocate(reinterpret_cast<Block *>(_ptr));
+    }
+
+    NODISCARD bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override {
+        return this == &_other;
+    }
+};
+
+/**
+ * @brief A std::pmr::memory_resource allocating from an RKSTL arena.
+ *
+ * Deallocation is a no-op, the memory is released in bulk by the arena (LinearArena::Reset, FrameAllocator::BeginFrame
+ * or StackAllocator::FreeToMarker). Containers using it must not outlive the arena scope they allocate from.
+ *
+ * @tparam Arena The arena type, one of LinearArena, FrameAllocator or StackAllocator.
+ *
+ * @multithreading Not thread-safe, like the arenas it wraps.
+ */
+template <typename Arena>
+class ArenaResource final : public std::pmr::memory_resource, NonCopyable {
+   private:
+    Arena &m_arena;
+
+   public:
+    /**
+     * @brief Constructs an ArenaResource.
+     *
+     * @param _arena The arena to allocate from, it must outlive the resource.
+     */
+    explicit ArenaResource(Arena &_arena) noexcept : m_arena(_arena) {}
+
+   public:
+    /**
+     * @brief Gets the arena the resource allocates from.
+     */
+    NODISCARD inline Arena &GetArena() const noexcept { return m_arena; }
+
+   private:
+    void *do_allocate(size_t _bytes, size_t _alignment) override { return m_arena.Allocate(_bytes, _alignment); }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    NODISCARD bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override {
+        return this == &_other;
+    }
+};
+
+/**
+ * @brief A std::pmr::unordered_map keyed by std::pmr::string, so that the names of a registry come from the same
+ * memory resource as its nodes.
+ *
+ * Lookups take any string type through the transparent StringHash and StringEqual without building a key, inserting
+ * builds the key with the map resource.
+ */
+template <typename Value>
+using PmrStringMap = std::pmr::unordered_map<std::pmr::string, Value, StringHash, StringEqual>;
+
+/**
+ * @brief A ConcurrentHashMap keyed by std::pmr::string whose shards allocate their tables and names from one memory
+ * resource, for registries read from several threads.
+ *
+ * The resource is shared by every shard and must be thread-safe, as PoolResource is.
+ */
+template <typename Value>
+using PmrConcurrentStringMap = ConcurrentHashMap<std::pmr::string, Value, StringHash, StringEqual,
+                                                 std::pmr::polymorphic_allocator<std::pair<std::pmr::string, Value>>>;
+
+}  // namespace Rake::libraries
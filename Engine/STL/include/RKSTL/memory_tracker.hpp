@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <string_view>
+#include <memory_resource>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief The subsystem an allocation is accounted to.
+ */
+enum class MemoryTag : uint8_t {
+    general,
+    renderer,
+    windowing,
+    input,
+    ecs,
+    events,
+    console,
+    logger,
+    profiler,
+    python,
+    files,
+    count
+};
+
+/**
+ * @brief Allocation statistics of a memory tag.
+ */
+struct MemoryTagStatistics {
+    size_t liveBytes = 0;        /**< Bytes currently allocated. */
+    size_t liveAllocations = 0;  /**< Allocations currently alive. */
+    size_t peakBytes = 0;        /**< Highest number of bytes allocated at once. */
+    size_t totalAllocations = 0; /**< Allocations performed since startup. */
+    size_t churn = 0;            /**< Allocations and deallocations performed since the last ResetChurn. */
+};
+
+/**
+ * @brief Statistics of every memory tag, indexed by tag.
+ */
+using MemorySnapshot = std::array<MemoryTagStatistics, static_cast<size_t>(MemoryTag::count)>;
+
+/**
+ * @brief Per-tag accounting of the memory acquired by the RKSTL allocators and, optionally, the global operator new.
+ *
+ * RKSTL allocators capture the calling thread current tag when they are constructed and report the backing memory
+ * they acquire and release (pool pages, arena blocks, slabs) to it. Counters are relaxed atomics, so recording is
+ * lock-free and a snapshot is consistent per counter but not across counters.
+ *
+ * @warning The global operator new and delete are only tracked in the runtime module built with
+ * RK_TRACK_GLOBAL_ALLOCATIONS, and freeing there a block allocated by another module, or the reverse, corrupts the
+ * heap. See tools/memory_tracking.cpp.
+ *
+ * @see MemoryTagScope
+ *
+ * @multithreading Thread-safe, the current tag is per thread.
+ */
+class MemoryTracker final {
+   private:
+    // Counters are only instantiated with static storage, which zero-initializes them.
+    struct alignas(64) TagCounters {
+        std::atomic<size_t> liveBytes;
+        std::atomic<size_t> liveAllocations;
+        std::atomic<size_t> peakBytes;
+        std::atomic<size_t> totalAllocations;
+        std::atomic<size_t> churn;
+    };
+
+    static constexpr std::string_view c_tagNames[] = {"General", "Renderer", "Windowing", "Input",  "ECS",  "Events",
+                                                      "Console", "Logger",   "Profiler",  "Python", "Files"};
+
+    static_assert(std::size(c_tagNames) == static_cast<size_t>(MemoryTag::count));
+
+    static inline TagCounters s_counters[static_cast<size_t>(MemoryTag::count)];
+    static inline thread_local MemoryTag s_currentTag = MemoryTag::general;
+
+   private:
+    MemoryTracker() = delete;
+
+   public:
+    /**
+     * @brief Accounts an allocation to a tag.
+     *
+     * @param _tag The tag to account the allocation to.
+     * @param _bytes The size of the allocation in bytes.
+     */
+    static void RecordAllocation(MemoryTag _tag, size_t _bytes) noexcept {
+        TagCounters &counters = s_counters[static_cast<size_t>(_tag)];
+
+        counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.churn.fetch_add(1, std::memory_order_relaxed);
+
+        UpdatePeak(counters, counters.liveBytes.fetch_add(_bytes, std::memory_order_relaxed) + _bytes);
+    }
+
+    /**
+     * @brief Accounts a deallocation to a tag.
+     *
+     * @param _tag The tag the allocation was accounted to.
+     * @param _bytes The size of the allocation in bytes.
+     */
+    static void RecordDeallocation(MemoryTag _tag, size_t _bytes) noexcept {
+        TagCounters &counters = s_counters[static_cast<size_t>(_tag)];
+
+        counters.liveBytes.fetch_sub(_bytes, std::memory_order_relaxed);
+        counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+        counters.churn.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Accounts the growth or shrinkage of a live allocation to a tag, e.g. a reservation committing more.
+     *
+     * @param _tag The tag the allocation was accounted to.
+     * @param _oldBytes The previous size of the allocation in bytes.
+     * @param _newBytes The new size of the allocation in bytes.
+     */
+    static void RecordResize(MemoryTag _tag, size_t _oldBytes, size_t _newBytes) noexcept {
+        TagCounters &counters = s_counters[static_cast<size_t>(_tag)];
+
+        counters.churn.fetch_add(1, std::memory_order_relaxed);
+
+        if (_newBytes < _oldBytes) {
+            counters.liveBytes.fetch_sub(_oldBytes - _newBytes, std::memory_order_relaxed);
+        } else {
+            const size_t growth = _newBytes - _oldBytes;
+
+            UpdatePeak(counters, counters.liveBytes.fetch_add(growth, std::memory_order_relaxed) + growth);
+        }
+    }
+
+    /**
+     * @brief Gets the statistics of a tag.
+     */
+    NODISCARD static MemoryTagStatistics GetStatistics(MemoryTag _tag) noexcept {
+        const TagCounters &counters = s_counters[static_cast<size_t>(_tag)];
+
+        MemoryTagStatistics statistics;
+
+        statistics.liveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+        statistics.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+        statistics.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+        statistics.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+        statistics.churn = counters.churn.load(std::memory_order_relaxed);
+
+        return statistics;
+    }
+
+    /**
+     * @brief Gets the statistics of every tag.
+     */
+    NODISCARD static MemorySnapshot GetSnapshot() noexcept {
+        MemorySnapshot snapshot;
+
+        for (size_t i = 0; i < snapshot.size(); ++i) snapshot[i] = GetStatistics(static_cast<MemoryTag>(i));
+
+        return snapshot;
+    }
+
+    /**
+     * @brief Restarts the churn counters of every tag, e.g. once per frame to measure per-frame churn.
+     */
+    static void ResetChurn() noexcept {
+        for (auto &counters : s_counters) counters.churn.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the tag allocations of the calling thread are currently accounted to.
+     */
+    NODISCARD static MemoryTag GetCurrentTag() noexcept { return s_currentTag; }
+
+    /**
+     * @brief Sets the tag allocations of the calling thread are accounted to.
+     *
+     * @return MemoryTag The previous tag.
+     */
+    static MemoryTag SetCurrentTag(MemoryTag _tag) noexcept { return std::exchange(s_currentTag, _tag); }
+
+    /**
+     * @brief Gets the display name of a tag.
+     */
+    NODISCARD static constexpr std::string_view GetTagName(MemoryTag _tag) noexcept {
+        return c_tagNames[static_cast<size_t>(_tag)];
+    }
+
+   private:
+    /**
+     * @brief Raises the peak of a tag to its live bytes if they exceed it.
+     */
+    static void UpdatePeak(TagCounters &_counters, size_t _liveBytes) noexcept {
+        size_t peakBytes = _counters.peakBytes.load(std::memory_order_relaxed);
+
+        while (_liveBytes > peakBytes &&
+               !_counters.peakBytes.compare_exchange_weak(peakBytes, _liveBytes, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+/**
+ * @brief RAII guard setting the calling thread current memory tag for its lifetime.
+ *
+ * @note Allocators constructed in the scope keep accounting their memory to the tag after the scope ends.
+ */
+class MemoryTagScope final : public NonCopyable, NonMovable {
+   private:
+    MemoryTag m_previousTag;
+
+   public:
+    /**
+     * @brief Makes a tag current, saving the previous one.
+     *
+     * @param _tag The tag to account the allocations of the scope to.
+     */
+    explicit MemoryTagScope(MemoryTag _tag) noexcept : m_previousTag(MemoryTracker::SetCurrentTag(_tag)) {}
+
+    /**
+     * @brief Restores the previous tag.
+     */
+    ~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_previousTag); }
+};
+
+/**
+ * @brief A std::pmr::memory_resource accounting every allocation it forwards to its upstream resource to a tag.
+ *
+ * @multithreading Thread-safe as long as the upstream resource is.
+ */
+class TrackedResource final : public std::pmr::memory_resource, NonCopyable {
+   private:
+    MemoryTag m_tag;
+    std::pmr::memory_resource *m_upstream;
+
+   public:
+    /**
+     * @brief Constructs a TrackedResource.
+     *
+     * @param _tag The tag to account the allocations to.
+     * @param _upstream The resource serving the allocations.
+     */
+    explicit TrackedResource(MemoryTag _tag, std::pmr::memory_resource *_upstream = std::pmr::get_default_resource())
+        : m_tag(_tag), m_upstream(_upstream) {}
+
+   public:
+    /**
+     * @brief Gets the tag allocations are accounted to.
+     */
+    NODISCARD inline MemoryTag GetTag() const noexcept { return m_tag; }
+
+   private:
+    void *do_allocate(size_t _bytes, size_t _alignment) override {
+        void *ptr = m_upstream->allocate(_bytes, _alignment);
+
+        MemoryTracker::RecordAllocation(m_tag, _bytes);
+
+        return ptr;
+    }
+
+    void do_deallocate(void *_ptr, size_t _bytes, size_t _alignment) override {
+        m_upstream->deallocate(_ptr, _bytes, _alignment);
+
+        MemoryTracker::RecordDeallocation(m_tag, _bytes);
+    }
+
+    NODISCARD bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override {
+        return this == &_other;
+    }
+};
+
+}  // namespace Rake::libraries
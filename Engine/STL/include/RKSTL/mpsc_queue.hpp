@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <cstddef>
+#include <type_traits>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief The link an element embeds to be stored in an IntrusiveMPSCQueue.
+ *
+ * An element type derives from one hook per queue it can wait in at the same time, each with a different tag.
+ * Copying an element does not copy its link.
+ *
+ * @tparam Tag Distinguishes the hooks of an element that belongs to several queues.
+ */
+template <typename Tag = void>
+class MPSCQueueHook {
+    template <typename, typename>
+    friend class IntrusiveMPSCQueue;
+
+   private:
+    std::atomic<MPSCQueueHook *> m_next = nullptr;
+
+   public:
+    MPSCQueueHook() = default;
+
+    MPSCQueueHook(const MPSCQueueHook &) noexcept {}
+
+    MPSCQueueHook &operator=(const MPSCQueueHook &) noexcept { return *this; }
+};
+
+/**
+ * @brief A lock-free multi-producer/single-consumer FIFO queue threading elements through the hooks they embed.
+ *
+ * Implements the intrusive queue of Dmitry Vyukov: producers only swap the head pointer and then link the previous
+ * head to their element, so Push is wait-free, takes no lock and never allocates. The consumer walks the links from
+ * the tail and recycles a stub node to tell an empty queue from one holding a single element.
+ *
+ * Elements pushed by the same producer are popped in the order they were pushed. Between the head swap and the link
+ * of a Push the chain is briefly broken, during that window TryPop and PopBatch return nothing even though the queue
+ * is not empty, so the consumer must poll again rather than treat an empty pop as final.
+ *
+ * The queue never owns its elements: an element must stay alive and must not be pushed again until it is popped.
+ *
+ * @tparam T The element type, deriving from MPSCQueueHook<Tag>.
+ * @tparam Tag The tag of the hook the queue threads its elements through.
+ *
+ * @multithreading Push is thread-safe. TryPop, PopBatch and empty must only be called by one consumer at a time.
+ */
+template <typename T, typename Tag = void>
+class IntrusiveMPSCQueue final : public NonCopyable {
+   public:
+    using Hook = MPSCQueueHook<Tag>;
+
+   private:
+    // Producers hammer the head while the consumer owns the tail, keeping them apart avoids false sharing.
+    alignas(64) std::atomic<Hook *> m_head;
+    alignas(64) Hook *m_tail;
+    Hook m_stub;
+
+   public:
+    IntrusiveMPSCQueue() noexcept : m_head(&m_stub), m_tail(&m_stub) {}
+
+   public:
+    /**
+     * @brief Appends an element to the queue.
+     *
+     * @param _element The element to enqueue, it must not be waiting in this queue already.
+     */
+    void Push(T &_element) noexcept { PushHook(static_cast<Hook *>(&_element)); }
+
+    /**
+     * @brief Removes the oldest element of the queue.
+     *
+     * @return T* The element, or nullptr when the queue is empty or its oldest element is still being pushed.
+     */
+    NODISCARD T *TryPop() noexcept;
+
+    /**
+     * @brief Removes up to _maxCount elements, handing each one to a callback in FIFO order.
+     *
+     * The callback may push the element back or to another queue, it is already unlinked when invoked.
+     *
+     * @param _function The callback, invoked as _function(T &).
+     * @param _maxCount The maximum number of elements to pop.
+     * @return size_t The number of elements popped.
+     */
+    template <typename Function>
+    size_t PopBatch(Function &&_function, size_t _maxCount = std::numeric_limits<size_t>::max());
+
+    /**
+     * @brief Checks whether the consumer has nothing to pop, pushes still in flight are not seen.
+     */
+    NODISCARD bool empty() const noexcept {
+        return m_tail == &m_stub && m_stub.m_next.load(std::memory_order_acquire) == nullptr;
+    }
+
+   private:
+    void PushHook(Hook *_hook) noexcept;
+
+    NODISCARD static inline T *ToElement(Hook *_hook) noexcept { return static_cast<T *>(_hook); }
+};
+
+template <typename T, typename Tag>
+void IntrusiveMPSCQueue<T, Tag>::PushHook(Hook *_hook) noexcept {
+    _hook->m_next.store(nullptr, std::memory_order_relaxed);
+
+    // The exchange serializes the producers, the release store publishes the element to the consumer.
+    Hook *previous = m_head.exchange(_hook, std::memory_order_acq_rel);
+
+    previous->m_next.store(_hook, std::memory_order_release);
+}
+
+template <typename T, typename Tag>
+T *IntrusiveMPSCQueue<T, Tag>::TryPop() noexcept {
+    Hook *tail = m_tail;
+    Hook *next = tail->m_next.load(std::memory_order_acquire);
+
+    if (tail == &m_stub) {
+        if (!next) return nullptr;
+
+        m_tail = next;
+        tail = next;
+        next = next->m_next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        m_tail = next;
+        return ToElement(tail);
+    }
+
+    // The tail has no successor: either a producer swapped the head and has not linked yet, or it is the last element.
+    if (tail != m_head.load(std::memory_order_acquire)) return nullptr;
+
+    // The stub takes the place of the last element so it can be handed out without leaving the queue headless.
+    PushHook(&m_stub);
+
+    next = tail->m_next.load(std::memory_order_acquire);
+
+    if (next) {
+        m_tail = next;
+        return ToElement(tail);
+    }
+
+    return nullptr;
+}
+
+template <typename T, typename Tag>
+template <typename Function>
+size_t IntrusiveMPSCQueue<T, Tag>::PopBatch(Function &&_function, size_t _maxCount) {
+    size_t count = 0;
+
+    while (count < _maxCount) {
+        T *element = TryPop();
+
+        if (!element) break;
+
+        count++;
+        _function(*element);
+    }
+
+    return count;
+}
+
+}  // namespace Rake::libraries
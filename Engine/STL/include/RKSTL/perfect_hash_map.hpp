@@ -0,0 +1,189 @@
+#pragma once
+
+#include <bit>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#include "defines.hpp"
+
+#include "hash.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief An immutable map from a fixed set of string keys to values, built at compile time without collisions.
+ *
+ * The table is built with CHD (compress, hash and displace): keys are split in small buckets by their FNV-1a hash,
+ * and for every bucket, largest first, the builder searches a seed that sends all its keys to free slots. Only the
+ * seeds and the slots are kept, so a lookup hashes the key once, mixes the hash with the seed of its bucket to get
+ * its slot, and compares the key stored there to reject strings that are not in the map. There is no probing and no
+ * collision chain, whatever the key.
+ *
+ * The builder is consteval: an empty key, a duplicate key or a key set it cannot place fails the compilation.
+ * Half of the slots are left free to keep the seed search short.
+ *
+ * @tparam Value The mapped type, must be usable in constant expressions.
+ * @tparam N The number of keys.
+ *
+ * @multithreading Thread-safe, the map is immutable.
+ */
+template <typename Value, size_t N>
+class PerfectHashMap final {
+    static_assert(N > 0, "PerfectHashMap needs at least one key!");
+
+   public:
+    using Entry = std::pair<std::string_view, Value>;
+    using value_type = Entry;
+    using size_type = size_t;
+    using const_iterator = const Entry *;
+
+   private:
+    static constexpr size_t c_slotCount = std::bit_ceil(N) * 2;
+    static constexpr size_t c_bucketCount = std::max<size_t>(std::bit_ceil(N) / 2, 1);
+    static constexpr uint32_t c_emptySlot = static_cast<uint32_t>(N);
+    static constexpr uint32_t c_maxSeed = 1 << 16;
+
+    std::array<Entry, N> m_entries;
+    std::array<uint32_t, c_bucketCount> m_seeds = {};
+    std::array<uint32_t, c_slotCount> m_slots = {};
+
+   public:
+    /**
+     * @brief Builds the table of a key set.
+     *
+     * @param _entries The keys and their values, iteration follows their order.
+     * @throw std::invalid_argument If a key is empty or present twice, as a compilation error.
+     * @throw std::length_error If no seed places the keys of a bucket, as a compilation error.
+     */
+    consteval explicit PerfectHashMap(const Entry (&_entries)[N]);
+
+   public:
+    /**
+     * @brief Looks up a key with one hash and one key comparison.
+     *
+     * @return const Value* A pointer to the value, or nullptr if the key is not in the map.
+     */
+    NODISCARD constexpr const Value *Find(std::string_view _key) const noexcept {
+        const uint64_t hash = FNV1aHash<uint64_t>(_key);
+        const uint32_t index = m_slots[GetSlot(hash, m_seeds[GetBucket(hash)])];
+
+        return index != c_emptySlot && m_entries[index].first == _key ? &m_entries[index].second : nullptr;
+    }
+
+    NODISCARD constexpr bool Contains(std::string_view _key) const noexcept { return Find(_key) != nullptr; }
+
+    /**
+     * @brief Looks up a key.
+     *
+     * @throw std::out_of_range If the key is not in the map.
+     */
+    NODISCARD constexpr const Value &At(std::string_view _key) const {
+        const Value *value = Find(_key);
+
+        if (value == nullptr) throw std::out_of_range("PerfectHashMap key not found");
+
+        return *value;
+    }
+
+    NODISCARD constexpr const_iterator begin() const noexcept { return m_entries.data(); }
+    NODISCARD constexpr const_iterator end() const noexcept { return m_entries.data() + N; }
+
+    NODISCARD constexpr size_t size() const noexcept { return N; }
+    NODISCARD constexpr bool empty() const noexcept { return false; }
+
+   private:
+    NODISCARD static constexpr size_t GetBucket(uint64_t _hash) noexcept {
+        return static_cast<size_t>(_hash >> 32) & (c_bucketCount - 1);
+    }
+
+    /**
+     * @brief Mixes a hash with a bucket seed, the high bits of the product depend on every bit of both.
+     */
+    NODISCARD static constexpr size_t GetSlot(uint64_t _hash, uint32_t _seed) noexcept {
+        const uint64_t mixed = (_hash ^ _seed) * 0x9e3779b97f4a7c15ull;
+
+        return static_cast<size_t>(mixed >> 40) & (c_slotCount - 1);
+    }
+};
+
+template <typename Value, size_t N>
+consteval PerfectHashMap<Value, N>::PerfectHashMap(const Entry (&_entries)[N]) : m_entries(std::to_array(_entries)) {
+    std::array<uint64_t, N> hashes = {};
+    std::array<uint32_t, N> order = {};
+    std::array<uint32_t, c_bucketCount> bucketSizes = {};
+
+    for (size_t i = 0; i < N; ++i) {
+        if (m_entries[i].first.empty()) throw std::invalid_argument("PerfectHashMap keys must not be empty");
+
+        hashes[i] = FNV1aHash<uint64_t>(m_entries[i].first);
+        order[i] = static_cast<uint32_t>(i);
+        bucketSizes[GetBucket(hashes[i])]++;
+    }
+
+    // Large buckets are the hardest to place, they go first while most slots are still free.
+    std::sort(order.begin(), order.end(), [&](uint32_t _lhs, uint32_t _rhs) {
+        const size_t lhsBucket = GetBucket(hashes[_lhs]), rhsBucket = GetBucket(hashes[_rhs]);
+
+        if (bucketSizes[lhsBucket] != bucketSizes[rhsBucket]) return bucketSizes[lhsBucket] > bucketSizes[rhsBucket];
+
+        return lhsBucket < rhsBucket;
+    });
+
+    m_slots.fill(c_emptySlot);
+
+    for (size_t first = 0; first < N;) {
+        const size_t bucket = GetBucket(hashes[order[first]]);
+        const size_t last = first + bucketSizes[bucket];
+
+        // Equal hashes would land in the same slot for every seed.
+        for (size_t i = first; i < last; ++i) {
+            for (size_t j = first; j < i; ++j) {
+                if (hashes[order[i]] == hashes[order[j]]) {
+                    throw std::invalid_argument("PerfectHashMap keys must be unique");
+                }
+            }
+        }
+
+        for (uint32_t seed = 0;; ++seed) {
+            if (seed == c_maxSeed) throw std::length_error("PerfectHashMap failed to place its keys");
+
+            size_t placed = first;
+
+            while (placed < last && m_slots[GetSlot(hashes[order[placed]], seed)] == c_emptySlot) {
+                m_slots[GetSlot(hashes[order[placed]], seed)] = order[placed];
+                placed++;
+            }
+
+            if (placed == last) {
+                m_seeds[bucket] = seed;
+                break;
+            }
+
+            while (placed > first) {
+                placed--;
+                m_slots[GetSlot(hashes[order[placed]], seed)] = c_emptySlot;
+            }
+        }
+
+        first = last;
+    }
+}
+
+/**
+ * @brief Builds a PerfectHashMap at compile time, deducing the number of keys.
+ *
+ * @code
+ * constexpr auto c_colors = MakePerfectHashMap<Color>({{"red", Color::red}, {"green", Color::green}});
+ * @endcode
+ */
+template <typename Value, size_t N>
+consteval PerfectHashMap<Value, N> MakePerfectHashMap(const std::pair<std::string_view, Value> (&_entries)[N]) {
+    return PerfectHashMap<Value, N>(_entries);
+}
+
+}  // namespace Rake::libraries
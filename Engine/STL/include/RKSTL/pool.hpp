@@ -1,18 +1,52 @@
 #pragma once
 
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <functional>
 #include <algorithm>
 #include <execution>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 #include "defines.hpp"
+#include "virtual_memory.hpp"
+#include "memory_tracker.hpp"
 
 namespace Rake::libraries {
 
-template <typename T>
-concept DefaultConstructible = std::is_default_constructible_v<T>;
+/**
+ * @brief Snapshot of the MemoryPool thread caches activity.
+ *
+ * @note The cached counters are published by each thread when its cache refills or flushes, a thread that never
+ * reaches the slow path again keeps its latest operations private.
+ */
+struct MemoryPoolStatistics {
+    size_t cachedAllocations = 0;   /**< Allocations served from a thread cache. */
+    size_t cachedDeallocations = 0; /**< Deallocations returned to a thread cache. */
+    size_t refills = 0;             /**< Batches moved from the shared free offsets stack to a thread cache. */
+    size_t flushes = 0;             /**< Batches moved from a thread cache back to the shared free offsets stack. */
+    size_t reclaims = 0;            /**< Free offsets stack rebuilds triggered to recover offsets stranded in caches. */
+    size_t lockAcquisitions = 0;    /**< Exclusive lock acquisitions performed by allocations and deallocations. */
+    size_t lockContentions = 0;     /**< Exclusive lock acquisitions that had to wait for another thread. */
+    size_t pageAllocations = 0;     /**< Pages appended or commits grown by a pool that ran out of free offsets. */
+};
+
+/**
+ * @brief Storage layouts supported by the MemoryPool.
+ */
+enum class PoolLayout : uint8_t {
+    contiguous, /**< A single block, Reserve reallocates it and moves every element. */
+    segmented,  /**< Fixed-size pages appended on demand, elements never move when the pool grows. */
+    reserved    /**< A single block in reserved address space, committed on demand and grown or shrunk in place. */
+};
 
 /**
  * @brief A memory pool template class for managing memory allocation and deallocation.
@@ -20,25 +54,227 @@ concept DefaultConstructible = std::is_default_constructible_v<T>;
  * This container provides iterators pointing to the first and last elements of the MemoryPool,
  * making it compatible with standard library algorithms that operate on iterators.
  *
+ * Storage is raw memory aligned for T: elements are constructed when they are allocated and destroyed when they are
+ * deallocated, so reserving a large pool costs neither constructors nor a memset and untouched pages are never
+ * written. An offset whose constructor throws is released before the exception propagates, so it is never reported
+ * live nor destroyed. Moves between offsets (Reserve, Reallocate, Compact) move-construct into the destination and
+ * destroy the source, trivially copyable types are relocated with memcpy.
+ *
+ * Free offsets are kept in a LIFO stack paired with a reverse index (offset -> stack position), so finding a free
+ * offset, releasing one and claiming a specific one are all O(1) regardless of how fragmented the pool is.
+ *
+ * Occupancy is tracked one bit per offset in 64-bit words, so scans over the pool (rebuilding the free offsets stack,
+ * compacting, counting and visiting live elements) skip 64 offsets at a time using count-trailing-zeros and popcount.
+ *
+ * In the segmented layout the storage is split in fixed-size pages listed by a page directory. When no free offset is
+ * left a new page is appended instead of throwing, so growth costs one page allocation, never copies the elements
+ * already stored and never invalidates the pointers handed out. The directory lists its pages in blocks of doubling
+ * size that never move, so lock-free readers keep resolving offsets while another thread grows the pool. Pointers
+ * are mapped back to offsets through an index of the pages sorted by address, an appended page is inserted into a
+ * copy of it and the previous copy is deleted as soon as the readers that may still hold it are done.
+ *
+ * In the reserved layout the storage is a single block carved out of a virtual address range reserved up front (see
+ * VirtualReservation). Only the prefix covering the capacity is committed, running out of free offsets commits more
+ * of the range and Reserve commits or decommits its tail, so the pool grows in place like a segmented one while
+ * keeping the single-block addressing of a contiguous one. Large reservations ask for transparent huge pages.
+ *
+ * Elements can also be allocated through generational handles. A handle names an entry of an indirection table that
+ * stores the element offset and a generation bumped every time the entry is released, so resolving it is O(1) and a
+ * stale handle resolves to nullptr instead of aliasing the element that reused the offset. Compact and Reallocate
+ * update the table when they move elements, which makes defragmenting a long-lived pool safe for handle owners.
+ *
+ * Offsets at or above a watermark are implicitly free whatever their occupancy bits say. Allocation hands out the
+ * offsets below the watermark first and raises it a batch at a time, clearing each occupancy word as it enters it.
+ * Clear and Compact only have to reset the watermark, bump the pool epoch (which invalidates the thread caches) and
+ * drop the handle table, so clearing a pool of trivially destructible elements is O(1) whatever its capacity. The
+ * per-offset bookkeeping (free offsets stack, reverse index and handle bindings) only covers the offsets below the
+ * highest watermark reached, a large reservation costs none of it until its offsets are handed out.
+ *
+ * Allocate, Construct and Deallocate go through a per-thread cache (magazine) of free offsets and only take the
+ * exclusive lock to move a whole batch of offsets between the cache and the shared stack. An offset becomes live
+ * only when its occupancy bit is atomically claimed, so an offset sitting in a stale or foreign cache can never be
+ * handed out twice. Each thread has a few cache slots shared by the pools of the same element type, a pool taking
+ * over a slot or a thread exiting returns the cached offsets to the pool that owns them.
+ *
  * @tparam T The type of elements to be stored in the memory pool.
  *
- * @multithreading Inheritly thread-safe.
+ * @multithreading Allocate, AllocateAt, Construct, ConstructAt, AllocateHandle, ConstructHandle, Deallocate,
+ * DeallocateHandle, Resolve, operator[] and the size and statistics queries may run concurrently with each other.
+ * Map and ForEachLive may run concurrently with each other and with Resolve and operator[], but not with the
+ * operations that construct or destroy elements: an offset is claimed before its element is constructed and only
+ * released after it is destroyed, so a concurrent visit could reach an unconstructed or destroyed element. Reserve,
+ * Reallocate, Compact, Clear and the copy and move operations move or reset elements and must not run concurrently
+ * with any other operation on the same pool.
  */
-template <DefaultConstructible T>
+template <typename T>
 class MemoryPool final : public NonCopyable {
    private:
-    T *m_pool;
-    bool *m_inUse;
-    size_t m_size, m_capacity;
+    static constexpr size_t c_wordBits = 64;
+    static constexpr size_t c_defaultPageSize = 1024;
+    static constexpr size_t c_defaultReservation = RK_GIBIBYTES(size_t(4));
+    static constexpr size_t c_hugePageThreshold = RK_MEBIBYTES(size_t(64));
+    static constexpr size_t c_invalidOffset = std::numeric_limits<size_t>::max();
+    static constexpr uint32_t c_invalidHandle = std::numeric_limits<uint32_t>::max();
+    static constexpr size_t c_cacheLineSize = 64;
+
+   public:
+    /**
+     * @brief Generational reference to an element that stays valid across Compact and Reallocate.
+     */
+    struct Handle {
+        uint32_t index = c_invalidHandle; /**< Entry of the pool indirection table. */
+        uint32_t generation = 0;          /**< Generation of the entry when the handle was issued. */
+
+        NODISCARD inline bool IsNull() const noexcept { return index == c_invalidHandle; }
+
+        bool operator==(const Handle &_other) const noexcept = default;
+    };
+
+   private:
+    struct HandleEntry {
+        size_t offset = c_invalidOffset; /**< Offset of the element, or the next free entry once released. */
+        uint32_t generation = 0;
+    };
+
+    static constexpr size_t c_threadCacheSize = 64;
+    static constexpr size_t c_threadCacheSlots = 8;
+
+    /**
+     * @brief Link from the thread caches to their pool, unbound when the pool is destroyed.
+     */
+    struct CacheOwner {
+        std::mutex mutex;
+        MemoryPool *pool;
+
+        explicit CacheOwner(MemoryPool *_pool) : pool(_pool) {}
+    };
+
+    struct ThreadCache {
+        uint64_t poolId = 0;
+        uint32_t epoch = 0;
+        size_t count = 0;
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        ptrdiff_t sizeDelta = 0; /**< Elements constructed minus destroyed through the cache, not yet in m_size. */
+        std::weak_ptr<CacheOwner> owner;
+        size_t offsets[c_threadCacheSize];
+
+        ~ThreadCache() { ReturnThreadCache(*this); }
+    };
+
+    struct Page {
+        T *data = nullptr;
+        std::atomic<uint64_t> *occupancy = nullptr;
+    };
+
+    static constexpr size_t c_pageBlockCount = std::numeric_limits<size_t>::digits;
+
+    /**
+     * @brief Gets the block of the page directory that lists a page, block k lists 2^k pages.
+     */
+    NODISCARD static inline size_t GetPageBlock(size_t _page) noexcept {
+        return c_pageBlockCount - 1 - std::countl_zero((_page + 1) | 1);
+    }
+
+    /**
+     * @brief Pages sorted by address, binary searched to map a pointer back to its offset.
+     */
+    struct AddressIndex {
+        size_t count = 0;
+        size_t *pages = nullptr;
+
+        explicit AddressIndex(size_t _count) : count(_count), pages(new size_t[_count]) {}
+
+        ~AddressIndex() { delete[] pages; }
+    };
+
+    /**
+     * @brief Page table of a pool, its blocks never move once allocated so lock-free readers never see it retired.
+     */
+    struct PageDirectory {
+        std::atomic<Page *> blocks[c_pageBlockCount] = {};
+        size_t count = 0;
+        std::atomic<AddressIndex *> addressIndex = new AddressIndex(0);
+        std::atomic<size_t> readers[2] = {};
+        std::atomic<size_t> readerEpoch = 0;
+
+        ~PageDirectory() {
+            for (std::atomic<Page *> &block : blocks) delete[] block.load(std::memory_order_relaxed);
+
+            delete addressIndex.load(std::memory_order_relaxed);
+        }
+
+        NODISCARD inline Page &GetPage(size_t _page) const noexcept {
+            const size_t block = GetPageBlock(_page);
+
+            return blocks[block].load(std::memory_order_acquire)[_page + 1 - (size_t(1) << block)];
+        }
+
+        /**
+         * @brief Gets the entry of a page, allocating the block that lists it on first use.
+         */
+        NODISCARD inline Page &EmplacePage(size_t _page) {
+            const size_t block = GetPageBlock(_page);
+
+            if (!blocks[block].load(std::memory_order_relaxed))
+                blocks[block].store(new Page[size_t(1) << block](), std::memory_order_release);
+
+            return GetPage(_page);
+        }
+    };
+
+    struct Statistics {
+        std::atomic<size_t> cachedAllocations = 0;
+        std::atomic<size_t> cachedDeallocations = 0;
+        std::atomic<size_t> refills = 0;
+        std::atomic<size_t> flushes = 0;
+        std::atomic<size_t> reclaims = 0;
+        std::atomic<size_t> lockAcquisitions = 0;
+        std::atomic<size_t> lockContentions = 0;
+        std::atomic<size_t> pageAllocations = 0;
+    };
+
+    static inline std::atomic<uint64_t> s_nextPoolId = 1;
+
+    uint64_t m_id = s_nextPoolId.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<CacheOwner> m_owner = std::make_shared<CacheOwner>(this);
+    PoolLayout m_layout = PoolLayout::contiguous;
+    MemoryTag m_tag = MemoryTracker::GetCurrentTag();
+    size_t m_pageShift = std::numeric_limits<size_t>::digits - 1;
+    size_t m_pageMask = std::numeric_limits<size_t>::max();
+    std::atomic<PageDirectory *> m_directory = nullptr;
+    VirtualReservation m_reservation;
+    VirtualReservation m_occupancyReservation;
+    std::vector<size_t> m_freeSlots;
+    std::vector<size_t> m_freeSlotPositions;
+    std::atomic<size_t> m_capacity = 0;
+    std::atomic<size_t> m_watermark = 0;
+    std::atomic<uint32_t> m_epoch = 0;
+    std::vector<HandleEntry> m_handleEntries;
+    std::vector<uint32_t> m_slotHandles;
+    uint32_t m_handleCount = 0;
+    uint32_t m_freeHandle = c_invalidHandle;
+
+    // Written by the lock holder on refills and flushes, kept off the line of the capacity and watermark that every
+    // cached allocation and deallocation reads.
+    alignas(c_cacheLineSize) std::atomic<ptrdiff_t> m_size = 0;
+    size_t m_freeCount = 0;
     std::shared_mutex m_mutex;
+    Statistics m_statistics;
 
    public:
     /**
      * @brief Constructs a MemoryPool with the specified capacity.
      *
      * @param _capacity The initial capacity of the memory pool.
+     * @param _layout The storage layout, segmented pools grow by whole pages when they run out of free offsets.
+     * @param _pageSize The number of elements per page in the segmented layout, rounded up to a power of two of at
+     * least 64.
+     * @param _maxCapacity The number of elements the reserved layout reserves address space for, 0 reserves
+     * c_defaultReservation bytes.
      */
-    MemoryPool(size_t _capacity);
+    MemoryPool(size_t _capacity, PoolLayout _layout = PoolLayout::contiguous, size_t _pageSize = c_defaultPageSize,
+               size_t _maxCapacity = 0);
 
     /**
      * @brief Destructor for cleaning up memory pool resources.
@@ -67,11 +303,13 @@ class MemoryPool final : public NonCopyable {
 
    public:
     /**
-     * @brief Copies an object of type T to the memory pool to the first available free offset.
+     * @brief Copies an object of type T to the memory pool to a free offset.
+     *
+     * @note Offsets are recycled in LIFO order through the calling thread cache.
      *
      * @param _data The data to be stored in the allocated memory.
      * @return T* A pointer to the copied object.
-     * @throws std::runtime_error if no free offsets are available.
+     * @throws std::runtime_error if no free offsets are available in a contiguous pool.
      */
     T *Allocate(const T &_data);
 
@@ -86,12 +324,14 @@ class MemoryPool final : public NonCopyable {
     T *AllocateAt(const T &_data, size_t _offset);
 
     /**
-     * @brief Constructs an object of type T using the provided arguments at the first available free offset.
+     * @brief Constructs an object of type T using the provided arguments at a free offset.
+     *
+     * @note Offsets are recycled in LIFO order through the calling thread cache.
      *
      * @tparam Args The types of the arguments to be forwarded to the constructor.
      * @param _args The arguments to be forwarded to the constructor of type T.
      * @return A pointer to the newly constructed object in the memory pool.
-     * @throws std::runtime_error if no free offset are available.
+     * @throws std::runtime_error if no free offsets are available in a contiguous pool.
      */
     template <typename... Args>
     T *Construct(Args &&..._args);
@@ -115,30 +355,82 @@ class MemoryPool final : public NonCopyable {
      */
     void Deallocate(T *_ptr) noexcept;
 
+    /**
+     * @brief Constructs an object of type T at a free offset and returns a generational handle to it.
+     *
+     * @note Elements allocated through handles must be released with DeallocateHandle, not with Deallocate.
+     *
+     * @tparam Args The types of the arguments to be forwarded to the constructor.
+     * @param _args The arguments to be forwarded to the constructor of type T.
+     * @return Handle A handle resolving to the newly constructed object.
+     * @throws std::runtime_error if no free offsets are available in a contiguous pool.
+     */
+    template <typename... Args>
+    Handle ConstructHandle(Args &&..._args);
+
+    /**
+     * @brief Copies an object of type T to a free offset and returns a generational handle to it.
+     *
+     * @param _data The data to be stored in the allocated memory.
+     * @return Handle A handle resolving to the copied object.
+     * @throws std::runtime_error if no free offsets are available in a contiguous pool.
+     */
+    Handle AllocateHandle(const T &_data);
+
+    /**
+     * @brief Releases the element referenced by a handle, stale or null handles are ignored.
+     *
+     * @param _handle The handle to release, every copy of it resolves to nullptr afterwards.
+     */
+    void DeallocateHandle(Handle _handle) noexcept;
+
+    /**
+     * @brief Resolves a handle to the element it references in O(1).
+     *
+     * @param _handle The handle to resolve.
+     * @return T* A pointer to the element or nullptr if the handle is null or stale.
+     */
+    NODISCARD T *Resolve(Handle _handle) noexcept;
+
     /**
      * @brief Reallocates data from one offset to another within the memory pool.
      *
+     * @note Handles to the moved element are updated and keep resolving to it.
+     *
      * @param _srcOffset The source offset from which to move data.
      * @param _dstOffset The destination offset to which to move data.
      * @return T* A pointer to the reallocated memory.
+     *
+     * @throw std::out_of_range If an offset is out of range.
+     * @throw std::runtime_error If the source is free or the destination is already in use.
      */
-    T *Reallocate(size_t _srcOffset, size_t _dstOffset) noexcept;
+    T *Reallocate(size_t _srcOffset, size_t _dstOffset);
 
     /**
      * @brief Shrinks or enlarges the memory pool buffer by hot swapping it with a new one.
+     *
+     * @note Segmented pools round the capacity up to whole pages and only allocate or release the trailing pages, the
+     * elements in the pages that are kept do not move. Reserved pools commit or decommit the tail of their address
+     * range in place.
+     *
      * @param _capacity The new capacity of the buffer.
      *
-     * @throw std::bad_alloc if the capacity exceeds size_t numeric limits.
+     * @throw std::bad_alloc if the capacity exceeds size_t numeric limits or the address range of a reserved pool.
      */
     void Reserve(size_t _capacity);
 
     /**
      * @brief Compacts the memory pool by moving allocated data to contiguous positions.
+     *
+     * @note Handles are updated to the new offsets, raw pointers to the moved elements are invalidated.
      */
     void Compact() noexcept;
 
     /**
-     * @brief Clears the memory pool by zeroing the entre memory block but keeps capacity the same.
+     * @brief Clears the memory pool by destroying every live element but keeps capacity the same.
+     *
+     * @note O(1) for trivially destructible types, other types pay one scan of the occupancy words to run the
+     * destructors. Every handle issued so far becomes stale.
      */
     void Clear() noexcept;
 
@@ -149,7 +441,8 @@ class MemoryPool final : public NonCopyable {
      * The function must take a reference to an element of type T as its argument.
      *
      * @note The function should not modify the size or capacity of the MemoryPool or change the elements offsets.
-     * @note This function is the only thread-safe way to iterate over and modify the values in the MemoryPool container.
+     * @note The function may run on several elements at once, but the visit must not overlap allocations or
+     * deallocations on the same pool.
      *
      * @tparam ExPo The execution policy to control how the function is parallelized.
      * @param _policy An execution policy object that specifies the parallelism strategy.
@@ -158,286 +451,1455 @@ class MemoryPool final : public NonCopyable {
     template <class ExPo>
     void Map(ExPo &&_policy, std::function<void(T &)> &&_function);
 
-   public:
     /**
-     * @brief Accesses an element in the memory pool by its offset.
+     * @brief Calls a function on every live element in offset order, skipping free offsets a word at a time.
      *
-     * @param _offset The offset of the element to access.
-     * @return T& A reference to the accessed element.
-     * @throw std::out_of_range if the index is out of range.
+     * @note The function should not allocate from or deallocate to the MemoryPool, nor should other threads while the
+     * visit runs.
+     *
+     * @tparam Function A callable taking a reference to an element of type T.
+     * @param _function The function to be applied to each live element.
      */
-    NODISCARD inline T &operator[](size_t _offset) {
-        std::shared_lock<std::shared_mutex> readLock(m_mutex);
+    template <typename Function>
+    void ForEachLive(Function &&_function);
 
-        if (_offset < m_capacity)
-            return m_pool[_offset];
-        else
-            throw std::out_of_range("Index out of range!");
-    };
+   private:
+    /**
+     * @brief Gets the number of elements stored in each page.
+     */
+    NODISCARD inline size_t GetPageCapacity() const noexcept {
+        return m_layout == PoolLayout::segmented ? m_pageMask + 1 : m_capacity.load(std::memory_order_relaxed);
+    }
 
     /**
-     * @brief Gets the total size of the memory pool in bytes.
-     *
-     * @return size_t The total size of the memory pool.
+     * @brief Resolves a page index to its entry in the page directory.
      */
-    NODISCARD inline size_t GetPoolSize() const noexcept { return m_capacity * sizeof(T); };
+    NODISCARD inline Page &GetPage(size_t _page) const noexcept {
+        return m_directory.load(std::memory_order_acquire)->GetPage(_page);
+    }
 
     /**
-     * @brief Gets the amount of free memory in the memory pool in bytes.
-     *
-     * @return size_t The amount of free memory.
+     * @brief Resolves an offset to its element through the page directory.
      */
-    NODISCARD inline size_t GetFreeMemory() const noexcept { return GetPoolSize() - (m_size * sizeof(T)); };
+    NODISCARD inline T &GetSlot(size_t _offset) const noexcept {
+        return GetPage(_offset >> m_pageShift).data[_offset & m_pageMask];
+    }
 
     /**
-     * @brief Gets the current number of allocated offsets in the memory pool.
-     *
-     * @return size_t The number of allocated offsets.
+     * @brief Resolves an occupancy word index to the word stored in the page that owns it.
      */
-    NODISCARD inline size_t size() const noexcept { return m_size; };
+    NODISCARD inline std::atomic<uint64_t> &GetOccupancyWord(size_t _word) const noexcept {
+        const size_t offset = _word * c_wordBits;
+
+        return GetPage(offset >> m_pageShift).occupancy[(offset & m_pageMask) / c_wordBits];
+    }
 
     /**
-     * @brief Gets the number of available offsets in the memory pool.
+     * @brief Finds the offset of an element by binary searching the pages sorted by address.
      *
-     * @return size_t The number of available offsets.
+     * @return size_t The offset of the element or c_invalidOffset if the pointer does not belong to the pool.
      */
-    NODISCARD inline size_t capacity() const noexcept { return m_capacity; };
-};
+    NODISCARD size_t GetOffset(const T *_ptr) const noexcept;
 
-template <DefaultConstructible T>
-MemoryPool<T>::MemoryPool(size_t _capacity) : m_capacity(_capacity), m_size(0) {
-    m_pool = new T[m_capacity];
-    std::memset(m_pool, NULL, sizeof(T) * m_capacity);
-    m_inUse = new bool[m_capacity];
-    std::memset(m_inUse, false, sizeof(bool) * m_capacity);
-};
+    /**
+     * @brief Allocates the uninitialized storage of a page and its cleared occupancy words.
+     */
+    NODISCARD Page AllocatePage(size_t _pageCapacity);
 
-template <DefaultConstructible T>
-MemoryPool<T>::~MemoryPool() {
-    delete[] (m_pool);
-    delete[] (m_inUse);
-}
+    /**
+     * @brief Frees the storage of a page whose elements have already been destroyed.
+     */
+    void FreePage(const Page &_page, size_t _pageCapacity) noexcept;
 
-template <DefaultConstructible T>
-MemoryPool<T> &MemoryPool<T>::operator=(MemoryPool &&_other) noexcept {
-    if (this == &_other) return *this;
+    /**
+     * @brief Gets the number of bytes backing a page, occupancy words included.
+     */
+    NODISCARD static constexpr size_t GetPageBytes(size_t _pageCapacity) noexcept {
+        return _pageCapacity * sizeof(T) + GetWordCount(_pageCapacity) * sizeof(std::atomic<uint64_t>);
+    }
 
-    m_capacity = _other.m_capacity;
-    m_size = _other.m_size;
-    _other.m_capacity = 0;
-    _other.m_size = 0;
+    /**
+     * @brief Destroys the live elements in a range of offsets, clearing their bits and releasing their handles.
+     */
+    void DestroyElements(size_t _firstOffset, size_t _lastOffset) noexcept;
 
-    delete[] m_inUse;
-    delete[] m_pool;
+    /**
+     * @brief Raises the watermark, clearing the stale occupancy bits it uncovers and queueing the new free offsets.
+     *
+     * @throw std::bad_alloc If the bookkeeping of the new offsets cannot be allocated.
+     */
+    void AdvanceWatermark(size_t _watermark);
 
-    std::swap(m_inUse, _other.m_inUse);
-    std::swap(m_pool, _other.m_pool);
+    /**
+     * @brief Moves an element to an unconstructed offset and destroys the source.
+     */
+    inline void RelocateElement(size_t _srcOffset, size_t _dstOffset) noexcept {
+        T &source = GetSlot(_srcOffset);
 
-    return *this;
-}
+        new (&GetSlot(_dstOffset)) T(std::move(source));
+        std::destroy_at(&source);
+    }
 
-template <DefaultConstructible T>
-MemoryPool<T>::MemoryPool(MemoryPool<T> &&_other) noexcept : m_capacity(_other.m_capacity), m_size(_other.m_size) {
-    _other.m_capacity = 0;
-    _other.m_size = 0;
+    /**
+     * @brief Allocates or releases the trailing pages of a segmented pool so that it lists the given number of pages.
+     *
+     * @note Releasing pages only happens in Reserve, which runs with no concurrent readers.
+     */
+    void ResizeDirectory(size_t _pageCount);
 
-    delete[] m_inUse;
-    delete[] m_pool;
+    /**
+     * @brief Publishes an address index with a page inserted at its address rank.
+     */
+    void InsertAddressIndex(size_t _page);
 
-    std::swap(m_inUse, _other.m_inUse);
-    std::swap(m_pool, _other.m_pool);
-}
+    /**
+     * @brief Publishes an address index sorting every page listed by the directory.
+     */
+    void RebuildAddressIndex();
 
-template <DefaultConstructible T>
-MemoryPool<T> &MemoryPool<T>::operator=(const MemoryPool<T> &_other) noexcept {
-    if (this == &_other) return *this;
+    /**
+     * @brief Replaces the address index and deletes the previous one once no reader can still hold it.
+     *
+     * @note Waits for the readers of both reader epochs, readers only hold the index for one binary search.
+     */
+    void PublishAddressIndex(AddressIndex *_index) noexcept;
 
-    delete[] m_inUse;
-    delete[] m_pool;
+    /**
+     * @brief Appends a page to a segmented pool, its offsets sit above the watermark and are handed out from there.
+     */
+    void AppendPage();
 
-    m_capacity = _other.m_capacity;
-    m_size = _other.m_size;
-    m_inUse = new bool[m_capacity];
-    m_pool = new T[m_capacity];
+    /**
+     * @brief Reserves the address space of a reserved pool and returns its single page, nothing is committed yet.
+     */
+    NODISCARD Page ReserveAddressSpace(size_t _maxCapacity);
 
-    std::memcpy(m_inUse, _other.m_inUse, m_capacity * sizeof(bool));
-    std::memcpy(m_pool, _other.m_pool, m_capacity * sizeof(T));
+    /**
+     * @brief Gets the number of elements the address range of a reserved pool can hold.
+     */
+    NODISCARD inline size_t GetReservedCapacity() const noexcept { return m_reservation.GetReservedSize() / sizeof(T); }
 
-    return *this;
-}
+    /**
+     * @brief Gets the number of bytes committed by a reserved pool, occupancy words included.
+     */
+    NODISCARD inline size_t GetCommittedBytes() const noexcept {
+        return m_reservation.GetCommittedSize() + m_occupancyReservation.GetCommittedSize();
+    }
 
-template <DefaultConstructible T>
-MemoryPool<T>::MemoryPool(const MemoryPool<T> &_other) noexcept
-    : m_capacity(_other.m_capacity),
-      m_size(_other.m_size),
-      m_pool(new T[_other.m_capacity]),
-      m_inUse(new bool[_other.m_capacity]) {
-    std::memcpy(m_inUse, _other.m_inUse, m_capacity * sizeof(bool));
-    std::memcpy(m_pool, _other.m_pool, m_capacity * sizeof(T));
-}
+    /**
+     * @brief Commits or decommits the tail of a reserved pool so that it holds exactly the given capacity.
+     *
+     * @note Elements past a lowered capacity are destroyed, the ones that are kept never move.
+     */
+    void ResizeReservation(size_t _capacity);
 
-template <DefaultConstructible T>
-T *MemoryPool<T>::Allocate(const T &_data) {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+    /**
+     * @brief Deletes every page and page directory.
+     */
+    void ReleasePages() noexcept;
 
-    if (m_size >= m_capacity) throw std::runtime_error("No free offsets available in the memory pool.");
+    /**
+     * @brief Deep copies the pages, occupancy, handles and layout of another pool into this empty one.
+     */
+    void CopyPages(const MemoryPool &_other);
 
-    for (size_t i = 0; i < m_capacity; ++i) {
-        if (m_inUse[i]) continue;
+    /**
+     * @brief Resizes the per-offset bookkeeping to cover the offsets below a watermark.
+     */
+    void ResizeBookkeeping(size_t _watermark);
 
-        m_inUse[i] = true;
-        m_pool[i] = _data;
-        m_size++;
+    /**
+     * @brief Binds a new handle table entry to a live offset.
+     */
+    Handle RegisterHandle(size_t _offset);
 
-        return &m_pool[i];
-    }
-}
+    /**
+     * @brief Bumps the generation of a handle table entry and pushes it on the free entries list.
+     */
+    void ReleaseHandleEntry(uint32_t _index) noexcept;
 
-template <DefaultConstructible T>
-T *MemoryPool<T>::AllocateAt(const T &_data, size_t _offset) {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+    /**
+     * @brief Moves the handle bound to an offset, if any, to another offset.
+     */
+    inline void RelocateHandle(size_t _srcOffset, size_t _dstOffset) noexcept {
+        const uint32_t index = m_slotHandles[_srcOffset];
 
-    if (_offset >= m_capacity)
-        throw std::out_of_range("Offset out of range!");
-    else if (m_size >= m_capacity)
-        throw std::runtime_error("No free offsets available in the memory pool.");
-    else if (m_inUse[_offset])
-        throw std::runtime_error("Memory at index " + std::to_string(_offset) + " already in use!");
+        if (index != c_invalidHandle) m_handleEntries[index].offset = _dstOffset;
 
-    m_inUse[_offset] = true;
-    m_pool[_offset] = _data;
-    m_size++;
+        m_slotHandles[_dstOffset] = index;
+        m_slotHandles[_srcOffset] = c_invalidHandle;
+    }
 
-    return &m_pool[_offset];
-}
+    /**
+     * @brief Gets the number of occupancy words needed to track a given capacity.
+     */
+    NODISCARD static inline size_t GetWordCount(size_t _capacity) noexcept {
+        return (_capacity + c_wordBits - 1) / c_wordBits;
+    }
 
-template <DefaultConstructible T>
-template <typename... Args>
-T *MemoryPool<T>::Construct(Args &&..._args) {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+    /**
+     * @brief Gets the mask of the offsets tracked by an occupancy word that lie below the watermark.
+     */
+    NODISCARD inline uint64_t GetIssuedMask(size_t _word) const noexcept {
+        const size_t watermark = m_watermark.load(std::memory_order_relaxed);
+        const size_t first = _word * c_wordBits;
 
-    if (m_size >= m_capacity) throw std::runtime_error("No free offsets available in the memory pool.");
+        if (first >= watermark) return 0;
 
-    for (size_t i = 0; i < m_capacity; ++i) {
-        if (m_inUse[i]) continue;
+        return watermark - first >= c_wordBits ? ~uint64_t(0) : (uint64_t(1) << (watermark - first)) - 1;
+    }
 
-        m_inUse[i] = true;
-        new (&m_pool[i]) T(std::forward<Args>(_args)...);
-        m_size++;
+    /**
+     * @brief Loads an occupancy word, ignoring the stale bits left above the watermark.
+     */
+    NODISCARD inline uint64_t LoadOccupancyWord(size_t _word, std::memory_order _order) const noexcept {
+        const uint64_t issued = GetIssuedMask(_word);
 
-        return &m_pool[i];
+        return issued ? GetOccupancyWord(_word).load(_order) & issued : 0;
     }
-}
 
-template <DefaultConstructible T>
-template <typename... Args>
-T *MemoryPool<T>::ConstructAt(size_t _offset, Args &&..._args) {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-
-    if (_offset >= m_capacity)
-        throw std::out_of_range("Offset out of range!");
-    else if (m_size >= m_capacity)
-        throw std::runtime_error("No free offsets available in the memory pool.");
-    else if (m_inUse[_offset])
-        throw std::runtime_error("Memory at index " + std::to_string(_offset) + " already in use!");
+    /**
+     * @brief Checks whether an offset holds a live element.
+     */
+    NODISCARD inline bool IsSlotInUse(size_t _offset) const noexcept {
+        const uint64_t bit = uint64_t(1) << (_offset % c_wordBits);
 
-    m_inUse[_offset] = true;
-    new (&m_pool[_offset]) T(std::forward<Args>(_args)...);
-    m_size++;
+        return LoadOccupancyWord(_offset / c_wordBits, std::memory_order_relaxed) & bit;
+    }
 
-    return &m_pool[_offset];
-}
+    /**
+     * @brief Atomically marks an offset as in use.
+     *
+     * @return bool False if the offset was already in use.
+     */
+    inline bool ClaimSlot(size_t _offset) noexcept {
+        const uint64_t bit = uint64_t(1) << (_offset % c_wordBits);
 
-template <DefaultConstructible T>
-void MemoryPool<T>::Deallocate(T *_ptr) noexcept {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+        return !(GetOccupancyWord(_offset / c_wordBits).fetch_or(bit, std::memory_order_acq_rel) & bit);
+    }
 
-    if (_ptr && _ptr >= m_pool && _ptr < m_pool + m_capacity) {
-        size_t offset = _ptr - m_pool;
+    /**
+     * @brief Atomically marks an offset as free.
+     *
+     * @return bool False if the offset was already free.
+     */
+    inline bool ReleaseSlot(size_t _offset) noexcept {
+        const uint64_t bit = uint64_t(1) << (_offset % c_wordBits);
 
-        if (offset < m_capacity && m_inUse[offset]) {
-            m_inUse[offset] = false;
-            m_size--;
-        }
+        return GetOccupancyWord(_offset / c_wordBits).fetch_and(~bit, std::memory_order_acq_rel) & bit;
     }
-}
 
-template <DefaultConstructible T>
-T *MemoryPool<T>::Reallocate(size_t _srcOffset, size_t _dstOffset) noexcept {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
-
-    if (_srcOffset > m_capacity || _dstOffset > m_capacity)
-        throw std::out_of_range("Offset out of range!");
-    else if (!m_inUse[_srcOffset] && m_inUse[_dstOffset])
-        throw std::runtime_error("Memory at index " + std::to_string(_dstOffset) + " already in use!");
+    /**
+     * @brief Counts the live elements with one popcount per occupancy word.
+     */
+    NODISCARD size_t CountSlotsInUse() const noexcept;
 
-    m_pool[_dstOffset] = std::move(m_pool[_srcOffset]);
-    m_inUse[_dstOffset] = true;
-    m_inUse[_srcOffset] = false;
+    /**
+     * @brief Pushes an offset on top of the free offsets stack.
+     */
+    inline void PushFreeSlot(size_t _offset) noexcept {
+        m_freeSlotPositions[_offset] = m_freeCount;
+        m_freeSlots[m_freeCount++] = _offset;
+    }
 
-    return &m_pool[_dstOffset];
-}
+    /**
+     * @brief Pops the most recently released offset from the free offsets stack.
+     */
+    inline size_t PopFreeSlot() noexcept { return m_freeSlots[--m_freeCount]; }
 
-template <DefaultConstructible T>
-void MemoryPool<T>::Reserve(size_t _capacity) {
-    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+    /**
+     * @brief Checks whether an offset currently sits in the free offsets stack.
+     */
+    inline bool IsFreeSlotQueued(size_t _offset) const noexcept {
+        const size_t position = m_freeSlotPositions[_offset];
 
-    if (_capacity > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+        return position < m_freeCount && m_freeSlots[position] == _offset;
+    }
 
-    T *newPool = new T[_capacity];
-    std::memset(newPool, NULL, sizeof(T) * _capacity);
-    bool *newInUse = new bool[_capacity];
-    std::memset(newInUse, false, sizeof(bool) * _capacity);
+    /**
+     * @brief Removes an arbitrary offset from the free offsets stack by swapping it with the top.
+     */
+    inline void EraseFreeSlot(size_t _offset) noexcept {
+        const size_t position = m_freeSlotPositions[_offset];
+        const size_t top = m_freeSlots[--m_freeCount];
 
-    const size_t totalPoolSize = m_size * sizeof(T);
-    const size_t elementsToCopy = std::min(m_size, _capacity);
+        m_freeSlots[position] = top;
+        m_freeSlotPositions[top] = position;
+    }
 
-    std::memcpy(newPool, m_pool, elementsToCopy * sizeof(T));
-    std::memcpy(newInUse, m_inUse, elementsToCopy * sizeof(bool));
+    /**
+     * @brief Rebuilds the free offsets stack from the occupancy map so that lower offsets are handed out first.
+     *
+     * @note Offsets sitting in thread caches are queued again as well, the occupancy claim resolves the duplicates.
+     */
+    void RebuildFreeSlots() noexcept;
+
+    /**
+     * @brief Acquires the exclusive lock recording whether the calling thread had to wait for it.
+     */
+    std::unique_lock<std::shared_mutex> LockExclusive() noexcept;
+
+    /**
+     * @brief Returns the calling thread cache bound to this pool and epoch, returning the offsets another pool left in
+     * it to that pool.
+     */
+    ThreadCache &GetThreadCache() noexcept;
+
+    /**
+     * @brief Gets the thread caches of the calling thread, shared by every pool of the same element type.
+     */
+    NODISCARD static inline ThreadCache *GetThreadCaches() noexcept {
+        thread_local ThreadCache caches[c_threadCacheSlots];
+
+        return caches;
+    }
+
+    /**
+     * @brief Moves every offset of a thread cache back to the pool that owns it and unbinds the cache.
+     *
+     * @note Offsets cached before a Clear, Compact or Reserve of the owner, or by a destroyed owner, are dropped.
+     */
+    static void ReturnThreadCache(ThreadCache &_cache) noexcept;
+
+    /**
+     * @brief Points the cache owner back to this pool after a move.
+     */
+    void BindCacheOwner() noexcept;
+
+    /**
+     * @brief Moves a batch of offsets from the shared free offsets stack to a thread cache.
+     *
+     * @note Segmented pools append a page and reserved pools commit more of their address range when the stack is
+     * still empty after reclaiming stranded offsets.
+     *
+     * @return bool False if the pool has no free offsets left.
+     * @throws std::bad_alloc if a new page cannot be allocated.
+     */
+    bool RefillThreadCache(ThreadCache &_cache);
+
+    /**
+     * @brief Moves the most recently cached offsets of a thread cache back to the shared free offsets stack.
+     */
+    void FlushThreadCache(ThreadCache &_cache, size_t _count) noexcept;
+
+    /**
+     * @brief Adds the size delta and the counters of a thread cache to the pool, the pool lock must be held.
+     */
+    void PublishThreadCache(ThreadCache &_cache) noexcept;
+
+    /**
+     * @brief Claims a free offset through the calling thread cache and marks it as in use.
+     *
+     * @throws std::runtime_error if no free offsets are available in a contiguous pool.
+     */
+    size_t ClaimFreeSlot();
+
+    /**
+     * @brief Pushes a free offset on the calling thread cache, flushing half of the cache first if it is full.
+     *
+     * @return ThreadCache& The calling thread cache the offset was pushed on.
+     */
+    ThreadCache &CacheFreeSlot(size_t _offset) noexcept;
+
+    /**
+     * @brief Releases an offset claimed through ClaimFreeSlot whose element could not be constructed.
+     */
+    void AbandonFreeSlot(size_t _offset) noexcept;
+
+   public:
+    /**
+     * @brief Accesses an element in the memory pool by its offset.
+     *
+     * @param _offset The offset of the element to access.
+     * @return T& A reference to the accessed element.
+     * @throw std::out_of_range if the index is out of range.
+     */
+    NODISCARD inline T &operator[](size_t _offset) {
+        std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+        if (_offset < m_capacity)
+            return GetSlot(_offset);
+        else
+            throw std::out_of_range("Index out of range!");
+    };
+
+    /**
+     * @brief Gets the total size of the memory pool in bytes.
+     *
+     * @return size_t The total size of the memory pool.
+     */
+    NODISCARD inline size_t GetPoolSize() const noexcept { return m_capacity * sizeof(T); };
+
+    /**
+     * @brief Gets the amount of free memory in the memory pool in bytes.
+     *
+     * @return size_t The amount of free memory.
+     */
+    NODISCARD inline size_t GetFreeMemory() const noexcept { return GetPoolSize() - (size() * sizeof(T)); };
+
+    /**
+     * @brief Gets a snapshot of the thread caches and lock contention counters.
+     *
+     * @return MemoryPoolStatistics The counters accumulated since the pool was created.
+     */
+    NODISCARD MemoryPoolStatistics GetStatistics() const noexcept;
+
+    /**
+     * @brief Gets the current number of allocated offsets in the memory pool.
+     *
+     * @note Cached allocations and deallocations are only added to the shared count when their thread refills,
+     * flushes or returns its cache. The count is exact for the calling thread's own operations, those of other threads
+     * show up once their caches reach the pool.
+     *
+     * @return size_t The number of allocated offsets.
+     */
+    NODISCARD inline size_t size() const noexcept {
+        const ThreadCache &cache = GetThreadCaches()[m_id % c_threadCacheSlots];
+
+        ptrdiff_t size = m_size.load(std::memory_order_relaxed);
+
+        if (cache.poolId == m_id && cache.epoch == m_epoch.load(std::memory_order_relaxed)) size += cache.sizeDelta;
+
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    };
+
+    /**
+     * @brief Gets the number of available offsets in the memory pool.
+     *
+     * @return size_t The number of available offsets.
+     */
+    NODISCARD inline size_t capacity() const noexcept { return m_capacity.load(std::memory_order_relaxed); };
+
+    /**
+     * @brief Gets the storage layout of the memory pool.
+     *
+     * @return PoolLayout The layout chosen at construction.
+     */
+    NODISCARD inline PoolLayout GetLayout() const noexcept { return m_layout; };
+};
+
+template <typename T>
+MemoryPool<T>::MemoryPool(size_t _capacity, PoolLayout _layout, size_t _pageSize, size_t _maxCapacity)
+    : m_layout(_layout) {
+    if (m_layout == PoolLayout::reserved) {
+        PageDirectory *directory = new PageDirectory();
+
+        const size_t maxCapacity = _maxCapacity ? _maxCapacity : c_defaultReservation / sizeof(T);
+
+        directory->EmplacePage(0) = ReserveAddressSpace(std::max(_capacity, maxCapacity));
+        directory->count = 1;
+
+        m_directory = directory;
+
+        ResizeReservation(_capacity);
+    } else if (m_layout == PoolLayout::segmented) {
+        const size_t pageSize = std::bit_ceil(std::max(_pageSize, c_wordBits));
+
+        m_pageShift = std::countr_zero(pageSize);
+        m_pageMask = pageSize - 1;
+        m_directory = new PageDirectory();
+
+        ResizeDirectory((_capacity + m_pageMask) >> m_pageShift);
+    } else {
+        PageDirectory *directory = new PageDirectory();
+
+        directory->EmplacePage(0) = AllocatePage(_capacity);
+        directory->count = 1;
+
+        m_directory = directory;
+        m_capacity = _capacity;
+    }
+};
+
+template <typename T>
+MemoryPool<T>::~MemoryPool() {
+    // Caches returned from now on drop their offsets instead of touching the released storage.
+    if (m_owner) {
+        std::lock_guard<std::mutex> lock(m_owner->mutex);
+        m_owner->pool = nullptr;
+    }
+
+    ReleasePages();
+}
+
+template <typename T>
+MemoryPool<T> &MemoryPool<T>::operator=(MemoryPool &&_other) noexcept {
+    if (this == &_other) return *this;
+
+    const ptrdiff_t size = m_size.exchange(_other.m_size.load());
+    _other.m_size = size;
+
+    const size_t capacity = m_capacity.exchange(_other.m_capacity.load());
+    _other.m_capacity = capacity;
+
+    const size_t watermark = m_watermark.exchange(_other.m_watermark.load());
+    _other.m_watermark = watermark;
+
+    const uint32_t epoch = m_epoch.exchange(_other.m_epoch.load());
+    _other.m_epoch = epoch;
+
+    // Thread caches are keyed by pool identifier and return their offsets through the owner, swapping both keeps the
+    // cached offsets bound to their storage.
+    std::swap(m_id, _other.m_id);
+    std::swap(m_owner, _other.m_owner);
+    BindCacheOwner();
+    _other.BindCacheOwner();
+    std::swap(m_layout, _other.m_layout);
+    std::swap(m_tag, _other.m_tag);
+    std::swap(m_pageShift, _other.m_pageShift);
+    std::swap(m_pageMask, _other.m_pageMask);
+    std::swap(m_reservation, _other.m_reservation);
+    std::swap(m_occupancyReservation, _other.m_occupancyReservation);
+    std::swap(m_freeCount, _other.m_freeCount);
+    std::swap(m_freeSlots, _other.m_freeSlots);
+    std::swap(m_freeSlotPositions, _other.m_freeSlotPositions);
+    std::swap(m_handleEntries, _other.m_handleEntries);
+    std::swap(m_slotHandles, _other.m_slotHandles);
+    std::swap(m_handleCount, _other.m_handleCount);
+    std::swap(m_freeHandle, _other.m_freeHandle);
+
+    m_directory = _other.m_directory.exchange(m_directory.load());
+
+    return *this;
+}
+
+template <typename T>
+MemoryPool<T>::MemoryPool(MemoryPool<T> &&_other) noexcept
+    : m_owner(std::move(_other.m_owner)),
+      m_layout(_other.m_layout),
+      m_tag(_other.m_tag),
+      m_pageShift(_other.m_pageShift),
+      m_pageMask(_other.m_pageMask),
+      m_directory(_other.m_directory.exchange(nullptr)),
+      m_reservation(std::move(_other.m_reservation)),
+      m_occupancyReservation(std::move(_other.m_occupancyReservation)),
+      m_freeSlots(std::move(_other.m_freeSlots)),
+      m_freeSlotPositions(std::move(_other.m_freeSlotPositions)),
+      m_capacity(_other.m_capacity.load()),
+      m_watermark(_other.m_watermark.load()),
+      m_epoch(_other.m_epoch.load()),
+      m_handleEntries(std::move(_other.m_handleEntries)),
+      m_slotHandles(std::move(_other.m_slotHandles)),
+      m_handleCount(_other.m_handleCount),
+      m_freeHandle(_other.m_freeHandle),
+      m_size(_other.m_size.load()),
+      m_freeCount(_other.m_freeCount) {
+    _other.m_capacity = 0;
+    _other.m_watermark = 0;
+    _other.m_size = 0;
+    _other.m_freeCount = 0;
+    _other.m_handleCount = 0;
+    _other.m_freeHandle = c_invalidHandle;
 
-    std::swap(m_pool, newPool);
-    std::swap(m_inUse, newInUse);
+    // The moved-from pool keeps a fresh identifier and no owner, the caches bound to it are simply dropped.
+    std::swap(m_id, _other.m_id);
+    BindCacheOwner();
+}
+
+template <typename T>
+MemoryPool<T> &MemoryPool<T>::operator=(const MemoryPool<T> &_other) noexcept {
+    if (this == &_other) return *this;
+
+    ReleasePages();
+    CopyPages(_other);
+
+    return *this;
+}
+
+template <typename T>
+MemoryPool<T>::MemoryPool(const MemoryPool<T> &_other) noexcept {
+    CopyPages(_other);
+}
+
+template <typename T>
+T *MemoryPool<T>::Allocate(const T &_data) {
+    return Construct(_data);
+}
+
+template <typename T>
+T *MemoryPool<T>::AllocateAt(const T &_data, size_t _offset) {
+    return ConstructAt(_offset, _data);
+}
+
+template <typename T>
+template <typename... Args>
+T *MemoryPool<T>::Construct(Args &&..._args) {
+    const size_t offset = ClaimFreeSlot();
+
+    try {
+        return new (&GetSlot(offset)) T(std::forward<Args>(_args)...);
+    } catch (...) {
+        AbandonFreeSlot(offset);
+        throw;
+    }
+}
+
+template <typename T>
+template <typename... Args>
+T *MemoryPool<T>::ConstructAt(size_t _offset, Args &&..._args) {
+    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+    if (_offset >= m_capacity) throw std::out_of_range("Offset out of range!");
+
+    if (_offset >= m_watermark) AdvanceWatermark(_offset + 1);
+
+    if (!ClaimSlot(_offset))
+        throw std::runtime_error("Memory at index " + std::to_string(_offset) + " already in use!");
+
+    if (IsFreeSlotQueued(_offset)) EraseFreeSlot(_offset);
+
+    m_size.fetch_add(1, std::memory_order_relaxed);
+
+    try {
+        return new (&GetSlot(_offset)) T(std::forward<Args>(_args)...);
+    } catch (...) {
+        // The lock is still held so the offset goes straight back to the shared stack.
+        ReleaseSlot(_offset);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+
+        if (!IsFreeSlotQueued(_offset)) PushFreeSlot(_offset);
+
+        throw;
+    }
+}
+
+template <typename T>
+void MemoryPool<T>::Deallocate(T *_ptr) noexcept {
+    if (!_ptr) return;
+
+    const size_t offset = GetOffset(_ptr);
+
+    if (offset >= m_capacity || !IsSlotInUse(offset)) return;
+
+    // Destroyed before the bit is released, a concurrent claim could otherwise construct over it.
+    std::destroy_at(_ptr);
+
+    if (!ReleaseSlot(offset)) return;
+
+    ThreadCache &cache = CacheFreeSlot(offset);
+
+    cache.sizeDelta--;
+    cache.deallocations++;
+}
+
+template <typename T>
+T *MemoryPool<T>::Reallocate(size_t _srcOffset, size_t _dstOffset) {
+    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+    if (_srcOffset >= m_capacity || _dstOffset >= m_capacity) throw std::out_of_range("Offset out of range!");
+
+    if (_dstOffset >= m_watermark) AdvanceWatermark(_dstOffset + 1);
+
+    if (!IsSlotInUse(_srcOffset) || !ClaimSlot(_dstOffset))
+        throw std::runtime_error("Memory at index " + std::to_string(_dstOffset) + " already in use!");
+
+    RelocateElement(_srcOffset, _dstOffset);
+    ReleaseSlot(_srcOffset);
+    RelocateHandle(_srcOffset, _dstOffset);
+
+    if (IsFreeSlotQueued(_dstOffset)) EraseFreeSlot(_dstOffset);
+    if (!IsFreeSlotQueued(_srcOffset)) PushFreeSlot(_srcOffset);
+
+    return &GetSlot(_dstOffset);
+}
 
-    delete[] newPool;
-    delete[] newInUse;
+template <typename T>
+template <typename... Args>
+typename MemoryPool<T>::Handle MemoryPool<T>::ConstructHandle(Args &&..._args) {
+    const size_t offset = ClaimFreeSlot();
+
+    try {
+        new (&GetSlot(offset)) T(std::forward<Args>(_args)...);
+    } catch (...) {
+        AbandonFreeSlot(offset);
+        throw;
+    }
+
+    auto lock = LockExclusive();
+
+    try {
+        return RegisterHandle(offset);
+    } catch (...) {
+        // Returning the offset may flush the thread cache, which takes the lock again.
+        lock.unlock();
+
+        std::destroy_at(&GetSlot(offset));
+        AbandonFreeSlot(offset);
+        throw;
+    }
+}
+
+template <typename T>
+typename MemoryPool<T>::Handle MemoryPool<T>::AllocateHandle(const T &_data) {
+    return ConstructHandle(_data);
+}
+
+template <typename T>
+void MemoryPool<T>::DeallocateHandle(Handle _handle) noexcept {
+    auto lock = LockExclusive();
+
+    if (_handle.index >= m_handleCount) return;
+
+    const HandleEntry &entry = m_handleEntries[_handle.index];
+
+    if (entry.generation != _handle.generation) return;
+
+    const size_t offset = entry.offset;
+
+    ReleaseHandleEntry(_handle.index);
+    m_slotHandles[offset] = c_invalidHandle;
+
+    if (!IsSlotInUse(offset)) return;
+
+    std::destroy_at(&GetSlot(offset));
+    ReleaseSlot(offset);
+
+    m_size.fetch_sub(1, std::memory_order_relaxed);
+
+    // The lock is already held so the offset goes straight back to the shared stack.
+    if (!IsFreeSlotQueued(offset)) PushFreeSlot(offset);
+}
+
+template <typename T>
+T *MemoryPool<T>::Resolve(Handle _handle) noexcept {
+    std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+    if (_handle.index >= m_handleCount) return nullptr;
+
+    const HandleEntry &entry = m_handleEntries[_handle.index];
+
+    if (entry.generation != _handle.generation || entry.offset >= m_capacity) return nullptr;
+
+    return &GetSlot(entry.offset);
+}
+
+template <typename T>
+void MemoryPool<T>::Reserve(size_t _capacity) {
+    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
+    if (_capacity > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+    if (m_layout == PoolLayout::segmented) {
+        ResizeDirectory((_capacity + m_pageMask) >> m_pageShift);
+    } else if (m_layout == PoolLayout::reserved) {
+        if (_capacity > GetReservedCapacity()) throw std::bad_alloc();
+
+        ResizeReservation(_capacity);
+    } else {
+        if (_capacity < m_capacity) DestroyElements(_capacity, m_capacity);
+
+        Page page = AllocatePage(_capacity);
+        Page &current = GetPage(0);
+
+        const size_t elementsToCopy = std::min(m_watermark.load(), _capacity);
+
+        for (size_t word = 0; word < GetWordCount(elementsToCopy); ++word) {
+            const size_t first = word * c_wordBits;
+            const size_t count = std::min(c_wordBits, elementsToCopy - first);
+
+            uint64_t bits = LoadOccupancyWord(word, std::memory_order_relaxed);
+
+            page.occupancy[word].store(bits, std::memory_order_relaxed);
+
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (bits) std::memcpy(page.data + first, current.data + first, count * sizeof(T));
+            } else {
+                while (bits) {
+                    const size_t i = first + std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    new (page.data + i) T(std::move(current.data[i]));
+                    std::destroy_at(current.data + i);
+                }
+            }
+        }
+
+        std::swap(current, page);
+        FreePage(page, m_capacity);
+
+        m_capacity = _capacity;
+    }
+
+    // Cached offsets may now lie past the capacity or above the lowered watermark.
+    m_watermark = std::min(m_watermark.load(), m_capacity.load());
 
-    m_capacity = _capacity;
-    m_size = elementsToCopy;
+    ResizeBookkeeping(m_watermark);
+    m_epoch.fetch_add(1, std::memory_order_relaxed);
+    m_size = CountSlotsInUse();
+
+    RebuildFreeSlots();
 }
 
-template <DefaultConstructible T>
+template <typename T>
 void MemoryPool<T>::Compact() noexcept {
+    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
+
     size_t nextFreeSlot = 0;
 
-    for (size_t i = 0; i < m_capacity; ++i) {
-        if (!m_inUse[i]) {
-            continue;
-        }
+    for (size_t word = 0; word < GetWordCount(m_watermark); ++word) {
+        uint64_t bits = LoadOccupancyWord(word, std::memory_order_relaxed);
+
+        while (bits) {
+            const size_t i = word * c_wordBits + std::countr_zero(bits);
+            bits &= bits - 1;
 
-        if (i != nextFreeSlot) {
-            m_pool[nextFreeSlot] = std::move(m_pool[i]);
-            m_inUse[nextFreeSlot] = true;
-            m_inUse[i] = false;
+            if (i != nextFreeSlot) {
+                RelocateElement(i, nextFreeSlot);
+                RelocateHandle(i, nextFreeSlot);
+            }
+
+            ++nextFreeSlot;
         }
+    }
 
-        ++nextFreeSlot;
+    // Live elements now fill [0, nextFreeSlot), the watermark drops right above them and nothing below it is free.
+    for (size_t word = 0; word < GetWordCount(nextFreeSlot); ++word) {
+        const size_t live = std::min(nextFreeSlot - word * c_wordBits, c_wordBits);
+        const uint64_t bits = live == c_wordBits ? ~uint64_t(0) : (uint64_t(1) << live) - 1;
+
+        GetOccupancyWord(word).store(bits, std::memory_order_relaxed);
     }
+
+    m_watermark = nextFreeSlot;
+    m_freeCount = 0;
+    m_size = nextFreeSlot;
+    m_epoch.fetch_add(1, std::memory_order_relaxed);
 }
 
-template <DefaultConstructible T>
+template <typename T>
 void MemoryPool<T>::Clear() noexcept {
-    std::memset(m_pool, NULL, sizeof(T) * m_capacity);
-    std::memset(m_inUse, false, sizeof(bool) * m_capacity);
+    std::unique_lock<std::shared_mutex> writeLock(m_mutex);
 
+    if constexpr (!std::is_trivially_destructible_v<T>) DestroyElements(0, m_watermark);
+
+    // Occupancy bits, free offsets and reverse handle links are left stale, the watermark makes them unreachable.
+    m_watermark = 0;
+    m_freeCount = 0;
+    m_handleCount = 0;
+    m_freeHandle = c_invalidHandle;
     m_size = 0;
+    m_epoch.fetch_add(1, std::memory_order_relaxed);
 }
 
-template <DefaultConstructible T>
+template <typename T>
 template <class ExPo>
 void MemoryPool<T>::Map(ExPo &&_policy, std::function<void(T &)> &&_function) {
     std::unique_lock<std::shared_mutex> lock(m_mutex);
 
-    std::for_each(_policy, m_pool, m_pool + m_size, _function);
+    std::vector<size_t> words;
+
+    for (size_t word = 0; word < GetWordCount(m_watermark); ++word) {
+        if (LoadOccupancyWord(word, std::memory_order_relaxed)) words.push_back(word);
+    }
+
+    // Parallelized over the non-empty occupancy words, each task walks its live offsets with count-trailing-zeros.
+    std::for_each(_policy, words.begin(), words.end(), [this, &_function](size_t _word) {
+        uint64_t bits = LoadOccupancyWord(_word, std::memory_order_relaxed);
+
+        while (bits) {
+            _function(GetSlot(_word * c_wordBits + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    });
+}
+
+template <typename T>
+template <typename Function>
+void MemoryPool<T>::ForEachLive(Function &&_function) {
+    std::shared_lock<std::shared_mutex> readLock(m_mutex);
+
+    for (size_t word = 0; word < GetWordCount(m_watermark); ++word) {
+        uint64_t bits = LoadOccupancyWord(word, std::memory_order_acquire);
+
+        while (bits) {
+            _function(GetSlot(word * c_wordBits + std::countr_zero(bits)));
+            bits &= bits - 1;
+        }
+    }
+}
+
+template <typename T>
+MemoryPoolStatistics MemoryPool<T>::GetStatistics() const noexcept {
+    return {
+        .cachedAllocations = m_statistics.cachedAllocations.load(std::memory_order_relaxed),
+        .cachedDeallocations = m_statistics.cachedDeallocations.load(std::memory_order_relaxed),
+        .refills = m_statistics.refills.load(std::memory_order_relaxed),
+        .flushes = m_statistics.flushes.load(std::memory_order_relaxed),
+        .reclaims = m_statistics.reclaims.load(std::memory_order_relaxed),
+        .lockAcquisitions = m_statistics.lockAcquisitions.load(std::memory_order_relaxed),
+        .lockContentions = m_statistics.lockContentions.load(std::memory_order_relaxed),
+        .pageAllocations = m_statistics.pageAllocations.load(std::memory_order_relaxed),
+    };
+}
+
+template <typename T>
+void MemoryPool<T>::RebuildFreeSlots() noexcept {
+    m_freeCount = 0;
+
+    // Pushed in reverse so that the lowest offsets sit on top of the stack and are handed out first.
+    for (size_t word = GetWordCount(m_watermark); word > 0; --word) {
+        uint64_t freeBits = ~LoadOccupancyWord(word - 1, std::memory_order_relaxed) & GetIssuedMask(word - 1);
+
+        while (freeBits) {
+            const size_t bit = c_wordBits - 1 - std::countl_zero(freeBits);
+
+            PushFreeSlot((word - 1) * c_wordBits + bit);
+            freeBits &= ~(uint64_t(1) << bit);
+        }
+    }
+}
+
+template <typename T>
+size_t MemoryPool<T>::CountSlotsInUse() const noexcept {
+    size_t count = 0;
+
+    for (size_t word = 0; word < GetWordCount(m_watermark); ++word)
+        count += std::popcount(LoadOccupancyWord(word, std::memory_order_relaxed));
+
+    return count;
+}
+
+template <typename T>
+size_t MemoryPool<T>::GetOffset(const T *_ptr) const noexcept {
+    PageDirectory *directory = m_directory.load(std::memory_order_acquire);
+
+    if (!directory) return c_invalidOffset;
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(_ptr);
+
+    // Single-page layouts never republish their address index, the page itself is the whole search.
+    if (m_layout != PoolLayout::segmented) {
+        if (directory->count == 0) return c_invalidOffset;
+
+        const uintptr_t data = reinterpret_cast<uintptr_t>(directory->GetPage(0).data);
+
+        if (address < data || (address - data) / sizeof(T) >= GetPageCapacity()) return c_invalidOffset;
+
+        return (address - data) / sizeof(T);
+    }
+
+    // Registered as a reader of the current epoch so that a concurrent growth does not delete the index under us.
+    const size_t epoch = directory->readerEpoch.load();
+
+    directory->readers[epoch & 1].fetch_add(1);
+
+    const AddressIndex *index = directory->addressIndex.load();
+    const size_t *first = index->pages;
+    const size_t *last = first + index->count;
+
+    const size_t *page = std::upper_bound(first, last, address, [directory](uintptr_t _address, size_t _page) {
+        return _address < reinterpret_cast<uintptr_t>(directory->GetPage(_page).data);
+    });
+
+    size_t offset = c_invalidOffset;
+
+    if (page-- != first) {
+        const size_t element = (address - reinterpret_cast<uintptr_t>(directory->GetPage(*page).data)) / sizeof(T);
+
+        if (element < GetPageCapacity()) offset = (*page << m_pageShift) + element;
+    }
+
+    directory->readers[epoch & 1].fetch_sub(1, std::memory_order_release);
+
+    return offset;
+}
+
+template <typename T>
+typename MemoryPool<T>::Page MemoryPool<T>::AllocatePage(size_t _pageCapacity) {
+    Page page;
+
+    page.data = static_cast<T *>(::operator new(_pageCapacity * sizeof(T), std::align_val_t(alignof(T))));
+    page.occupancy = new std::atomic<uint64_t>[GetWordCount(_pageCapacity)]();
+
+    MemoryTracker::RecordAllocation(m_tag, GetPageBytes(_pageCapacity));
+
+    return page;
+}
+
+template <typename T>
+void MemoryPool<T>::FreePage(const Page &_page, size_t _pageCapacity) noexcept {
+    ::operator delete(_page.data, std::align_val_t(alignof(T)));
+    delete[] _page.occupancy;
+
+    MemoryTracker::RecordDeallocation(m_tag, GetPageBytes(_pageCapacity));
+}
+
+template <typename T>
+void MemoryPool<T>::DestroyElements(size_t _firstOffset, size_t _lastOffset) noexcept {
+    _lastOffset = std::min(_lastOffset, m_watermark.load(std::memory_order_relaxed));
+
+    for (size_t word = _firstOffset / c_wordBits; word < GetWordCount(_lastOffset); ++word) {
+        const size_t first = word * c_wordBits;
+
+        uint64_t bits = LoadOccupancyWord(word, std::memory_order_relaxed);
+
+        if (first < _firstOffset) bits &= ~((uint64_t(1) << (_firstOffset - first)) - 1);
+        if (_lastOffset - first < c_wordBits) bits &= (uint64_t(1) << (_lastOffset - first)) - 1;
+
+        GetOccupancyWord(word).fetch_and(~bits, std::memory_order_relaxed);
+
+        while (bits) {
+            const size_t offset = first + std::countr_zero(bits);
+            bits &= bits - 1;
+
+            std::destroy_at(&GetSlot(offset));
+
+            if (m_slotHandles[offset] != c_invalidHandle) ReleaseHandleEntry(m_slotHandles[offset]);
+
+            m_slotHandles[offset] = c_invalidHandle;
+        }
+    }
+}
+
+template <typename T>
+void MemoryPool<T>::AdvanceWatermark(size_t _watermark) {
+    const size_t first = m_watermark.load(std::memory_order_relaxed);
+
+    if (_watermark > m_slotHandles.size()) ResizeBookkeeping(_watermark);
+
+    for (size_t offset = first; offset < _watermark; ++offset) {
+        // Bits at and above the old watermark are leftovers of a previous epoch, the ones below it are live.
+        if (offset == first || offset % c_wordBits == 0) {
+            const uint64_t issued = (uint64_t(1) << (offset % c_wordBits)) - 1;
+
+            GetOccupancyWord(offset / c_wordBits).fetch_and(issued, std::memory_order_relaxed);
+        }
+
+        m_slotHandles[offset] = c_invalidHandle;
+    }
+
+    // Pushed in reverse so that the lowest offsets sit on top of the stack and are handed out first.
+    for (size_t offset = _watermark; offset > first; --offset) PushFreeSlot(offset - 1);
+
+    m_watermark.store(_watermark, std::memory_order_release);
+}
+
+template <typename T>
+void MemoryPool<T>::ResizeDirectory(size_t _pageCount) {
+    PageDirectory *directory = m_directory.load(std::memory_order_relaxed);
+
+    const size_t pageCount = directory->count;
+
+    if (_pageCount < pageCount) DestroyElements(_pageCount << m_pageShift, pageCount << m_pageShift);
+
+    for (size_t i = _pageCount; i < pageCount; ++i) FreePage(directory->GetPage(i), m_pageMask + 1);
+
+    for (size_t i = pageCount; i < _pageCount; ++i) directory->EmplacePage(i) = AllocatePage(m_pageMask + 1);
+
+    directory->count = _pageCount;
+
+    if (_pageCount == pageCount + 1) {
+        InsertAddressIndex(pageCount);
+    } else if (_pageCount != pageCount) {
+        RebuildAddressIndex();
+
+        // Blocks past the last page are only released here, with no concurrent readers.
+        for (size_t block = _pageCount ? GetPageBlock(_pageCount - 1) + 1 : 0; block < c_pageBlockCount; ++block)
+            delete[] directory->blocks[block].exchange(nullptr, std::memory_order_relaxed);
+    }
+
+    m_capacity.store(_pageCount << m_pageShift, std::memory_order_release);
+}
+
+template <typename T>
+void MemoryPool<T>::AppendPage() {
+    ResizeDirectory(m_directory.load(std::memory_order_relaxed)->count + 1);
+
+    m_statistics.pageAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+template <typename T>
+void MemoryPool<T>::InsertAddressIndex(size_t _page) {
+    const PageDirectory *directory = m_directory.load(std::memory_order_relaxed);
+    const AddressIndex *current = directory->addressIndex.load(std::memory_order_relaxed);
+    const T *data = directory->GetPage(_page).data;
+
+    AddressIndex *index = new AddressIndex(current->count + 1);
+
+    const size_t *first = current->pages;
+    const size_t *last = first + current->count;
+
+    const size_t *position = std::upper_bound(first, last, data, [directory](const T *_data, size_t _other) {
+        return std::less<const T *>()(_data, directory->GetPage(_other).data);
+    });
+
+    size_t *inserted = std::copy(first, position, index->pages);
+
+    *inserted = _page;
+
+    std::copy(position, last, inserted + 1);
+
+    PublishAddressIndex(index);
+}
+
+template <typename T>
+void MemoryPool<T>::RebuildAddressIndex() {
+    const PageDirectory *directory = m_directory.load(std::memory_order_relaxed);
+
+    AddressIndex *index = new AddressIndex(directory->count);
+
+    for (size_t i = 0; i < index->count; ++i) index->pages[i] = i;
+
+    std::sort(index->pages, index->pages + index->count, [directory](size_t _lhs, size_t _rhs) {
+        return std::less<T *>()(directory->GetPage(_lhs).data, directory->GetPage(_rhs).data);
+    });
+
+    PublishAddressIndex(index);
+}
+
+template <typename T>
+void MemoryPool<T>::PublishAddressIndex(AddressIndex *_index) noexcept {
+    PageDirectory *directory = m_directory.load(std::memory_order_relaxed);
+    AddressIndex *retired = directory->addressIndex.exchange(_index);
+
+    // A reader may have loaded the epoch before the first flip and registered after it, so both epochs are drained.
+    for (size_t phase = 0; phase < 2; ++phase) {
+        const size_t epoch = directory->readerEpoch.fetch_add(1);
+
+        while (directory->readers[epoch & 1].load() != 0) std::this_thread::yield();
+    }
+
+    delete retired;
+}
+
+template <typename T>
+typename MemoryPool<T>::Page MemoryPool<T>::ReserveAddressSpace(size_t _maxCapacity) {
+    if (_maxCapacity > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_alloc();
+
+    const size_t reservedSize = std::max(_maxCapacity * sizeof(T), alignof(T));
+
+    m_reservation = VirtualReservation(reservedSize, reservedSize >= c_hugePageThreshold);
+    m_occupancyReservation = VirtualReservation(GetWordCount(_maxCapacity) * sizeof(std::atomic<uint64_t>));
+
+    // The reservation counts as one allocation whose size follows the committed memory.
+    MemoryTracker::RecordAllocation(m_tag, 0);
+
+    return Page{reinterpret_cast<T *>(m_reservation.GetData()),
+                reinterpret_cast<std::atomic<uint64_t> *>(m_occupancyReservation.GetData())};
+}
+
+template <typename T>
+void MemoryPool<T>::ResizeReservation(size_t _capacity) {
+    const size_t capacity = m_capacity.load(std::memory_order_relaxed);
+    const size_t wordCount = GetWordCount(capacity);
+    const size_t newWordCount = GetWordCount(_capacity);
+    const size_t committedBytes = GetCommittedBytes();
+
+    if (_capacity < capacity) {
+        DestroyElements(_capacity, capacity);
+
+        // Decommitted pages read back as zeroes once committed again, like freshly reserved ones.
+        m_reservation.Decommit(_capacity * sizeof(T));
+        m_occupancyReservation.Decommit(newWordCount * sizeof(std::atomic<uint64_t>));
+    } else {
+        m_reservation.Commit(_capacity * sizeof(T));
+        m_occupancyReservation.Commit(newWordCount * sizeof(std::atomic<uint64_t>));
+
+        std::atomic<uint64_t> *occupancy = GetPage(0).occupancy;
+
+        for (size_t word = wordCount; word < newWordCount; ++word) new (occupancy + word) std::atomic<uint64_t>(0);
+    }
+
+    MemoryTracker::RecordResize(m_tag, committedBytes, GetCommittedBytes());
+
+    m_capacity.store(_capacity, std::memory_order_release);
+}
+
+template <typename T>
+void MemoryPool<T>::ReleasePages() noexcept {
+    PageDirectory *directory = m_directory.load(std::memory_order_relaxed);
+
+    if (!directory) return;
+
+    DestroyElements(0, m_capacity);
+
+    m_directory = nullptr;
+
+    if (m_layout == PoolLayout::reserved) {
+        MemoryTracker::RecordDeallocation(m_tag, GetCommittedBytes());
+
+        m_reservation = VirtualReservation();
+        m_occupancyReservation = VirtualReservation();
+    } else {
+        for (size_t i = 0; i < directory->count; ++i) FreePage(directory->GetPage(i), GetPageCapacity());
+    }
+
+    delete directory;
+
+    m_capacity = 0;
+    m_watermark = 0;
+    m_size = 0;
+    m_freeCount = 0;
+}
+
+template <typename T>
+void MemoryPool<T>::CopyPages(const MemoryPool &_other) {
+    const PageDirectory *source = _other.m_directory.load(std::memory_order_acquire);
+    PageDirectory *directory = new PageDirectory();
+
+    m_layout = _other.m_layout;
+    m_tag = _other.m_tag;
+    m_pageShift = _other.m_pageShift;
+    m_pageMask = _other.m_pageMask;
+    m_capacity = _other.m_capacity.load();
+    m_watermark = _other.m_watermark.load();
+    m_epoch.fetch_add(1, std::memory_order_relaxed);
+
+    directory->count = source ? source->count : 0;
+
+    for (size_t i = 0; i < directory->count; ++i) {
+        const size_t pageCapacity = GetPageCapacity();
+        Page &page = directory->EmplacePage(i);
+
+        if (m_layout == PoolLayout::reserved) {
+            page = ReserveAddressSpace(_other.GetReservedCapacity());
+
+            m_reservation.Commit(pageCapacity * sizeof(T));
+            m_occupancyReservation.Commit(GetWordCount(pageCapacity) * sizeof(std::atomic<uint64_t>));
+
+            MemoryTracker::RecordResize(m_tag, 0, GetCommittedBytes());
+        } else {
+            page = AllocatePage(pageCapacity);
+        }
+
+        const size_t firstWord = (i << m_pageShift) / c_wordBits;
+
+        for (size_t word = 0; word < GetWordCount(pageCapacity); ++word) {
+            uint64_t bits = _other.LoadOccupancyWord(firstWord + word, std::memory_order_relaxed);
+
+            page.occupancy[word].store(bits, std::memory_order_relaxed);
+
+            while (bits) {
+                const size_t j = word * c_wordBits + std::countr_zero(bits);
+                bits &= bits - 1;
+
+                new (page.data + j) T(source->GetPage(i).data[j]);
+            }
+        }
+    }
+
+    m_directory = directory;
+    m_size = CountSlotsInUse();
+
+    if (m_layout == PoolLayout::segmented) RebuildAddressIndex();
+
+    m_handleEntries = _other.m_handleEntries;
+    m_slotHandles = _other.m_slotHandles;
+    m_handleCount = _other.m_handleCount;
+    m_freeHandle = _other.m_freeHandle;
+    ResizeBookkeeping(m_watermark);
+    RebuildFreeSlots();
+}
+
+template <typename T>
+void MemoryPool<T>::ResizeBookkeeping(size_t _watermark) {
+    m_freeSlots.resize(_watermark);
+    m_freeSlotPositions.resize(_watermark);
+    m_slotHandles.resize(_watermark, c_invalidHandle);
+}
+
+template <typename T>
+typename MemoryPool<T>::Handle MemoryPool<T>::RegisterHandle(size_t _offset) {
+    uint32_t index = m_freeHandle;
+
+    if (index != c_invalidHandle) {
+        m_freeHandle = static_cast<uint32_t>(m_handleEntries[index].offset);
+    } else if (m_handleCount < m_handleEntries.size()) {
+        // Entries left behind by Clear are reused in order, the bumped generation invalidates their old handles.
+        index = m_handleCount++;
+        m_handleEntries[index].generation++;
+    } else {
+        if (m_handleEntries.size() >= c_invalidHandle) throw std::length_error("Memory pool handle table is full.");
+
+        index = m_handleCount++;
+        m_handleEntries.emplace_back();
+    }
+
+    m_handleEntries[index].offset = _offset;
+    m_slotHandles[_offset] = index;
+
+    return {index, m_handleEntries[index].generation};
+}
+
+template <typename T>
+void MemoryPool<T>::ReleaseHandleEntry(uint32_t _index) noexcept {
+    HandleEntry &entry = m_handleEntries[_index];
+
+    entry.generation++;
+    entry.offset = m_freeHandle;
+    m_freeHandle = _index;
+}
+
+template <typename T>
+std::unique_lock<std::shared_mutex> MemoryPool<T>::LockExclusive() noexcept {
+    std::unique_lock<std::shared_mutex> lock(m_mutex, std::try_to_lock);
+
+    if (!lock.owns_lock()) {
+        m_statistics.lockContentions.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+
+    m_statistics.lockAcquisitions.fetch_add(1, std::memory_order_relaxed);
+
+    return lock;
+}
+
+template <typename T>
+typename MemoryPool<T>::ThreadCache &MemoryPool<T>::GetThreadCache() noexcept {
+    ThreadCache &cache = GetThreadCaches()[m_id % c_threadCacheSlots];
+
+    const uint32_t epoch = m_epoch.load(std::memory_order_relaxed);
+
+    // Offsets left behind by another pool go back to it. Offsets cached before a Clear, Compact or Reserve of this
+    // pool may lie above the watermark and are dropped, the epoch change already rebuilt or reset the free offsets.
+    if (cache.poolId != m_id) {
+        ReturnThreadCache(cache);
+
+        cache.poolId = m_id;
+        cache.epoch = epoch;
+        cache.owner = m_owner;
+    } else if (cache.epoch != epoch) {
+        // The epoch change also recounted m_size, the pending delta is already part of it.
+        cache.epoch = epoch;
+        cache.count = 0;
+        cache.sizeDelta = 0;
+    }
+
+    return cache;
+}
+
+template <typename T>
+void MemoryPool<T>::ReturnThreadCache(ThreadCache &_cache) noexcept {
+    if (_cache.count > 0 || _cache.sizeDelta != 0) {
+        if (const std::shared_ptr<CacheOwner> owner = _cache.owner.lock()) {
+            std::lock_guard<std::mutex> lock(owner->mutex);
+
+            MemoryPool *pool = owner->pool;
+
+            if (pool && pool->m_epoch.load(std::memory_order_relaxed) == _cache.epoch)
+                pool->FlushThreadCache(_cache, _cache.count);
+        }
+    }
+
+    _cache.poolId = 0;
+    _cache.count = 0;
+    _cache.allocations = 0;
+    _cache.deallocations = 0;
+    _cache.sizeDelta = 0;
+    _cache.owner.reset();
+}
+
+template <typename T>
+void MemoryPool<T>::BindCacheOwner() noexcept {
+    if (!m_owner) return;
+
+    std::lock_guard<std::mutex> lock(m_owner->mutex);
+
+    m_owner->pool = this;
+}
+
+template <typename T>
+bool MemoryPool<T>::RefillThreadCache(ThreadCache &_cache) {
+    auto lock = LockExclusive();
+
+    if (m_freeCount == 0 && m_watermark < m_capacity)
+        AdvanceWatermark(std::min(m_watermark + c_threadCacheSize / 2, m_capacity.load()));
+
+    // Offsets sitting in the caches of other threads are recovered here, the occupancy claim resolves the duplicates.
+    // The occupancy is recounted because m_size misses the deltas still held by other threads.
+    if (m_freeCount == 0 && CountSlotsInUse() < m_watermark) {
+        RebuildFreeSlots();
+        m_statistics.reclaims.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (m_freeCount == 0 && m_layout == PoolLayout::segmented) {
+        AppendPage();
+        AdvanceWatermark(std::min(m_watermark + c_threadCacheSize / 2, m_capacity.load()));
+    }
+
+    // Reserved pools double their committed capacity in place, up to the end of their address range.
+    if (m_freeCount == 0 && m_layout == PoolLayout::reserved && m_capacity < GetReservedCapacity()) {
+        ResizeReservation(std::min(std::max(m_capacity * 2, c_defaultPageSize), GetReservedCapacity()));
+        AdvanceWatermark(std::min(m_watermark + c_threadCacheSize / 2, m_capacity.load()));
+
+        m_statistics.pageAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const size_t batchSize = std::min(c_threadCacheSize / 2, m_freeCount);
+
+    // Filled back to front so the cache hands the batch out in the same order the stack would have.
+    for (size_t i = batchSize; i > 0; --i) _cache.offsets[_cache.count + i - 1] = PopFreeSlot();
+
+    _cache.count += batchSize;
+
+    m_statistics.refills.fetch_add(1, std::memory_order_relaxed);
+    PublishThreadCache(_cache);
+
+    return batchSize > 0;
+}
+
+template <typename T>
+void MemoryPool<T>::FlushThreadCache(ThreadCache &_cache, size_t _count) noexcept {
+    auto lock = LockExclusive();
+
+    for (size_t i = 0; i < _count; ++i) {
+        const size_t offset = _cache.offsets[--_cache.count];
+
+        if (offset >= m_watermark || IsSlotInUse(offset)) continue;
+        if (!IsFreeSlotQueued(offset)) PushFreeSlot(offset);
+    }
+
+    m_statistics.flushes.fetch_add(1, std::memory_order_relaxed);
+    PublishThreadCache(_cache);
+}
+
+template <typename T>
+void MemoryPool<T>::PublishThreadCache(ThreadCache &_cache) noexcept {
+    m_size.fetch_add(_cache.sizeDelta, std::memory_order_relaxed);
+    m_statistics.cachedAllocations.fetch_add(_cache.allocations, std::memory_order_relaxed);
+    m_statistics.cachedDeallocations.fetch_add(_cache.deallocations, std::memory_order_relaxed);
+
+    _cache.sizeDelta = 0;
+    _cache.allocations = 0;
+    _cache.deallocations = 0;
+}
+
+template <typename T>
+size_t MemoryPool<T>::ClaimFreeSlot() {
+    ThreadCache &cache = GetThreadCache();
+
+    while (true) {
+        if (cache.count == 0 && !RefillThreadCache(cache))
+            throw std::runtime_error("No free offsets available in the memory pool.");
+
+        const size_t offset = cache.offsets[--cache.count];
+
+        // The offset may have been shrunk away or claimed meanwhile through AllocateAt or a stale cache.
+        if (offset >= m_watermark || !ClaimSlot(offset)) continue;
+
+        cache.sizeDelta++;
+        cache.allocations++;
+
+        return offset;
+    }
+}
+
+template <typename T>
+typename MemoryPool<T>::ThreadCache &MemoryPool<T>::CacheFreeSlot(size_t _offset) noexcept {
+    ThreadCache &cache = GetThreadCache();
+
+    if (cache.count == c_threadCacheSize) FlushThreadCache(cache, c_threadCacheSize / 2);
+
+    cache.offsets[cache.count++] = _offset;
+
+    return cache;
+}
+
+template <typename T>
+void MemoryPool<T>::AbandonFreeSlot(size_t _offset) noexcept {
+    ReleaseSlot(_offset);
+
+    CacheFreeSlot(_offset).sizeDelta--;
 }
 
 }  // namespace Rake::libraries
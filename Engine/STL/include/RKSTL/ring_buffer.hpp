@@ -0,0 +1,260 @@
+#pragma once
+
+#include <bit>
+#include <new>
+#include <span>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A bounded wait-free single-producer/single-consumer FIFO ring buffer.
+ *
+ * The capacity is rounded up to a power of two so that free-running indices map to slots with a mask. The producer
+ * owns the tail and the consumer the head, each on its own cache line together with a cached copy of the opposite
+ * index: a side only reloads the other index, and pulls its cache line, when its cached copy says the buffer is full
+ * (producer) or empty (consumer). Bulk operations move a whole span with a single index publication.
+ *
+ * @tparam T The element type, it must be nothrow move constructible.
+ *
+ * @multithreading One producer thread may call the Push functions while one consumer thread calls the Pop functions
+ * and Front, without locks. size and empty are only hints when read by a third thread.
+ */
+template <typename T>
+class SPSCRingBuffer final : public NonCopyable {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "SPSCRingBuffer elements must be nothrow movable");
+
+   private:
+    static constexpr size_t c_cacheLineSize = 64;
+
+    // Written by the producer, read by the consumer when its cached tail runs dry.
+    alignas(c_cacheLineSize) std::atomic<size_t> m_tail = 0;
+    size_t m_cachedHead = 0;
+
+    // Written by the consumer, read by the producer when its cached head says the buffer is full.
+    alignas(c_cacheLineSize) std::atomic<size_t> m_head = 0;
+    size_t m_cachedTail = 0;
+
+    // Read-only after construction, shared by both sides without bouncing.
+    alignas(c_cacheLineSize) T *m_buffer = nullptr;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+
+   public:
+    /**
+     * @brief Constructs a SPSCRingBuffer.
+     *
+     * @param _capacity The number of elements the buffer holds, rounded up to a power of two.
+     * @throw std::invalid_argument If the capacity is zero.
+     */
+    explicit SPSCRingBuffer(size_t _capacity);
+
+    ~SPSCRingBuffer();
+
+   public:
+    /**
+     * @brief Constructs an element at the back of the buffer.
+     *
+     * @return bool False if the buffer is full.
+     */
+    template <typename... Args>
+    bool TryEmplace(Args &&..._args);
+
+    bool TryPush(const T &_value) { return TryEmplace(_value); }
+
+    bool TryPush(T &&_value) { return TryEmplace(std::move(_value)); }
+
+    /**
+     * @brief Copies as many elements of a span as fit at the back of the buffer, publishing them at once.
+     *
+     * @return size_t The number of elements pushed, from the front of the span.
+     */
+    size_t PushBulk(std::span<const T> _values);
+
+    /**
+     * @brief Moves the front element out of the buffer.
+     *
+     * @return bool False if the buffer is empty.
+     */
+    bool TryPop(T &_value) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    /**
+     * @brief Moves up to _values.size() elements out of the buffer, releasing their slots at once.
+     *
+     * @return size_t The number of elements popped, written to the front of the span.
+     */
+    size_t PopBulk(std::span<T> _values) noexcept(std::is_nothrow_move_assignable_v<T>);
+
+    /**
+     * @brief Gets the front element without popping it.
+     *
+     * @return T* The element, or nullptr if the buffer is empty.
+     */
+    NODISCARD T *Front() noexcept;
+
+    NODISCARD inline size_t size() const noexcept {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+
+        return tail >= head ? tail - head : 0;
+    }
+
+    NODISCARD inline bool empty() const noexcept { return size() == 0; }
+
+    NODISCARD inline size_t capacity() const noexcept { return m_capacity; }
+
+   private:
+    NODISCARD size_t AvailableToPush(size_t _tail, size_t _wanted) noexcept;
+    NODISCARD size_t AvailableToPop(size_t _head, size_t _wanted) noexcept;
+};
+
+template <typename T>
+SPSCRingBuffer<T>::SPSCRingBuffer(size_t _capacity) {
+    if (_capacity == 0) throw std::invalid_argument("SPSCRingBuffer capacity must be greater than zero");
+
+    m_capacity = std::bit_ceil(_capacity);
+    m_mask = m_capacity - 1;
+    m_buffer = static_cast<T *>(::operator new(m_capacity * sizeof(T), std::align_val_t(alignof(T))));
+}
+
+template <typename T>
+SPSCRingBuffer<T>::~SPSCRingBuffer() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        for (size_t i = m_head.load(std::memory_order_relaxed); i < tail; ++i) std::destroy_at(&m_buffer[i & m_mask]);
+    }
+
+    ::operator delete(m_buffer, std::align_val_t(alignof(T)));
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::AvailableToPush(size_t _tail, size_t _wanted) noexcept {
+    size_t available = m_capacity - (_tail - m_cachedHead);
+
+    if (available < _wanted) {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        available = m_capacity - (_tail - m_cachedHead);
+    }
+
+    return std::min(available, _wanted);
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::AvailableToPop(size_t _head, size_t _wanted) noexcept {
+    size_t available = m_cachedTail - _head;
+
+    if (available < _wanted) {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        available = m_cachedTail - _head;
+    }
+
+    return std::min(available, _wanted);
+}
+
+template <typename T>
+template <typename... Args>
+bool SPSCRingBuffer<T>::TryEmplace(Args &&..._args) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if (AvailableToPush(tail, 1) == 0) return false;
+
+    std::construct_at(&m_buffer[tail & m_mask], std::forward<Args>(_args)...);
+
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::PushBulk(std::span<const T> _values) {
+    const size_t tail = m_tail.load(std::memory_order_relaxed);
+    const size_t count = AvailableToPush(tail, _values.size());
+
+    if (count == 0) return 0;
+
+    // The free slots wrap around the end of the buffer at most once.
+    const size_t first = tail & m_mask;
+    const size_t firstCount = std::min(count, m_capacity - first);
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memcpy(m_buffer + first, _values.data(), firstCount * sizeof(T));
+        std::memcpy(m_buffer, _values.data() + firstCount, (count - firstCount) * sizeof(T));
+    } else {
+        T *constructed = std::uninitialized_copy_n(_values.data(), firstCount, m_buffer + first);
+
+        try {
+            std::uninitialized_copy_n(_values.data() + firstCount, count - firstCount, m_buffer);
+        } catch (...) {
+            std::destroy(m_buffer + first, constructed);
+            throw;
+        }
+    }
+
+    m_tail.store(tail + count, std::memory_order_release);
+
+    return count;
+}
+
+template <typename T>
+bool SPSCRingBuffer<T>::TryPop(T &_value) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+
+    if (AvailableToPop(head, 1) == 0) return false;
+
+    T &slot = m_buffer[head & m_mask];
+
+    _value = std::move(slot);
+    std::destroy_at(&slot);
+
+    m_head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+template <typename T>
+size_t SPSCRingBuffer<T>::PopBulk(std::span<T> _values) noexcept(std::is_nothrow_move_assignable_v<T>) {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+    const size_t count = AvailableToPop(head, _values.size());
+
+    if (count == 0) return 0;
+
+    const size_t first = head & m_mask;
+    const size_t firstCount = std::min(count, m_capacity - first);
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memcpy(_values.data(), m_buffer + first, firstCount * sizeof(T));
+        std::memcpy(_values.data() + firstCount, m_buffer, (count - firstCount) * sizeof(T));
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            T &slot = m_buffer[(head + i) & m_mask];
+
+            _values[i] = std::move(slot);
+            std::destroy_at(&slot);
+        }
+    }
+
+    m_head.store(head + count, std::memory_order_release);
+
+    return count;
+}
+
+template <typename T>
+T *SPSCRingBuffer<T>::Front() noexcept {
+    const size_t head = m_head.load(std::memory_order_relaxed);
+
+    if (AvailableToPop(head, 1) == 0) return nullptr;
+
+    return &m_buffer[head & m_mask];
+}
+
+}  // namespace Rake::libraries
@@ -0,0 +1,468 @@
+#pragma once
+
+#include <bit>
+#include <new>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+
+#include "defines.hpp"
+#include "memory_tracker.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A size-class slab allocator for small, short-lived objects.
+ *
+ * Requests are rounded up to a power-of-two size class between c_minBlockSize and c_maxBlockSize bytes. Each class
+ * carves its blocks out of fixed-size slabs and keeps the free ones in an intrusive free list, so a block is
+ * naturally aligned to its size and allocating or releasing it never touches the global heap. Requests above
+ * c_maxBlockSize fall back to the aligned global operator new.
+ *
+ * Allocate and Deallocate go through a per-thread cache of free blocks for every class and only take the class lock
+ * to move a batch of blocks between the cache and the shared free list. Each thread has a few cache slots shared by
+ * every allocator, an allocator taking over a slot or a thread exiting returns the cached blocks to the free lists of
+ * the allocator that owns them, so they never stay out of reach for the rest of a session.
+ *
+ * Release returns every slab at once, which makes tearing down a whole subsystem allocation set O(slabs).
+ *
+ * Live block and allocation counts are kept per thread cache and only added to their class when the cache refills,
+ * flushes or is returned, so the fast path writes no shared state. GetStatistics sees the counts of the calling
+ * thread at once and those of other threads once their caches reach the classes.
+ *
+ * @multithreading Allocate, Deallocate and GetStatistics are thread-safe. Release must not run concurrently with
+ * other operations on the same allocator.
+ */
+class SlabAllocator final : public NonCopyable {
+   public:
+    static constexpr size_t c_minBlockSize = 8;
+    static constexpr size_t c_maxBlockSize = 1024;
+    static constexpr size_t c_sizeClassCount = std::countr_zero(c_maxBlockSize) - std::countr_zero(c_minBlockSize) + 1;
+
+    /**
+     * @brief Occupancy of a size class.
+     */
+    struct SizeClassStatistics {
+        size_t blockSize = 0;   /**< Size of the blocks of the class in bytes. */
+        size_t slabCount = 0;   /**< Number of slabs carved for the class. */
+        size_t totalBlocks = 0; /**< Number of blocks carved for the class. */
+        size_t liveBlocks = 0;  /**< Number of blocks currently allocated. */
+        size_t allocations = 0; /**< Number of blocks allocated since the last Release. */
+    };
+
+   private:
+    static constexpr size_t c_slabSize = RK_KIBIBYTES(64);
+    static constexpr size_t c_threadCacheSize = 64;
+    static constexpr size_t c_threadCacheSlots = 8;
+
+    struct FreeBlock {
+        FreeBlock *next;
+    };
+
+    /**
+     * @brief Link from the thread caches to their allocator, unbound when the allocator is destroyed.
+     */
+    struct CacheOwner {
+        std::mutex mutex;
+        SlabAllocator *allocator;
+
+        explicit CacheOwner(SlabAllocator *_allocator) : allocator(_allocator) {}
+    };
+
+    // An allocator id of 0 is never issued, it marks an unbound cache.
+    struct ThreadCache {
+        uint64_t allocatorId = 0;
+        uint32_t epoch = 0;
+        std::weak_ptr<CacheOwner> owner;
+        FreeBlock *blocks[c_sizeClassCount] = {};
+        size_t counts[c_sizeClassCount] = {};
+        ptrdiff_t liveBlocks[c_sizeClassCount] = {}; /**< Blocks handed out minus returned, not yet published. */
+        size_t allocations[c_sizeClassCount] = {};   /**< Blocks handed out, not yet published. */
+
+        ~ThreadCache() { ReturnThreadCache(*this); }
+    };
+
+    // Every field is guarded by the class mutex.
+    struct alignas(64) SizeClass {
+        std::mutex mutex;
+        FreeBlock *freeBlocks = nullptr;
+        std::vector<void *> slabs;
+        ptrdiff_t liveBlocks = 0;
+        size_t allocations = 0;
+    };
+
+    static inline std::atomic<uint64_t> s_nextAllocatorId = 1;
+
+    uint64_t m_id = s_nextAllocatorId.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<CacheOwner> m_owner = std::make_shared<CacheOwner>(this);
+    MemoryTag m_tag = MemoryTracker::GetCurrentTag();
+    std::atomic<uint32_t> m_epoch = 0;
+    std::atomic<size_t> m_largeBlocks = 0;
+    SizeClass m_sizeClasses[c_sizeClassCount];
+
+   public:
+    SlabAllocator() = default;
+
+    /**
+     * @brief Releases every slab.
+     */
+    ~SlabAllocator() {
+        // Caches returned from now on drop their blocks instead of touching the released slabs.
+        {
+            std::lock_guard<std::mutex> lock(m_owner->mutex);
+            m_owner->allocator = nullptr;
+        }
+
+        Release();
+    }
+
+   public:
+    /**
+     * @brief Allocates a block from the size class fitting the request.
+     *
+     * @param _size The size of the allocation in bytes.
+     * @param _alignment The alignment of the allocation, must be a power of two.
+     * @return void* A pointer to the allocated memory.
+     * @throws std::bad_alloc if a new slab cannot be allocated.
+     */
+    NODISCARD void *Allocate(size_t _size, size_t _alignment = alignof(std::max_align_t)) {
+        const size_t blockSize = GetBlockSize(_size, _alignment);
+
+        if (blockSize > c_maxBlockSize) {
+            void *ptr = ::operator new(_size, std::align_val_t(_alignment));
+
+            m_largeBlocks.fetch_add(1, std::memory_order_relaxed);
+
+            MemoryTracker::RecordAllocation(m_tag, _size);
+
+            return ptr;
+        }
+
+        const size_t sizeClass = GetSizeClass(blockSize);
+
+        ThreadCache &cache = GetThreadCache();
+
+        if (cache.counts[sizeClass] == 0) RefillThreadCache(cache, sizeClass);
+
+        FreeBlock *block = cache.blocks[sizeClass];
+
+        cache.blocks[sizeClass] = block->next;
+        cache.counts[sizeClass]--;
+        cache.liveBlocks[sizeClass]++;
+        cache.allocations[sizeClass]++;
+
+        return block;
+    }
+
+    /**
+     * @brief Returns a block to its size class.
+     *
+     * @param _ptr A pointer returned by Allocate.
+     * @param _size The size passed to Allocate.
+     * @param _alignment The alignment passed to Allocate.
+     */
+    void Deallocate(void *_ptr, size_t _size, size_t _alignment = alignof(std::max_align_t)) noexcept {
+        if (!_ptr) return;
+
+        const size_t blockSize = GetBlockSize(_size, _alignment);
+
+        if (blockSize > c_maxBlockSize) {
+            ::operator delete(_ptr, std::align_val_t(_alignment));
+
+            m_largeBlocks.fetch_sub(1, std::memory_order_relaxed);
+
+            MemoryTracker::RecordDeallocation(m_tag, _size);
+
+            return;
+        }
+
+        const size_t sizeClass = GetSizeClass(blockSize);
+
+        ThreadCache &cache = GetThreadCache();
+
+        if (cache.counts[sizeClass] == c_threadCacheSize) FlushThreadCache(cache, sizeClass, c_threadCacheSize / 2);
+
+        FreeBlock *block = static_cast<FreeBlock *>(_ptr);
+
+        block->next = cache.blocks[sizeClass];
+        cache.blocks[sizeClass] = block;
+        cache.counts[sizeClass]++;
+        cache.liveBlocks[sizeClass]--;
+    }
+
+    /**
+     * @brief Releases every slab at once, invalidating all the blocks allocated so far.
+     *
+     * @note Destructors are not run, objects still living in the allocator must be destroyed first.
+     */
+    void Release() noexcept {
+        // Serialized with the threads returning their caches, a cache checked against the old epoch would otherwise
+        // push blocks of the released slabs.
+        std::lock_guard<std::mutex> ownerLock(m_owner->mutex);
+
+        for (size_t i = 0; i < c_sizeClassCount; ++i) {
+            SizeClass &sizeClass = m_sizeClasses[i];
+
+            std::unique_lock<std::mutex> lock(sizeClass.mutex);
+
+            for (void *slab : sizeClass.slabs) {
+                ::operator delete(slab, std::align_val_t(c_maxBlockSize));
+
+                MemoryTracker::RecordDeallocation(m_tag, c_slabSize);
+            }
+
+            sizeClass.slabs.clear();
+            sizeClass.freeBlocks = nullptr;
+            sizeClass.liveBlocks = 0;
+            sizeClass.allocations = 0;
+        }
+
+        // Bumping the epoch drops the blocks cached by every thread, they point into the slabs just released.
+        m_epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the occupancy of every size class, ordered by block size.
+     */
+    NODISCARD std::array<SizeClassStatistics, c_sizeClassCount> GetStatistics() noexcept {
+        std::array<SizeClassStatistics, c_sizeClassCount> statistics;
+
+        const ThreadCache &cache = GetThreadCaches()[m_id % c_threadCacheSlots];
+        const bool ownsCache = cache.allocatorId == m_id && cache.epoch == m_epoch.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < c_sizeClassCount; ++i) {
+            SizeClass &sizeClass = m_sizeClasses[i];
+
+            std::unique_lock<std::mutex> lock(sizeClass.mutex);
+
+            const ptrdiff_t liveBlocks = sizeClass.liveBlocks + (ownsCache ? cache.liveBlocks[i] : 0);
+
+            statistics[i].blockSize = c_minBlockSize << i;
+            statistics[i].slabCount = sizeClass.slabs.size();
+            statistics[i].totalBlocks = sizeClass.slabs.size() * (c_slabSize / statistics[i].blockSize);
+            statistics[i].liveBlocks = liveBlocks > 0 ? static_cast<size_t>(liveBlocks) : 0;
+            statistics[i].allocations = sizeClass.allocations + (ownsCache ? cache.allocations[i] : 0);
+        }
+
+        return statistics;
+    }
+
+    /**
+     * @brief Gets the number of live allocations too large for any size class.
+     */
+    NODISCARD inline size_t GetLargeBlockCount() const noexcept {
+        return m_largeBlocks.load(std::memory_order_relaxed);
+    }
+
+   private:
+    /**
+     * @brief Rounds a request up to the power-of-two block size serving it.
+     */
+    NODISCARD static constexpr size_t GetBlockSize(size_t _size, size_t _alignment) noexcept {
+        return std::bit_ceil(std::max({_size, _alignment, c_minBlockSize}));
+    }
+
+    /**
+     * @brief Gets the index of the size class of a power-of-two block size.
+     */
+    NODISCARD static constexpr size_t GetSizeClass(size_t _blockSize) noexcept {
+        return std::countr_zero(_blockSize) - std::countr_zero(c_minBlockSize);
+    }
+
+    /**
+     * @brief Gets the calling thread cache for this allocator, returning the blocks left by another allocator to it
+     * and dropping the ones cached before the last Release.
+     */
+    ThreadCache &GetThreadCache() noexcept {
+        ThreadCache &cache = GetThreadCaches()[m_id % c_threadCacheSlots];
+
+        const uint32_t epoch = m_epoch.load(std::memory_order_relaxed);
+
+        if (cache.allocatorId != m_id) {
+            ReturnThreadCache(cache);
+
+            cache.allocatorId = m_id;
+            cache.epoch = epoch;
+            cache.owner = m_owner;
+        } else if (cache.epoch != epoch) {
+            cache.epoch = epoch;
+
+            ResetThreadCache(cache);
+        }
+
+        return cache;
+    }
+
+    /**
+     * @brief Gets the thread caches of the calling thread, shared by every allocator.
+     */
+    NODISCARD static inline ThreadCache *GetThreadCaches() noexcept {
+        thread_local ThreadCache caches[c_threadCacheSlots];
+
+        return caches;
+    }
+
+    /**
+     * @brief Empties a thread cache and drops its unpublished counts.
+     */
+    static void ResetThreadCache(ThreadCache &_cache) noexcept {
+        std::fill(std::begin(_cache.blocks), std::end(_cache.blocks), nullptr);
+        std::fill(std::begin(_cache.counts), std::end(_cache.counts), 0);
+        std::fill(std::begin(_cache.liveBlocks), std::end(_cache.liveBlocks), 0);
+        std::fill(std::begin(_cache.allocations), std::end(_cache.allocations), 0);
+    }
+
+    /**
+     * @brief Moves every block of a thread cache back to the free lists of the allocator that owns it and unbinds the
+     * cache, blocks of a destroyed owner or cached before its last Release are dropped.
+     */
+    static void ReturnThreadCache(ThreadCache &_cache) noexcept {
+        if (const std::shared_ptr<CacheOwner> owner = _cache.owner.lock()) {
+            std::lock_guard<std::mutex> lock(owner->mutex);
+
+            SlabAllocator *allocator = owner->allocator;
+
+            if (allocator && allocator->m_epoch.load(std::memory_order_relaxed) == _cache.epoch) {
+                for (size_t i = 0; i < c_sizeClassCount; ++i) {
+                    if (_cache.counts[i] > 0 || _cache.liveBlocks[i] != 0 || _cache.allocations[i] > 0)
+                        allocator->FlushThreadCache(_cache, i, _cache.counts[i]);
+                }
+            }
+        }
+
+        _cache.allocatorId = 0;
+        _cache.owner.reset();
+
+        ResetThreadCache(_cache);
+    }
+
+    /**
+     * @brief Moves a batch of blocks from the shared free list of a class to a thread cache, carving a new slab when
+     * the list is empty.
+     *
+     * @throws std::bad_alloc if a new slab cannot be allocated.
+     */
+    void RefillThreadCache(ThreadCache &_cache, size_t _sizeClass) {
+        SizeClass &sizeClass = m_sizeClasses[_sizeClass];
+
+        std::unique_lock<std::mutex> lock(sizeClass.mutex);
+
+        if (!sizeClass.freeBlocks) CarveSlab(sizeClass, c_minBlockSize << _sizeClass);
+
+        for (size_t i = 0; i < c_threadCacheSize / 2 && sizeClass.freeBlocks; ++i) {
+            FreeBlock *block = sizeClass.freeBlocks;
+
+            sizeClass.freeBlocks = block->next;
+            block->next = _cache.blocks[_sizeClass];
+            _cache.blocks[_sizeClass] = block;
+            _cache.counts[_sizeClass]++;
+        }
+
+        PublishThreadCache(_cache, _sizeClass);
+    }
+
+    /**
+     * @brief Moves the most recently cached blocks of a class back to the shared free list.
+     */
+    void FlushThreadCache(ThreadCache &_cache, size_t _sizeClass, size_t _count) noexcept {
+        SizeClass &sizeClass = m_sizeClasses[_sizeClass];
+
+        std::unique_lock<std::mutex> lock(sizeClass.mutex);
+
+        for (size_t i = 0; i < _count; ++i) {
+            FreeBlock *block = _cache.blocks[_sizeClass];
+
+            _cache.blocks[_sizeClass] = block->next;
+            _cache.counts[_sizeClass]--;
+            block->next = sizeClass.freeBlocks;
+            sizeClass.freeBlocks = block;
+        }
+
+        PublishThreadCache(_cache, _sizeClass);
+    }
+
+    /**
+     * @brief Adds the counts a thread cache kept for a class to the class, the class lock must be held.
+     */
+    void PublishThreadCache(ThreadCache &_cache, size_t _sizeClass) noexcept {
+        SizeClass &sizeClass = m_sizeClasses[_sizeClass];
+
+        sizeClass.liveBlocks += std::exchange(_cache.liveBlocks[_sizeClass], 0);
+        sizeClass.allocations += std::exchange(_cache.allocations[_sizeClass], 0);
+    }
+
+    /**
+     * @brief Allocates a slab and threads its blocks on the shared free list of a class, the class lock must be held.
+     *
+     * @throws std::bad_alloc if the slab cannot be allocated.
+     */
+    void CarveSlab(SizeClass &_sizeClass, size_t _blockSize) {
+        std::byte *slab = static_cast<std::byte *>(::operator new(c_slabSize, std::align_val_t(c_maxBlockSize)));
+
+        _sizeClass.slabs.push_back(slab);
+
+        MemoryTracker::RecordAllocation(m_tag, c_slabSize);
+
+        for (size_t offset = c_slabSize; offset >= _blockSize; offset -= _blockSize) {
+            FreeBlock *block = reinterpret_cast<FreeBlock *>(slab + offset - _blockSize);
+
+            block->next = _sizeClass.freeBlocks;
+            _sizeClass.freeBlocks = block;
+        }
+    }
+};
+
+/**
+ * @brief Standard allocator routing a container or allocate_shared through a SlabAllocator.
+ *
+ * @tparam T The type of elements to allocate.
+ */
+template <typename T>
+class SlabStlAllocator {
+    template <typename U>
+    friend class SlabStlAllocator;
+
+   public:
+    using value_type = T;
+
+   private:
+    SlabAllocator *m_slab;
+
+   public:
+    /**
+     * @brief Constructs a SlabStlAllocator.
+     *
+     * @param _slab The slab allocator to allocate from, it must outlive every allocation.
+     */
+    SlabStlAllocator(SlabAllocator &_slab) noexcept : m_slab(&_slab) {}
+
+    /**
+     * @brief Rebinding constructor used by std::allocator_traits.
+     */
+    template <typename U>
+    SlabStlAllocator(const SlabStlAllocator<U> &_other) noexcept : m_slab(_other.m_slab) {}
+
+   public:
+    NODISCARD T *allocate(size_t _count) {
+        if (_count > std::numeric_limits<size_t>::max() / sizeof(T)) throw std::bad_array_new_length();
+
+        return static_cast<T *>(m_slab->Allocate(_count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *_ptr, size_t _count) noexcept { m_slab->Deallocate(_ptr, _count * sizeof(T), alignof(T)); }
+
+    template <typename U>
+    NODISCARD bool operator==(const SlabStlAllocator<U> &_other) const noexcept {
+        return m_slab == _other.m_slab;
+    }
+};
+
+}  // namespace Rake::libraries
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A container handing out stable versioned keys to values stored contiguously.
+ *
+ * Values live in a dense array without gaps, so iterating them walks a plain array. A key names a slot of an
+ * indirection table that stores the position of the value in the dense array and a generation bumped every time the
+ * slot is released, so resolving a key is two array lookups and a stale key resolves to nullptr instead of aliasing
+ * the value that reused its slot. Erasing moves the last value into the hole and patches its slot, keys to the moved
+ * value stay valid but pointers and references to it do not.
+ *
+ * Released slots are recycled in LIFO order. A slot generation wraps around after 2^32 releases, at which point a
+ * key that old could alias a live value again.
+ *
+ * @tparam T The value type, must be move assignable.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename T>
+class SlotMap {
+   private:
+    static constexpr uint32_t c_invalidIndex = std::numeric_limits<uint32_t>::max();
+
+   public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    /**
+     * @brief Versioned reference to a value that stays valid until the value is erased.
+     */
+    struct Key {
+        uint32_t index = c_invalidIndex; /**< Slot of the indirection table. */
+        uint32_t generation = 0;         /**< Generation of the slot when the key was issued. */
+
+        NODISCARD inline bool IsNull() const noexcept { return index == c_invalidIndex; }
+
+        bool operator==(const Key &_other) const noexcept = default;
+    };
+
+   private:
+    struct Slot {
+        uint32_t denseIndex = c_invalidIndex; /**< Position of the value, or the next free slot once released. */
+        uint32_t generation = 0;
+    };
+
+    std::vector<T> m_values;
+    std::vector<uint32_t> m_valueSlots;
+    std::vector<Slot> m_slots;
+    uint32_t m_freeSlot = c_invalidIndex;
+
+   public:
+    SlotMap() = default;
+
+   public:
+    /**
+     * @brief Constructs a value at the end of the dense array.
+     *
+     * @return Key The key of the new value.
+     * @throw std::length_error If every key has been handed out.
+     */
+    template <typename... Args>
+    Key Emplace(Args &&..._args);
+
+    Key Insert(const T &_value) { return Emplace(_value); }
+
+    Key Insert(T &&_value) { return Emplace(std::move(_value)); }
+
+    /**
+     * @brief Erases the value referenced by a key, moving the last value of the dense array into its position.
+     *
+     * @param _key The key to erase, every copy of it resolves to nullptr afterwards.
+     * @return bool True if a value was erased, false if the key was null or stale.
+     */
+    bool Erase(Key _key);
+
+    /**
+     * @brief Resolves a key to its value in O(1).
+     *
+     * @return T* A pointer to the value, or nullptr if the key is null or stale.
+     */
+    NODISCARD inline T *Find(Key _key) noexcept {
+        const uint32_t denseIndex = GetDenseIndex(_key);
+
+        return denseIndex != c_invalidIndex ? &m_values[denseIndex] : nullptr;
+    }
+
+    NODISCARD inline const T *Find(Key _key) const noexcept { return const_cast<SlotMap *>(this)->Find(_key); }
+
+    NODISCARD inline bool Contains(Key _key) const noexcept { return GetDenseIndex(_key) != c_invalidIndex; }
+
+    /**
+     * @brief Resolves a key to its value.
+     *
+     * @throw std::out_of_range If the key is null or stale.
+     */
+    NODISCARD T &At(Key _key) {
+        T *value = Find(_key);
+
+        if (value == nullptr) throw std::out_of_range("SlotMap key is null or stale");
+
+        return *value;
+    }
+
+    NODISCARD const T &At(Key _key) const { return const_cast<SlotMap *>(this)->At(_key); }
+
+    /**
+     * @brief Gets the key of the value at a position of the dense array, to erase values while iterating.
+     */
+    NODISCARD inline Key GetKey(size_t _denseIndex) const noexcept {
+        const uint32_t slotIndex = m_valueSlots[_denseIndex];
+
+        return Key{slotIndex, m_slots[slotIndex].generation};
+    }
+
+    /**
+     * @brief Erases every value, every key handed out so far becomes stale.
+     */
+    void Clear() noexcept;
+
+    void Reserve(size_t _capacity) {
+        m_values.reserve(_capacity);
+        m_valueSlots.reserve(_capacity);
+        m_slots.reserve(_capacity);
+    }
+
+    NODISCARD inline T *data() noexcept { return m_values.data(); }
+    NODISCARD inline const T *data() const noexcept { return m_values.data(); }
+    NODISCARD inline iterator begin() noexcept { return m_values.data(); }
+    NODISCARD inline iterator end() noexcept { return m_values.data() + m_values.size(); }
+    NODISCARD inline const_iterator begin() const noexcept { return m_values.data(); }
+    NODISCARD inline const_iterator end() const noexcept { return m_values.data() + m_values.size(); }
+
+    NODISCARD inline size_t size() const noexcept { return m_values.size(); }
+    NODISCARD inline bool empty() const noexcept { return m_values.empty(); }
+    NODISCARD inline size_t capacity() const noexcept { return m_values.capacity(); }
+
+   private:
+    NODISCARD inline uint32_t GetDenseIndex(Key _key) const noexcept {
+        if (_key.index >= m_slots.size()) return c_invalidIndex;
+
+        const Slot &slot = m_slots[_key.index];
+
+        // Releasing a slot bumps its generation, so a matching generation means the slot is live.
+        return slot.generation == _key.generation ? slot.denseIndex : c_invalidIndex;
+    }
+
+    /**
+     * @brief Pushes a released slot on the free list, invalidating the keys to it.
+     */
+    inline void ReleaseSlot(uint32_t _slotIndex) noexcept {
+        Slot &slot = m_slots[_slotIndex];
+
+        slot.generation++;
+        slot.denseIndex = m_freeSlot;
+        m_freeSlot = _slotIndex;
+    }
+};
+
+template <typename T>
+template <typename... Args>
+typename SlotMap<T>::Key SlotMap<T>::Emplace(Args &&..._args) {
+    // A new slot is pushed on the free list first, so a throwing constructor leaves it there instead of leaking it.
+    if (m_freeSlot == c_invalidIndex) {
+        if (m_slots.size() >= c_invalidIndex) throw std::length_error("SlotMap ran out of keys");
+
+        m_slots.push_back(Slot{});
+        m_freeSlot = static_cast<uint32_t>(m_slots.size() - 1);
+    }
+
+    m_valueSlots.push_back(m_freeSlot);
+
+    try {
+        m_values.emplace_back(std::forward<Args>(_args)...);
+    } catch (...) {
+        m_valueSlots.pop_back();
+        throw;
+    }
+
+    const uint32_t slotIndex = m_freeSlot;
+    Slot &slot = m_slots[slotIndex];
+
+    m_freeSlot = slot.denseIndex;
+    slot.denseIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+    return Key{slotIndex, slot.generation};
+}
+
+template <typename T>
+bool SlotMap<T>::Erase(Key _key) {
+    const uint32_t denseIndex = GetDenseIndex(_key);
+
+    if (denseIndex == c_invalidIndex) return false;
+
+    const uint32_t lastIndex = static_cast<uint32_t>(m_values.size() - 1);
+
+    if (denseIndex != lastIndex) {
+        m_values[denseIndex] = std::move(m_values[lastIndex]);
+        m_valueSlots[denseIndex] = m_valueSlots[lastIndex];
+        m_slots[m_valueSlots[denseIndex]].denseIndex = denseIndex;
+    }
+
+    m_values.pop_back();
+    m_valueSlots.pop_back();
+
+    ReleaseSlot(_key.index);
+
+    return true;
+}
+
+template <typename T>
+void SlotMap<T>::Clear() noexcept {
+    for (uint32_t slotIndex : m_valueSlots) ReleaseSlot(slotIndex);
+
+    m_values.clear();
+    m_valueSlots.clear();
+}
+
+}  // namespace Rake::libraries
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief Whether objects of type T can be moved to another address with a plain memcpy, leaving nothing to destroy at
+ * the old address.
+ *
+ * True for trivially copyable types. Only specialize it for types that never point into their own storage, such as
+ * std::unique_ptr or std::shared_ptr. Owning a heap buffer is not enough: types keeping small values inline behind a
+ * pointer to themselves, like the libstdc++ std::string or SmallVector itself, are left dangling by a memcpy.
+ */
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+/**
+ * @brief A contiguous growable array storing up to N elements inline, without allocating.
+ *
+ * While the size stays within N the elements live inside the object itself, so short lists embedded in other objects
+ * (graph links, handler lists, name lists) cost no allocation and no pointer chase. Past N the elements move to a
+ * heap buffer growing geometrically, like std::vector. Growing relocates the elements with memcpy when
+ * IsTriviallyRelocatable holds, otherwise by moving them (copying them if their move constructor may throw).
+ *
+ * Moving a SmallVector steals its heap buffer but has to relocate inline elements, so it is O(N) at worst.
+ *
+ * @tparam T The element type.
+ * @tparam N The number of elements stored inline.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs an inline capacity of at least one element");
+
+   public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+   private:
+    T *m_data;
+    size_t m_size = 0;
+    size_t m_capacity = N;
+
+    alignas(T) std::byte m_inline[N * sizeof(T)];
+
+   public:
+    SmallVector() noexcept : m_data(GetInlineData()) {}
+
+    explicit SmallVector(size_t _count) : SmallVector() { Resize(_count); }
+
+    SmallVector(size_t _count, const T &_value) : SmallVector() { Resize(_count, _value); }
+
+    template <std::input_iterator InputIt>
+    SmallVector(InputIt _first, InputIt _last) : SmallVector() {
+        Append(_first, _last);
+    }
+
+    SmallVector(std::initializer_list<T> _values) : SmallVector() { Append(_values.begin(), _values.end()); }
+
+    SmallVector(const SmallVector &_other) : SmallVector() { Append(_other.begin(), _other.end()); }
+
+    template <size_t M>
+    SmallVector(const SmallVector<T, M> &_other) : SmallVector() {
+        Append(_other.begin(), _other.end());
+    }
+
+    SmallVector(SmallVector &&_other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+        TakeElements(_other);
+    }
+
+    SmallVector &operator=(const SmallVector &_other) {
+        if (this != &_other) Assign(_other.begin(), _other.end());
+
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&_other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &_other) {
+            Clear();
+            ReleaseBuffer();
+            TakeElements(_other);
+        }
+
+        return *this;
+    }
+
+    SmallVector &operator=(std::initializer_list<T> _values) {
+        Assign(_values.begin(), _values.end());
+        return *this;
+    }
+
+    ~SmallVector() {
+        Clear();
+        ReleaseBuffer();
+    }
+
+   public:
+    /**
+     * @brief Constructs an element at the end of the vector.
+     *
+     * The arguments may refer to an element of the vector itself, the new element is built before relocating.
+     *
+     * @return T& The new element.
+     */
+    template <typename... Args>
+    T &EmplaceBack(Args &&..._args);
+
+    void PushBack(const T &_value) { EmplaceBack(_value); }
+
+    void PushBack(T &&_value) { EmplaceBack(std::move(_value)); }
+
+    void PopBack() noexcept { std::destroy_at(m_data + --m_size); }
+
+    /**
+     * @brief Constructs an element before _position, shifting the following elements up.
+     *
+     * @return iterator The new element.
+     */
+    template <typename... Args>
+    iterator Emplace(const_iterator _position, Args &&..._args);
+
+    iterator Insert(const_iterator _position, const T &_value) { return Emplace(_position, _value); }
+
+    iterator Insert(const_iterator _position, T &&_value) { return Emplace(_position, std::move(_value)); }
+
+    /**
+     * @brief Erases the elements in [_first, _last), shifting the following elements down.
+     *
+     * @return iterator The element following the erased ones.
+     */
+    iterator Erase(const_iterator _first, const_iterator _last);
+
+    iterator Erase(const_iterator _position) { return Erase(_position, _position + 1); }
+
+    /**
+     * @brief Appends the elements of a range.
+     */
+    template <std::input_iterator InputIt>
+    void Append(InputIt _first, InputIt _last);
+
+    /**
+     * @brief Replaces the content with the elements of a range.
+     */
+    template <std::input_iterator InputIt>
+    void Assign(InputIt _first, InputIt _last) {
+        Clear();
+        Append(_first, _last);
+    }
+
+    /**
+     * @brief Destroys every element, keeping the current buffer.
+     */
+    void Clear() noexcept {
+        std::destroy(m_data, m_data + m_size);
+        m_size = 0;
+    }
+
+    /**
+     * @brief Makes room for _capacity elements without reallocating.
+     */
+    void Reserve(size_t _capacity) {
+        if (_capacity > m_capacity) Reallocate(_capacity);
+    }
+
+    void Resize(size_t _count) { ResizeWith(_count, [](T *_slot) { std::construct_at(_slot); }); }
+
+    void Resize(size_t _count, const T &_value) {
+        ResizeWith(_count, [&_value](T *_slot) { std::construct_at(_slot, _value); });
+    }
+
+    /**
+     * @brief Releases unused heap capacity, moving the elements back inline if they fit.
+     */
+    void ShrinkToFit() {
+        if (!IsInline() && m_size < m_capacity) Reallocate(m_size);
+    }
+
+    void Swap(SmallVector &_other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        SmallVector temporary(std::move(_other));
+        _other = std::move(*this);
+        *this = std::move(temporary);
+    }
+
+    NODISCARD T &At(size_t _index) {
+        if (_index >= m_size) throw std::out_of_range("SmallVector index out of range");
+
+        return m_data[_index];
+    }
+
+    NODISCARD const T &At(size_t _index) const {
+        if (_index >= m_size) throw std::out_of_range("SmallVector index out of range");
+
+        return m_data[_index];
+    }
+
+    NODISCARD inline T &operator[](size_t _index) noexcept { return m_data[_index]; }
+
+    NODISCARD inline const T &operator[](size_t _index) const noexcept { return m_data[_index]; }
+
+    NODISCARD inline T &Front() noexcept { return m_data[0]; }
+
+    NODISCARD inline const T &Front() const noexcept { return m_data[0]; }
+
+    NODISCARD inline T &Back() noexcept { return m_data[m_size - 1]; }
+
+    NODISCARD inline const T &Back() const noexcept { return m_data[m_size - 1]; }
+
+    template <size_t M>
+    NODISCARD bool operator==(const SmallVector<T, M> &_other) const {
+        return std::equal(begin(), end(), _other.begin(), _other.end());
+    }
+
+    NODISCARD inline T *data() noexcept { return m_data; }
+
+    NODISCARD inline const T *data() const noexcept { return m_data; }
+
+    NODISCARD inline iterator begin() noexcept { return m_data; }
+
+    NODISCARD inline const_iterator begin() const noexcept { return m_data; }
+
+    NODISCARD inline iterator end() noexcept { return m_data + m_size; }
+
+    NODISCARD inline const_iterator end() const noexcept { return m_data + m_size; }
+
+    NODISCARD inline size_t size() const noexcept { return m_size; }
+
+    NODISCARD inline bool empty() const noexcept { return m_size == 0; }
+
+    NODISCARD inline size_t capacity() const noexcept { return m_capacity; }
+
+    /**
+     * @brief Checks whether the elements are stored inline, that is whether the vector owns no heap buffer.
+     */
+    NODISCARD inline bool IsInline() const noexcept { return m_data == GetInlineData(); }
+
+    NODISCARD static constexpr size_t GetInlineCapacity() noexcept { return N; }
+
+   private:
+    NODISCARD inline T *GetInlineData() noexcept { return reinterpret_cast<T *>(m_inline); }
+
+    NODISCARD inline const T *GetInlineData() const noexcept { return reinterpret_cast<const T *>(m_inline); }
+
+    NODISCARD static T *AllocateBuffer(size_t _capacity) {
+        return static_cast<T *>(::operator new(_capacity * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    static void FreeBuffer(T *_buffer) noexcept { ::operator delete(_buffer, std::align_val_t(alignof(T))); }
+
+    void ReleaseBuffer() noexcept {
+        if (!IsInline()) FreeBuffer(m_data);
+
+        m_data = GetInlineData();
+        m_capacity = N;
+    }
+
+    NODISCARD size_t GetGrownCapacity(size_t _required) const noexcept { return std::max(m_capacity * 2, _required); }
+
+    /**
+     * @brief Moves _count elements to uninitialized storage and ends the lifetime of the sources.
+     */
+    static void Relocate(T *_source, size_t _count, T *_destination) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    /**
+     * @brief Moves the elements to a buffer of _capacity elements, the inline storage if they fit.
+     */
+    void Reallocate(size_t _capacity);
+
+    /**
+     * @brief Takes the elements of an empty-handed vector, stealing its heap buffer if it has one.
+     */
+    void TakeElements(SmallVector &_other) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+    template <typename Construct>
+    void ResizeWith(size_t _count, Construct &&_construct);
+};
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Relocate(T *_source, size_t _count, T *_destination) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        if (_count) std::memcpy(static_cast<void *>(_destination), static_cast<void *>(_source), _count * sizeof(T));
+    } else {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(_source, _count, _destination);
+        } else {
+            // A throwing move could leave both copies half moved, copying keeps the sources intact until it succeeds.
+            std::uninitialized_copy_n(_source, _count, _destination);
+        }
+
+        std::destroy_n(_source, _count);
+    }
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::Reallocate(size_t _capacity) {
+    T *buffer = _capacity <= N ? GetInlineData() : AllocateBuffer(_capacity);
+
+    if (buffer == m_data) return;
+
+    try {
+        Relocate(m_data, m_size, buffer);
+    } catch (...) {
+        if (buffer != GetInlineData()) FreeBuffer(buffer);
+        throw;
+    }
+
+    if (!IsInline()) FreeBuffer(m_data);
+
+    m_data = buffer;
+    m_capacity = std::max(_capacity, N);
+}
+
+template <typename T, size_t N>
+void SmallVector<T, N>::TakeElements(SmallVector &_other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (_other.IsInline()) {
+        Relocate(_other.m_data, _other.m_size, m_data);
+    } else {
+        m_data = _other.m_data;
+        m_capacity = _other.m_capacity;
+
+        _other.m_data = _other.GetInlineData();
+        _other.m_capacity = N;
+    }
+
+    m_size = std::exchange(_other.m_size, 0);
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+T &SmallVector<T, N>::EmplaceBack(Args &&..._args) {
+    if (m_size < m_capacity) {
+        std::construct_at(m_data + m_size, std::forward<Args>(_args)...);
+        return m_data[m_size++];
+    }
+
+    // Build the new element in the grown buffer first, the arguments may refer to the current elements.
+    const size_t capacity = GetGrownCapacity(m_size + 1);
+    T *buffer = AllocateBuffer(capacity);
+
+    try {
+        std::construct_at(buffer + m_size, std::forward<Args>(_args)...);
+    } catch (...) {
+        FreeBuffer(buffer);
+        throw;
+    }
+
+    try {
+        Relocate(m_data, m_size, buffer);
+    } catch (...) {
+        std::destroy_at(buffer + m_size);
+        FreeBuffer(buffer);
+        throw;
+    }
+
+    if (!IsInline()) FreeBuffer(m_data);
+
+    m_data = buffer;
+    m_capacity = capacity;
+
+    return m_data[m_size++];
+}
+
+template <typename T, size_t N>
+template <typename... Args>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::Emplace(const_iterator _position, Args &&..._args) {
+    const size_t index = static_cast<size_t>(_position - m_data);
+
+    EmplaceBack(std::forward<Args>(_args)...);
+
+    std::rotate(m_data + index, m_data + m_size - 1, m_data + m_size);
+
+    return m_data + index;
+}
+
+template <typename T, size_t N>
+typename SmallVector<T, N>::iterator SmallVector<T, N>::Erase(const_iterator _first, const_iterator _last) {
+    T *first = m_data + (_first - m_data);
+    T *last = m_data + (_last - m_data);
+
+    if (first == last) return first;
+
+    T *newEnd = std::move(last, end(), first);
+
+    std::destroy(newEnd, end());
+    m_size = static_cast<size_t>(newEnd - m_data);
+
+    return first;
+}
+
+template <typename T, size_t N>
+template <std::input_iterator InputIt>
+void SmallVector<T, N>::Append(InputIt _first, InputIt _last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+        const size_t count = static_cast<size_t>(std::distance(_first, _last));
+
+        if (m_size + count <= m_capacity) {
+            std::uninitialized_copy(_first, _last, m_data + m_size);
+            m_size += count;
+            return;
+        }
+
+        // Copy the range into the grown buffer first, as EmplaceBack does, the range may be part of this vector.
+        const size_t capacity = GetGrownCapacity(m_size + count);
+        T *buffer = AllocateBuffer(capacity);
+
+        try {
+            std::uninitialized_copy(_first, _last, buffer + m_size);
+        } catch (...) {
+            FreeBuffer(buffer);
+            throw;
+        }
+
+        try {
+            Relocate(m_data, m_size, buffer);
+        } catch (...) {
+            std::destroy_n(buffer + m_size, count);
+            FreeBuffer(buffer);
+            throw;
+        }
+
+        if (!IsInline()) FreeBuffer(m_data);
+
+        m_data = buffer;
+        m_capacity = capacity;
+        m_size += count;
+    } else {
+        for (; _first != _last; ++_first) EmplaceBack(*_first);
+    }
+}
+
+template <typename T, size_t N>
+template <typename Construct>
+void SmallVector<T, N>::ResizeWith(size_t _count, Construct &&_construct) {
+    if (_count <= m_size) {
+        std::destroy(m_data + _count, m_data + m_size);
+        m_size = _count;
+        return;
+    }
+
+    Reserve(_count);
+
+    for (; m_size < _count; ++m_size) _construct(m_data + m_size);
+}
+
+}  // namespace Rake::libraries
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <algorithm>
+#include <stdexcept>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A set of integer identifiers with O(1) insertion, removal and lookup and contiguous iteration.
+ *
+ * The identifiers are packed in a dense array, while a sparse array indexed by identifier stores the position of each
+ * one in the dense array. Removal moves the last identifier into the hole, so the dense array never has gaps and
+ * iterating the set walks a plain array whatever identifiers were removed. The order of the dense array is therefore
+ * not the insertion order.
+ *
+ * The sparse array is split in pages allocated on first use, so a few large identifiers do not allocate the whole
+ * range below them.
+ *
+ * @tparam Index The unsigned integer type of the identifiers, its maximum value is reserved.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <std::unsigned_integral Index = uint32_t>
+class SparseSet {
+   public:
+    using value_type = Index;
+    using size_type = size_t;
+    using iterator = const Index *;
+    using const_iterator = const Index *;
+
+    static constexpr Index c_invalidIndex = std::numeric_limits<Index>::max();
+
+   private:
+    static constexpr size_t c_pageSize = 1024;
+
+    std::vector<Index> m_dense;
+    std::vector<std::unique_ptr<Index[]>> m_sparsePages;
+
+   public:
+    SparseSet() = default;
+
+   public:
+    /**
+     * @brief Adds an identifier to the set.
+     *
+     * @param _id The identifier to add.
+     * @return bool True if the identifier was added, false if it already was in the set.
+     * @throw std::out_of_range If the identifier is c_invalidIndex.
+     */
+    bool Insert(Index _id);
+
+    /**
+     * @brief Removes an identifier from the set, moving the last identifier of the dense array into its position.
+     *
+     * @param _id The identifier to remove.
+     * @return bool True if the identifier was removed, false if it was not in the set.
+     */
+    bool Erase(Index _id) noexcept;
+
+    NODISCARD inline bool Contains(Index _id) const noexcept { return GetDenseIndex(_id) != c_invalidIndex; }
+
+    /**
+     * @brief Gets the position of an identifier in the dense array.
+     *
+     * @return Index The position, or c_invalidIndex if the identifier is not in the set.
+     */
+    NODISCARD Index GetDenseIndex(Index _id) const noexcept;
+
+    /**
+     * @brief Removes every identifier, keeping the allocated pages.
+     */
+    void Clear() noexcept;
+
+    void Reserve(size_t _capacity) { m_dense.reserve(_capacity); }
+
+    NODISCARD inline Index operator[](size_t _denseIndex) const noexcept { return m_dense[_denseIndex]; }
+
+    NODISCARD inline const Index *data() const noexcept { return m_dense.data(); }
+    NODISCARD inline const_iterator begin() const noexcept { return m_dense.data(); }
+    NODISCARD inline const_iterator end() const noexcept { return m_dense.data() + m_dense.size(); }
+
+    NODISCARD inline size_t size() const noexcept { return m_dense.size(); }
+    NODISCARD inline bool empty() const noexcept { return m_dense.empty(); }
+    NODISCARD inline size_t capacity() const noexcept { return m_dense.capacity(); }
+
+   private:
+    /**
+     * @brief Gets the sparse entry of an identifier, allocating its page if needed.
+     */
+    Index &GetSparseEntry(Index _id);
+};
+
+template <std::unsigned_integral Index>
+Index &SparseSet<Index>::GetSparseEntry(Index _id) {
+    const size_t page = _id / c_pageSize;
+
+    if (page >= m_sparsePages.size()) m_sparsePages.resize(page + 1);
+
+    if (!m_sparsePages[page]) {
+        m_sparsePages[page] = std::make_unique<Index[]>(c_pageSize);
+        std::fill_n(m_sparsePages[page].get(), c_pageSize, c_invalidIndex);
+    }
+
+    return m_sparsePages[page][_id % c_pageSize];
+}
+
+template <std::unsigned_integral Index>
+Index SparseSet<Index>::GetDenseIndex(Index _id) const noexcept {
+    const size_t page = _id / c_pageSize;
+
+    if (page >= m_sparsePages.size() || !m_sparsePages[page]) return c_invalidIndex;
+
+    return m_sparsePages[page][_id % c_pageSize];
+}
+
+template <std::unsigned_integral Index>
+bool SparseSet<Index>::Insert(Index _id) {
+    if (_id == c_invalidIndex) throw std::out_of_range("SparseSet identifier is reserved");
+
+    Index &entry = GetSparseEntry(_id);
+
+    if (entry != c_invalidIndex) return false;
+
+    m_dense.push_back(_id);
+    entry = static_cast<Index>(m_dense.size() - 1);
+
+    return true;
+}
+
+template <std::unsigned_integral Index>
+bool SparseSet<Index>::Erase(Index _id) noexcept {
+    const Index position = GetDenseIndex(_id);
+
+    if (position == c_invalidIndex) return false;
+
+    const Index last = m_dense.back();
+
+    m_dense[position] = last;
+    m_sparsePages[last / c_pageSize][last % c_pageSize] = position;
+    m_sparsePages[_id / c_pageSize][_id % c_pageSize] = c_invalidIndex;
+    m_dense.pop_back();
+
+    return true;
+}
+
+template <std::unsigned_integral Index>
+void SparseSet<Index>::Clear() noexcept {
+    for (Index id : m_dense) m_sparsePages[id / c_pageSize][id % c_pageSize] = c_invalidIndex;
+
+    m_dense.clear();
+}
+
+}  // namespace Rake::libraries
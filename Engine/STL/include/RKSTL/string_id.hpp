@@ -0,0 +1,221 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <functional>
+#include <string_view>
+
+#include "defines.hpp"
+
+#include "hash.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A string identifier reduced to its 64-bit FNV-1a hash, compared and hashed as an integer.
+ *
+ * Literals are hashed at compile time by the implicit consteval constructor, so passing "MoveForward" where a StringId
+ * is expected costs nothing at runtime. Strings only known at runtime are hashed with the same function, so they
+ * produce the same identifier as the literal with the same characters. Templates deducing their parameter from a
+ * literal receive the character array instead, the literal must then be wrapped in StringId("...") by the caller.
+ *
+ * Interned strings are copied once in a global append-only table mapping hashes back to strings, for serialization
+ * and debugging. Lookups in the table are lock-free: the buckets are published with release stores and grown by
+ * copying them into a larger array, the old arrays being kept alive so that concurrent readers never see freed
+ * memory. Interning a new string takes a mutex. In RK_DEBUG builds interning a string whose hash is already taken
+ * by a different string throws, release builds keep the first string.
+ *
+ * @note The collision check only sees interned strings. Literals are hashed by a consteval constructor that cannot
+ * record them, so a literal colliding with an interned string, or with another literal, goes undetected and both
+ * compare equal. Intern the strings that must be checked, e.g. the names of a fixed key set at startup.
+ *
+ * @note The table is local to each module (the runtime DLL and the executables linking it), identifiers are equal
+ * across modules but a string interned in one module is not known to GetString in another.
+ *
+ * @multithreading Thread-safe.
+ */
+class StringId {
+   private:
+    class InternTable;
+
+    uint64_t m_hash = 0;
+
+   public:
+    constexpr StringId() noexcept = default;
+
+    /**
+     * @brief Hashes a string literal at compile time.
+     *
+     * @note The literal is not interned, nor checked for collisions against the interned strings.
+     */
+    consteval StringId(const char *_string) noexcept : m_hash(FNV1aHash<uint64_t>(_string)) {}
+
+    /**
+     * @brief Hashes a runtime string without interning it, for lookups of strings interned elsewhere.
+     */
+    constexpr explicit StringId(std::string_view _string) noexcept : m_hash(FNV1aHash<uint64_t>(_string)) {}
+
+   public:
+    /**
+     * @brief Hashes a runtime string and interns it, so that GetString can map the identifier back to it.
+     *
+     * @throw std::runtime_error In RK_DEBUG builds, if another string with the same hash was interned before. Literals
+     * that were never interned are not part of the check.
+     */
+    static StringId Intern(std::string_view _string);
+
+    NODISCARD static constexpr StringId FromHash(uint64_t _hash) noexcept {
+        StringId id;
+        id.m_hash = _hash;
+        return id;
+    }
+
+    /**
+     * @brief Gets the interned string of the identifier without locking.
+     *
+     * @return std::string_view The string, or an empty view if it was never interned in this module.
+     */
+    NODISCARD std::string_view GetString() const noexcept;
+
+    NODISCARD constexpr uint64_t GetHash() const noexcept { return m_hash; }
+
+    NODISCARD constexpr bool IsNull() const noexcept { return m_hash == 0; }
+
+    constexpr auto operator<=>(const StringId &_other) const noexcept = default;
+
+   private:
+    NODISCARD static InternTable &GetInternTable() noexcept;
+};
+
+/**
+ * @brief Append-only open-addressing table from hashes to interned strings, see StringId.
+ */
+class StringId::InternTable final : public NonCopyable {
+   private:
+    static constexpr size_t c_initialCapacity = 1024;
+
+    struct Entry {
+        uint64_t hash;
+        std::string string;
+    };
+
+    struct Buckets {
+        size_t mask;
+        std::unique_ptr<std::atomic<const Entry *>[]> slots;
+
+        explicit Buckets(size_t _capacity) : mask(_capacity - 1), slots(new std::atomic<const Entry *>[_capacity]) {
+            for (size_t i = 0; i < _capacity; ++i) slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
+    std::atomic<Buckets *> m_buckets;
+    std::vector<std::unique_ptr<Buckets>> m_bucketArrays;
+    std::deque<Entry> m_entries;
+    std::mutex m_mutex;
+
+   public:
+    InternTable() {
+        m_bucketArrays.push_back(std::make_unique<Buckets>(c_initialCapacity));
+        m_buckets.store(m_bucketArrays.back().get(), std::memory_order_relaxed);
+    }
+
+   public:
+    /**
+     * @brief Finds the entry of a hash without locking.
+     */
+    NODISCARD const Entry *Find(uint64_t _hash) const noexcept {
+        const Buckets *buckets = m_buckets.load(std::memory_order_acquire);
+
+        for (size_t i = _hash & buckets->mask;; i = (i + 1) & buckets->mask) {
+            const Entry *entry = buckets->slots[i].load(std::memory_order_acquire);
+
+            if (entry == nullptr || entry->hash == _hash) return entry;
+        }
+    }
+
+    /**
+     * @brief Interns a string under its hash, returning the string already interned under the hash if any.
+     */
+    std::string_view Intern(uint64_t _hash, std::string_view _string) {
+        if (const Entry *entry = Find(_hash)) return entry->string;
+
+        std::lock_guard lock(m_mutex);
+
+        if (const Entry *entry = Find(_hash)) return entry->string;
+
+        Buckets *buckets = m_buckets.load(std::memory_order_relaxed);
+
+        // Deque elements never move, the buckets of every generation can point to them.
+        const Entry &entry = m_entries.emplace_back(Entry{_hash, std::string(_string)});
+
+        if (m_entries.size() * 2 > buckets->mask + 1) buckets = Grow(buckets);
+
+        Insert(*buckets, entry);
+
+        return entry.string;
+    }
+
+   private:
+    static void Insert(Buckets &_buckets, const Entry &_entry) noexcept {
+        size_t i = _entry.hash & _buckets.mask;
+
+        while (_buckets.slots[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & _buckets.mask;
+
+        _buckets.slots[i].store(&_entry, std::memory_order_release);
+    }
+
+    Buckets *Grow(const Buckets *_buckets) {
+        auto grown = std::make_unique<Buckets>((_buckets->mask + 1) * 2);
+
+        for (size_t i = 0; i <= _buckets->mask; ++i) {
+            if (const Entry *entry = _buckets->slots[i].load(std::memory_order_relaxed)) Insert(*grown, *entry);
+        }
+
+        m_bucketArrays.push_back(std::move(grown));
+
+        // Readers still probing the old buckets keep a valid view of it, it is only freed with the table.
+        m_buckets.store(m_bucketArrays.back().get(), std::memory_order_release);
+
+        return m_bucketArrays.back().get();
+    }
+};
+
+inline StringId::InternTable &StringId::GetInternTable() noexcept {
+    static InternTable table;
+    return table;
+}
+
+inline StringId StringId::Intern(std::string_view _string) {
+    const StringId id(_string);
+    MAYBE_UNUSED const std::string_view interned = GetInternTable().Intern(id.m_hash, _string);
+
+#ifdef RK_DEBUG
+    if (interned != _string) {
+        throw std::runtime_error(
+            "StringId collision between '" + std::string(interned) + "' and '" + std::string(_string) + "'");
+    }
+#endif
+
+    return id;
+}
+
+inline std::string_view StringId::GetString() const noexcept {
+    const auto *entry = GetInternTable().Find(m_hash);
+
+    return entry != nullptr ? std::string_view(entry->string) : std::string_view();
+}
+
+}  // namespace Rake::libraries
+
+template <>
+struct std::hash<Rake::libraries::StringId> {
+    size_t operator()(Rake::libraries::StringId _id) const noexcept { return static_cast<size_t>(_id.GetHash()); }
+};
@@ -0,0 +1,473 @@
+#pragma once
+
+#include <new>
+#include <span>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include "defines.hpp"
+#include "pool.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A sequence storing its elements in linked chunks of contiguous slots.
+ *
+ * Each chunk holds up to ChunkCapacity elements packed at its front, so traversal walks arrays instead of chasing one
+ * pointer per element and ForEachSpan hands whole chunks to vectorizable loops. Inserting or erasing in the middle
+ * shifts at most one chunk: a full chunk is split in two halves, a chunk drained below a quarter is merged with its
+ * successor when they fit together. Chunks live in the pages of a segmented MemoryPool, which recycles them and never
+ * moves them when it grows.
+ *
+ * @note Insert and Erase invalidate the iterators into the chunks they touch, the returned iterator stays valid.
+ *
+ * @tparam T The type of elements, it must be nothrow move constructible as elements are shifted within chunks.
+ * @tparam ChunkCapacity The number of elements per chunk, 32 to 64 is a good fit for small elements.
+ *
+ * @multithreading Not thread-safe.
+ */
+template <typename T, size_t ChunkCapacity = 64>
+class UnrolledList final : public NonCopyable {
+    static_assert(ChunkCapacity >= 4, "Chunks must hold at least four elements!");
+    static_assert(std::is_nothrow_move_constructible_v<T>, "Elements must be nothrow move constructible!");
+
+   private:
+    static constexpr size_t c_spanAlignment = std::max(alignof(T), size_t(32));
+    static constexpr size_t c_defaultChunksPerPage = 64;
+
+    struct ChunkLinks {
+        ChunkLinks *next = nullptr;
+        ChunkLinks *prev = nullptr;
+        size_t count = 0;
+    };
+
+    struct Chunk : ChunkLinks {
+        alignas(c_spanAlignment) std::byte storage[sizeof(T) * ChunkCapacity];
+
+        Chunk() noexcept {}
+
+        NODISCARD inline T *GetData() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+    };
+
+    ChunkLinks m_sentinel;
+    size_t m_size = 0;
+    MemoryPool<Chunk> m_chunks;
+
+   public:
+    /**
+     * @brief Bidirectional iterator over the elements of an UnrolledList.
+     */
+    template <bool Const>
+    class BasicIterator final {
+        friend class UnrolledList;
+
+        template <bool>
+        friend class BasicIterator;
+
+       public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+       private:
+        ChunkLinks *m_chunk = nullptr;
+        size_t m_index = 0;
+
+       public:
+        BasicIterator() = default;
+
+        BasicIterator(ChunkLinks *_chunk, size_t _index) noexcept : m_chunk(_chunk), m_index(_index) {}
+
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst> &_other) noexcept
+            : m_chunk(_other.m_chunk), m_index(_other.m_index) {}
+
+        BasicIterator &operator++() noexcept {
+            if (++m_index == m_chunk->count) {
+                m_chunk = m_chunk->next;
+                m_index = 0;
+            }
+
+            return *this;
+        }
+
+        BasicIterator &operator--() noexcept {
+            if (m_index == 0) {
+                m_chunk = m_chunk->prev;
+                m_index = m_chunk->count;
+            }
+
+            --m_index;
+
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator it(*this);
+            --*this;
+            return it;
+        }
+
+        NODISCARD inline reference operator*() const noexcept {
+            return static_cast<Chunk *>(m_chunk)->GetData()[m_index];
+        }
+
+        NODISCARD inline pointer operator->() const noexcept { return &**this; }
+
+        NODISCARD inline bool operator==(const BasicIterator &_other) const noexcept {
+            return m_chunk == _other.m_chunk && m_index == _other.m_index;
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+   public:
+    /**
+     * @brief Constructs an UnrolledList.
+     *
+     * @param _chunksPerPage The number of chunks per page of the chunk pool.
+     */
+    explicit UnrolledList(size_t _chunksPerPage = c_defaultChunksPerPage)
+        : m_chunks(_chunksPerPage, PoolLayout::segmented, _chunksPerPage) {
+        ResetLinks();
+    }
+
+    /**
+     * @brief Destroys every element and releases the chunks.
+     */
+    ~UnrolledList() { Clear(); }
+
+    UnrolledList(UnrolledList &&_other) noexcept : m_chunks(std::move(_other.m_chunks)) { TakeChunks(_other); }
+
+    UnrolledList &operator=(UnrolledList &&_other) noexcept {
+        if (this == &_other) return *this;
+
+        Clear();
+
+        m_chunks = std::move(_other.m_chunks);
+
+        TakeChunks(_other);
+
+        return *this;
+    }
+
+   public:
+    /**
+     * @brief Constructs an element in place at the end of the list.
+     *
+     * @return T& The new element.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    template <typename... Args>
+    T &EmplaceBack(Args &&..._args) {
+        const bool isFull = m_sentinel.prev == &m_sentinel || m_sentinel.prev->count == ChunkCapacity;
+
+        Chunk *chunk = isFull ? InsertChunk(&m_sentinel) : static_cast<Chunk *>(m_sentinel.prev);
+        T *element = nullptr;
+
+        try {
+            element = std::construct_at(chunk->GetData() + chunk->count, std::forward<Args>(_args)...);
+        } catch (...) {
+            if (isFull) RemoveChunk(chunk);
+            throw;
+        }
+
+        chunk->count++;
+        m_size++;
+
+        return *element;
+    }
+
+    /**
+     * @brief Constructs an element in place at the beginning of the list.
+     *
+     * @return T& The new element.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    template <typename... Args>
+    T &EmplaceFront(Args &&..._args) {
+        return *Emplace(begin(), std::forward<Args>(_args)...);
+    }
+
+    /**
+     * @brief Constructs an element in place before the specified position, shifting at most one chunk.
+     *
+     * @param _pos The position before which the element is constructed.
+     * @return Iterator An iterator to the new element.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    template <typename... Args>
+    Iterator Emplace(ConstIterator _pos, Args &&..._args);
+
+    inline T &PushBack(const T &_data) { return EmplaceBack(_data); }
+
+    inline T &PushFront(const T &_data) { return EmplaceFront(_data); }
+
+    inline Iterator Insert(ConstIterator _pos, const T &_data) { return Emplace(_pos, _data); }
+
+    /**
+     * @brief Destroys the element at the specified position, shifting at most one chunk.
+     *
+     * @param _pos The position of the element, it must not be end().
+     * @return Iterator An iterator to the element that followed it.
+     */
+    Iterator Erase(ConstIterator _pos) noexcept;
+
+    /**
+     * @brief Destroys the last element, the list must not be empty.
+     */
+    void PopBack() noexcept { Erase(--end()); }
+
+    /**
+     * @brief Destroys the first element, the list must not be empty.
+     */
+    void PopFront() noexcept { Erase(begin()); }
+
+    /**
+     * @brief Destroys every element and returns the chunks to the pool.
+     */
+    void Clear() noexcept;
+
+    /**
+     * @brief Calls a function with a span over the elements of every chunk, in order.
+     *
+     * @note The spans are aligned to at least 32 bytes, the function must not insert or erase elements.
+     *
+     * @param _function A callable taking a std::span<T>.
+     */
+    template <typename Function>
+    void ForEachSpan(Function &&_function) {
+        for (ChunkLinks *chunk = m_sentinel.next; chunk != &m_sentinel; chunk = chunk->next) {
+            _function(std::span<T>(static_cast<Chunk *>(chunk)->GetData(), chunk->count));
+        }
+    }
+
+    /**
+     * @brief Calls a function with a read-only span over the elements of every chunk, in order.
+     */
+    template <typename Function>
+    void ForEachSpan(Function &&_function) const {
+        for (ChunkLinks *chunk = m_sentinel.next; chunk != &m_sentinel; chunk = chunk->next) {
+            _function(std::span<const T>(static_cast<Chunk *>(chunk)->GetData(), chunk->count));
+        }
+    }
+
+   public:
+    NODISCARD inline T &Front() noexcept { return *begin(); }
+
+    NODISCARD inline T &Back() noexcept { return *--end(); }
+
+    NODISCARD inline bool empty() const noexcept { return m_size == 0; }
+
+    NODISCARD inline size_t size() const noexcept { return m_size; }
+
+    /**
+     * @brief Gets the number of chunks in use.
+     */
+    NODISCARD inline size_t GetChunkCount() const noexcept { return m_chunks.size(); }
+
+    NODISCARD inline Iterator begin() noexcept { return Iterator(m_sentinel.next, 0); }
+
+    NODISCARD inline ConstIterator begin() const noexcept { return ConstIterator(m_sentinel.next, 0); }
+
+    NODISCARD inline ConstIterator cbegin() const noexcept { return begin(); }
+
+    NODISCARD inline Iterator end() noexcept { return Iterator(&m_sentinel, 0); }
+
+    NODISCARD inline ConstIterator end() const noexcept {
+        return ConstIterator(const_cast<ChunkLinks *>(&m_sentinel), 0);
+    }
+
+    NODISCARD inline ConstIterator cend() const noexcept { return end(); }
+
+   private:
+    void ResetLinks() noexcept {
+        m_sentinel.next = m_sentinel.prev = &m_sentinel;
+        m_size = 0;
+    }
+
+    /**
+     * @brief Adopts the chunk chain of another list, whose pool was just moved into this one.
+     */
+    void TakeChunks(UnrolledList &_other) noexcept;
+
+    /**
+     * @brief Allocates an empty chunk and links it before another.
+     *
+     * @throws std::bad_alloc if the chunk cannot be allocated.
+     */
+    Chunk *InsertChunk(ChunkLinks *_next);
+
+    /**
+     * @brief Unlinks an empty chunk and returns it to the pool.
+     */
+    void RemoveChunk(ChunkLinks *_chunk) noexcept;
+
+    /**
+     * @brief Moves the elements of a chunk from an index on to the end of another chunk.
+     */
+    static void MoveElements(Chunk *_source, size_t _first, Chunk *_destination) noexcept;
+};
+
+template <typename T, size_t ChunkCapacity>
+template <typename... Args>
+typename UnrolledList<T, ChunkCapacity>::Iterator UnrolledList<T, ChunkCapacity>::Emplace(
+    ConstIterator _pos,
+    Args &&..._args) {
+    ChunkLinks *links = _pos.m_chunk;
+    size_t index = _pos.m_index;
+
+    // Appending to the end fills the last chunk instead of opening a new one.
+    if (links == &m_sentinel) {
+        EmplaceBack(std::forward<Args>(_args)...);
+        return --end();
+    }
+
+    // The element is built aside first, so that a throwing constructor leaves the chunks untouched.
+    T element(std::forward<Args>(_args)...);
+
+    Chunk *chunk = static_cast<Chunk *>(links);
+
+    if (chunk->count == ChunkCapacity) {
+        Chunk *sibling = InsertChunk(chunk->next);
+
+        MoveElements(chunk, ChunkCapacity / 2, sibling);
+
+        if (index > chunk->count) {
+            index -= chunk->count;
+            chunk = sibling;
+        }
+    }
+
+    T *data = chunk->GetData();
+
+    if (index == chunk->count) {
+        std::construct_at(data + index, std::move(element));
+    } else {
+        std::construct_at(data + chunk->count, std::move(data[chunk->count - 1]));
+        std::move_backward(data + index, data + chunk->count - 1, data + chunk->count);
+        data[index] = std::move(element);
+    }
+
+    chunk->count++;
+    m_size++;
+
+    return Iterator(chunk, index);
+}
+
+template <typename T, size_t ChunkCapacity>
+typename UnrolledList<T, ChunkCapacity>::Iterator UnrolledList<T, ChunkCapacity>::Erase(ConstIterator _pos) noexcept {
+    Chunk *chunk = static_cast<Chunk *>(_pos.m_chunk);
+    T *data = chunk->GetData();
+    size_t index = _pos.m_index;
+
+    std::move(data + index + 1, data + chunk->count, data + index);
+    std::destroy_at(data + chunk->count - 1);
+
+    chunk->count--;
+    m_size--;
+
+    if (chunk->count == 0) {
+        ChunkLinks *next = chunk->next;
+
+        RemoveChunk(chunk);
+
+        return Iterator(next, 0);
+    }
+
+    // A sparse chunk absorbs its successor when both fit in one, keeping traversal dense.
+    if (chunk->count < ChunkCapacity / 4 && chunk->next != &m_sentinel &&
+        chunk->count + chunk->next->count <= ChunkCapacity) {
+        Chunk *next = static_cast<Chunk *>(chunk->next);
+
+        MoveElements(next, 0, chunk);
+        RemoveChunk(next);
+    }
+
+    if (index == chunk->count) return Iterator(chunk->next, 0);
+
+    return Iterator(chunk, index);
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledList<T, ChunkCapacity>::Clear() noexcept {
+    ChunkLinks *links = m_sentinel.next;
+
+    while (links != &m_sentinel) {
+        Chunk *chunk = static_cast<Chunk *>(links);
+
+        links = links->next;
+
+        std::destroy_n(chunk->GetData(), chunk->count);
+
+        m_chunks.Deallocate(chunk);
+    }
+
+    ResetLinks();
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledList<T, ChunkCapacity>::TakeChunks(UnrolledList &_other) noexcept {
+    if (_other.m_sentinel.next == &_other.m_sentinel) {
+        ResetLinks();
+        return;
+    }
+
+    m_sentinel.next = _other.m_sentinel.next;
+    m_sentinel.prev = _other.m_sentinel.prev;
+    m_sentinel.next->prev = &m_sentinel;
+    m_sentinel.prev->next = &m_sentinel;
+    m_size = _other.m_size;
+
+    _other.ResetLinks();
+}
+
+template <typename T, size_t ChunkCapacity>
+typename UnrolledList<T, ChunkCapacity>::Chunk *UnrolledList<T, ChunkCapacity>::InsertChunk(ChunkLinks *_next) {
+    Chunk *chunk = m_chunks.Construct();
+    ChunkLinks *prev = _next->prev;
+
+    chunk->next = _next;
+    chunk->prev = prev;
+    prev->next = chunk;
+    _next->prev = chunk;
+
+    return chunk;
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledList<T, ChunkCapacity>::RemoveChunk(ChunkLinks *_chunk) noexcept {
+    _chunk->prev->next = _chunk->next;
+    _chunk->next->prev = _chunk->prev;
+
+    m_chunks.Deallocate(static_cast<Chunk *>(_chunk));
+}
+
+template <typename T, size_t ChunkCapacity>
+void UnrolledList<T, ChunkCapacity>::MoveElements(Chunk *_source, size_t _first, Chunk *_destination) noexcept {
+    T *source = _source->GetData();
+    const size_t count = _source->count - _first;
+
+    std::uninitialized_move_n(source + _first, count, _destination->GetData() + _destination->count);
+    std::destroy_n(source + _first, count);
+
+    _source->count = _first;
+    _destination->count += count;
+}
+
+}  // namespace Rake::libraries
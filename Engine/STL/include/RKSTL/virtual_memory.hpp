@@ -0,0 +1,125 @@
+#pragma once
+
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A range of virtual address space reserved up front and backed by physical memory on demand.
+ *
+ * The whole range is reserved at construction without consuming memory, Commit makes a growing prefix of it
+ * accessible and Decommit hands the tail of that prefix back to the OS. Since the range never moves, a container
+ * built on it grows in place and keeps every pointer into it valid.
+ *
+ * On Linux the range is mapped with mmap and committed pages are still faulted in lazily by the kernel. Ranges asking
+ * for huge pages are aligned to 2 MiB and advised with MADV_HUGEPAGE so that transparent huge pages can back large
+ * scans with fewer TLB misses, decommitted pages are returned with MADV_DONTNEED. On Windows the range is reserved and
+ * committed with VirtualAlloc, huge pages are not requested as they need a privilege and cannot be committed lazily.
+ * Other platforms fall back to a single heap block committed entirely at construction.
+ *
+ * The system calls are compiled in the STL library (src/virtual_memory.cpp), including this header does not pull in
+ * the platform headers and their macros.
+ *
+ * @multithreading Not thread-safe, the owner serializes Commit and Decommit.
+ */
+class VirtualReservation final : public NonCopyable {
+   private:
+    static constexpr size_t c_hugePageSize = RK_MEBIBYTES(size_t(2));
+
+    std::byte *m_base = nullptr;
+    size_t m_reservedSize = 0;
+    size_t m_committedSize = 0;
+
+   public:
+    VirtualReservation() = default;
+
+    /**
+     * @brief Reserves a range of virtual address space.
+     *
+     * @param _size The size of the range in bytes, rounded up to the page size.
+     * @param _hugePages Whether to request transparent huge pages for the range.
+     * @throws std::bad_alloc if the address space cannot be reserved.
+     */
+    VirtualReservation(size_t _size, bool _hugePages = false);
+
+    /**
+     * @brief Releases the whole range, committed or not.
+     */
+    ~VirtualReservation() { Release(); }
+
+    VirtualReservation(VirtualReservation &&_other) noexcept
+        : m_base(std::exchange(_other.m_base, nullptr)),
+          m_reservedSize(std::exchange(_other.m_reservedSize, 0)),
+          m_committedSize(std::exchange(_other.m_committedSize, 0)) {}
+
+    VirtualReservation &operator=(VirtualReservation &&_other) noexcept {
+        if (this == &_other) return *this;
+
+        Release();
+
+        m_base = std::exchange(_other.m_base, nullptr);
+        m_reservedSize = std::exchange(_other.m_reservedSize, 0);
+        m_committedSize = std::exchange(_other.m_committedSize, 0);
+
+        return *this;
+    }
+
+   public:
+    /**
+     * @brief Makes the first bytes of the range accessible, already committed bytes are left untouched.
+     *
+     * @param _size The number of bytes from the start of the range that must be accessible.
+     * @throws std::bad_alloc if the size exceeds the reservation or the memory cannot be committed.
+     */
+    void Commit(size_t _size);
+
+    /**
+     * @brief Returns the committed memory past the first bytes of the range to the OS.
+     *
+     * @param _size The number of bytes from the start of the range that must stay accessible.
+     */
+    void Decommit(size_t _size) noexcept;
+
+    /**
+     * @brief Gets the start of the range, or nullptr if nothing is reserved.
+     */
+    NODISCARD inline std::byte *GetData() const noexcept { return m_base; }
+
+    /**
+     * @brief Gets the size of the range in bytes.
+     */
+    NODISCARD inline size_t GetReservedSize() const noexcept { return m_reservedSize; }
+
+    /**
+     * @brief Gets the number of accessible bytes from the start of the range.
+     */
+    NODISCARD inline size_t GetCommittedSize() const noexcept { return m_committedSize; }
+
+    /**
+     * @brief Gets the granularity at which memory is committed and decommitted.
+     */
+    NODISCARD static size_t GetPageSize() noexcept;
+
+   private:
+    /**
+     * @brief Rounds a size up to a multiple of the page size.
+     */
+    NODISCARD static size_t RoundToPages(size_t _size) noexcept {
+        const size_t pageSize = GetPageSize();
+
+        return (_size + pageSize - 1) / pageSize * pageSize;
+    }
+
+    /**
+     * @brief Releases the range and resets the reservation to empty.
+     */
+    void Release() noexcept;
+};
+
+}  // namespace Rake::libraries
@@ -7,6 +7,9 @@
 #ifdef COMPILER_MSVC
 #define RK_DISABLE_WARNINGS __pragma(warning(push, 0))
 #define RK_RESTORE_WARNINGS __pragma(warning(pop))
+#elif defined(COMPILER_CLANG)
+#define RK_DISABLE_WARNINGS _Pragma("clang diagnostic push") _Pragma("clang diagnostic ignored \"-Weverything\"")
+#define RK_RESTORE_WARNINGS _Pragma("clang diagnostic pop")
 #else
 #error "Unknown or not supported compiler toolchain!"
 #endif
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <bit>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "defines.hpp"
+
+namespace Rake::libraries {
+
+/**
+ * @brief A lock-free, growable Chase-Lev work-stealing deque.
+ *
+ * The owner thread pushes and pops at the bottom like a stack, which keeps recently spawned and cache-hot work local,
+ * while any number of thief threads steal the oldest elements from the top. Follows the C11 formulation of Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models": the owner only races with thieves for the last
+ * element, which is arbitrated by a CAS on the top index.
+ *
+ * When the circular array is full the owner copies the live range into an array twice as large. A thief may still be
+ * reading from the old array, so retired arrays are kept until the deque is destroyed; their total size never
+ * exceeds that of the current array.
+ *
+ * @tparam T The element type, trivially copyable so that slots can be read and written atomically, typically a
+ * pointer or an index to the actual work item.
+ *
+ * @multithreading Push and Pop must only be called by the owner thread. Steal is thread-safe. size and empty are only
+ * hints when read by a thread other than the owner.
+ */
+template <typename T>
+class WorkStealingDeque final : public NonCopyable {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque elements must be trivially copyable");
+
+   private:
+    static constexpr size_t c_defaultCapacity = 1024;
+
+    class Array {
+       private:
+        size_t m_mask;
+        std::unique_ptr<std::atomic<T>[]> m_slots;
+
+       public:
+        explicit Array(size_t _capacity) : m_mask(_capacity - 1), m_slots(new std::atomic<T>[_capacity]) {}
+
+        NODISCARD inline int64_t capacity() const noexcept { return static_cast<int64_t>(m_mask + 1); }
+
+        NODISCARD inline T Load(int64_t _index) const noexcept {
+            return m_slots[static_cast<size_t>(_index) & m_mask].load(std::memory_order_relaxed);
+        }
+
+        inline void Store(int64_t _index, T _value) noexcept {
+            m_slots[static_cast<size_t>(_index) & m_mask].store(_value, std::memory_order_relaxed);
+        }
+    };
+
+    // Thieves hammer the top while the owner works on the bottom, keeping them apart avoids false sharing.
+    alignas(64) std::atomic<int64_t> m_top = 0;
+    alignas(64) std::atomic<int64_t> m_bottom = 0;
+    std::atomic<Array *> m_array;
+
+    std::vector<std::unique_ptr<Array>> m_arrays;
+
+   public:
+    /**
+     * @brief Constructs a WorkStealingDeque.
+     *
+     * @param _capacity The initial number of elements, rounded up to a power of two.
+     * @throw std::invalid_argument If the capacity is zero.
+     */
+    explicit WorkStealingDeque(size_t _capacity = c_defaultCapacity);
+
+   public:
+    /**
+     * @brief Pushes an element at the bottom of the deque, growing it if full.
+     *
+     * @param _value The element to push.
+     */
+    void Push(T _value);
+
+    /**
+     * @brief Pops the most recently pushed element from the bottom of the deque.
+     *
+     * @return std::optional<T> The element, or std::nullopt if the deque is empty or a thief took the last element.
+     */
+    NODISCARD std::optional<T> Pop() noexcept;
+
+    /**
+     * @brief Steals the oldest element from the top of the deque.
+     *
+     * @return std::optional<T> The element, or std::nullopt if the deque is empty or another thread won the race for
+     * the top element, in which case the caller may retry or pick another victim.
+     */
+    NODISCARD std::optional<T> Steal() noexcept;
+
+    NODISCARD inline size_t size() const noexcept {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_relaxed);
+
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+    NODISCARD inline bool empty() const noexcept { return size() == 0; }
+
+    NODISCARD inline size_t capacity() const noexcept {
+        return static_cast<size_t>(m_array.load(std::memory_order_relaxed)->capacity());
+    }
+
+   private:
+    Array *Grow(Array *_array, int64_t _top, int64_t _bottom);
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t _capacity) {
+    if (_capacity == 0) throw std::invalid_argument("WorkStealingDeque capacity must be greater than zero");
+
+    m_arrays.push_back(std::make_unique<Array>(std::bit_ceil(_capacity)));
+    m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::Array *WorkStealingDeque<T>::Grow(Array *_array, int64_t _top, int64_t _bottom) {
+    auto grown = std::make_unique<Array>(static_cast<size_t>(_array->capacity()) * 2);
+
+    for (int64_t i = _top; i < _bottom; ++i) grown->Store(i, _array->Load(i));
+
+    m_arrays.push_back(std::move(grown));
+
+    // Thieves that loaded the old array keep reading valid slots from it, it is only freed with the deque.
+    m_array.store(m_arrays.back().get(), std::memory_order_release);
+
+    return m_arrays.back().get();
+}
+
+template <typename T>
+void WorkStealingDeque<T>::Push(T _value) {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    const int64_t top = m_top.load(std::memory_order_acquire);
+    Array *array = m_array.load(std::memory_order_relaxed);
+
+    if (bottom - top > array->capacity() - 1) array = Grow(array, top, bottom);
+
+    array->Store(bottom, _value);
+
+    // Publishes the slot to the thieves that acquire the bottom index.
+    m_bottom.store(bottom + 1, std::memory_order_release);
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::Pop() noexcept {
+    const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Array *array = m_array.load(std::memory_order_relaxed);
+
+    // Claim the bottom slot before looking at the top, the fence orders the store against the load of the thieves.
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    T value = array->Load(bottom);
+
+    if (top == bottom) {
+        // The last element may be stolen concurrently, whoever moves the top first takes it.
+        const bool won =
+            m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+        if (!won) return std::nullopt;
+    }
+
+    return value;
+}
+
+template <typename T>
+std::optional<T> WorkStealingDeque<T>::Steal() noexcept {
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) return std::nullopt;
+
+    Array *array = m_array.load(std::memory_order_acquire);
+    T value = array->Load(top);
+
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+}  // namespace Rake::libraries
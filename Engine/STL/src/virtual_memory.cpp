@@ -0,0 +1,131 @@
+#include "RKSTL/virtual_memory.hpp"
+
+// The OS headers stay in this file, windows.h defines macros such as CreateWindow and CreateFile that would rename
+// functions of every module including RKSTL headers.
+#if defined(PLATFORM_WINDOWS)
+RK_DISABLE_WARNINGS
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+RK_RESTORE_WARNINGS
+#elif defined(PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Rake::libraries {
+
+VirtualReservation::VirtualReservation(size_t _size, bool _hugePages) {
+    if (_size == 0) return;
+
+#if defined(PLATFORM_WINDOWS)
+    (void)_hugePages;
+
+    m_reservedSize = RoundToPages(_size);
+    m_base = static_cast<std::byte *>(VirtualAlloc(nullptr, m_reservedSize, MEM_RESERVE, PAGE_NOACCESS));
+
+    if (!m_base) throw std::bad_alloc();
+#elif defined(PLATFORM_LINUX)
+    const size_t alignment = _hugePages ? c_hugePageSize : GetPageSize();
+
+    m_reservedSize = (_size + alignment - 1) / alignment * alignment;
+
+    // Over-reserve by the alignment and unmap the unaligned head and tail, mmap only guarantees page alignment.
+    const size_t mappedSize = m_reservedSize + alignment - GetPageSize();
+
+    void *mapping = mmap(nullptr, mappedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (mapping == MAP_FAILED) throw std::bad_alloc();
+
+    const uintptr_t first = reinterpret_cast<uintptr_t>(mapping);
+    const uintptr_t aligned = (first + alignment - 1) / alignment * alignment;
+    const size_t tail = mappedSize - (aligned - first) - m_reservedSize;
+
+    if (aligned > first) munmap(mapping, aligned - first);
+    if (tail > 0) munmap(reinterpret_cast<void *>(aligned + m_reservedSize), tail);
+
+    m_base = reinterpret_cast<std::byte *>(aligned);
+
+#ifdef MADV_HUGEPAGE
+    if (_hugePages) madvise(m_base, m_reservedSize, MADV_HUGEPAGE);
+#endif
+#else
+    (void)_hugePages;
+
+    m_base = static_cast<std::byte *>(::operator new(_size));
+    m_reservedSize = _size;
+    m_committedSize = _size;
+#endif
+}
+
+void VirtualReservation::Commit(size_t _size) {
+    if (_size <= m_committedSize) return;
+    if (_size > m_reservedSize) throw std::bad_alloc();
+
+    const size_t committedSize = std::min(RoundToPages(_size), m_reservedSize);
+
+#if defined(PLATFORM_WINDOWS)
+    if (!VirtualAlloc(m_base + m_committedSize, committedSize - m_committedSize, MEM_COMMIT, PAGE_READWRITE))
+        throw std::bad_alloc();
+#elif defined(PLATFORM_LINUX)
+    if (mprotect(m_base + m_committedSize, committedSize - m_committedSize, PROT_READ | PROT_WRITE) != 0)
+        throw std::bad_alloc();
+#endif
+
+    m_committedSize = committedSize;
+}
+
+void VirtualReservation::Decommit(size_t _size) noexcept {
+    const size_t committedSize = RoundToPages(_size);
+
+    if (committedSize >= m_committedSize) return;
+
+#if defined(PLATFORM_WINDOWS)
+    VirtualFree(m_base + committedSize, m_committedSize - committedSize, MEM_DECOMMIT);
+#elif defined(PLATFORM_LINUX)
+    madvise(m_base + committedSize, m_committedSize - committedSize, MADV_DONTNEED);
+    mprotect(m_base + committedSize, m_committedSize - committedSize, PROT_NONE);
+#else
+    return;
+#endif
+
+    m_committedSize = committedSize;
+}
+
+size_t VirtualReservation::GetPageSize() noexcept {
+#if defined(PLATFORM_WINDOWS)
+    static const size_t pageSize = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+    }();
+#elif defined(PLATFORM_LINUX)
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    static constexpr size_t pageSize = 4096;
+#endif
+
+    return pageSize;
+}
+
+void VirtualReservation::Release() noexcept {
+    if (!m_base) return;
+
+#if defined(PLATFORM_WINDOWS)
+    VirtualFree(m_base, 0, MEM_RELEASE);
+#elif defined(PLATFORM_LINUX)
+    munmap(m_base, m_reservedSize);
+#else
+    ::operator delete(m_base);
+#endif
+
+    m_base = nullptr;
+    m_reservedSize = 0;
+    m_committedSize = 0;
+}
+
+}  // namespace Rake::libraries
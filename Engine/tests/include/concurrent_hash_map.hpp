@@ -0,0 +1,172 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <sstream>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <RKSTL/concurrent_hash_map.hpp>
+
+TEST(ConcurrentHashMapTest, BasicTest) {
+    Rake::libraries::ConcurrentHashMap<std::string, std::shared_ptr<int>> registry(8);
+
+    EXPECT_EQ(registry.GetShardCount(), 8);
+    EXPECT_THROW((Rake::libraries::ConcurrentHashMap<int, int>(0)), std::invalid_argument);
+
+    EXPECT_TRUE(registry.TryEmplace("PrimaryWindow", std::make_shared<int>(1)));
+    EXPECT_FALSE(registry.TryEmplace("PrimaryWindow", std::make_shared<int>(2)));
+    EXPECT_TRUE(registry.InsertOrAssign(std::string("ToolsWindow"), std::make_shared<int>(3)));
+    EXPECT_FALSE(registry.InsertOrAssign("ToolsWindow", std::make_shared<int>(4)));
+
+    // Lookups through string_view do not build a std::string.
+    const std::string_view primary = "PrimaryWindow";
+
+    EXPECT_EQ(*registry.Find(primary).value(), 1);
+    EXPECT_EQ(**registry.Find("ToolsWindow"), 4);
+    EXPECT_FALSE(registry.Find("ConsoleWindow").has_value());
+    EXPECT_TRUE(registry.Contains(primary));
+
+    EXPECT_TRUE(registry.Update(primary, [](std::shared_ptr<int> &_value) { *_value = 5; }));
+    EXPECT_FALSE(registry.Update("ConsoleWindow", [](std::shared_ptr<int> &) {}));
+
+    int visited = 0;
+
+    EXPECT_TRUE(registry.Visit(primary, [&](const std::shared_ptr<int> &_value) { visited = *_value; }));
+    EXPECT_EQ(visited, 5);
+
+    int sum = 0;
+
+    registry.ForEach([&](const std::string &, const std::shared_ptr<int> &_value) { sum += *_value; });
+
+    EXPECT_EQ(sum, 5 + 4);
+    EXPECT_EQ(registry.size(), 2);
+    EXPECT_EQ(registry.Erase("ToolsWindow"), 1);
+    EXPECT_EQ(registry.Erase("ToolsWindow"), 0);
+
+    registry.Clear();
+
+    EXPECT_TRUE(registry.empty());
+}
+
+TEST(ConcurrentHashMapTest, ThreadedTest) {
+    constexpr int numThreads = 8;
+    constexpr uint64_t numKeys = 2000;
+
+    Rake::libraries::ConcurrentHashMap<uint64_t, uint64_t> map;
+    std::vector<std::thread> threads;
+    std::atomic<bool> mismatch = false;
+
+    // Every thread owns a range of keys it writes, while reading the ranges of the others.
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            const uint64_t first = t * numKeys;
+
+            for (uint64_t key = first; key < first + numKeys; ++key) {
+                map.TryEmplace(key, key * 2);
+
+                const uint64_t other = (key + numKeys) % (numThreads * numKeys);
+
+                if (auto value = map.Find(other); value && *value != other * 2) mismatch = true;
+            }
+
+            for (uint64_t key = first; key < first + numKeys; key += 2) map.Erase(key);
+        });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_FALSE(mismatch);
+    EXPECT_EQ(map.size(), numThreads * numKeys / 2);
+
+    for (uint64_t key = 0; key < numThreads * numKeys; ++key) EXPECT_EQ(map.Contains(key), key % 2 == 1);
+}
+
+TEST(ConcurrentHashMapTest, DISABLED_BenchmarkTest) {
+    constexpr size_t numKeys = 256;
+    constexpr size_t opsPerThread = 1 << 15;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::vector<std::string> names;
+
+    for (size_t i = 0; i < numKeys; ++i) names.push_back("Window" + std::to_string(i));
+
+    Rake::libraries::ConcurrentHashMap<std::string, uint64_t> sharded;
+    std::unordered_map<std::string, uint64_t> global;
+    std::shared_mutex globalMutex;
+
+    for (size_t i = 0; i < numKeys; ++i) {
+        sharded.TryEmplace(names[i], i);
+        global[names[i]] = i;
+    }
+
+    // One write every 64 operations, the rest are lookups, as for the window and context registries.
+    auto run = [&](int _numThreads, auto &&_lookup, auto &&_assign) {
+        std::vector<std::thread> threads;
+        std::atomic<uint64_t> checksum = 0;
+
+        const auto start = Clock::now();
+
+        for (int t = 0; t < _numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                uint64_t sum = 0;
+
+                for (size_t i = 0; i < opsPerThread; ++i) {
+                    const std::string &name = names[(i * 7 + t * 31) % numKeys];
+
+                    if (i % 64 == 0) {
+                        _assign(name, (i * 7 + t * 31) % numKeys);
+                    } else {
+                        sum += _lookup(name);
+                    }
+                }
+
+                checksum += sum;
+            });
+        }
+
+        for (auto &thread : threads) thread.join();
+
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        return std::make_pair(_numThreads * opsPerThread / elapsed / 1e6, checksum.load());
+    };
+
+    std::ostringstream results;
+
+    for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+        const auto [shardedRate, shardedSum] = run(
+            numThreads,
+            [&](const std::string &_name) { return *sharded.Find(_name); },
+            [&](const std::string &_name, uint64_t _value) { sharded.InsertOrAssign(_name, _value); });
+
+        const auto [globalRate, globalSum] = run(
+            numThreads,
+            [&](const std::string &_name) {
+                std::shared_lock lock(globalMutex);
+                return global.find(_name)->second;
+            },
+            [&](const std::string &_name, uint64_t _value) {
+                std::unique_lock lock(globalMutex);
+                global[_name] = _value;
+            });
+
+        EXPECT_EQ(shardedSum, globalSum);
+
+        results << numThreads << "t " << shardedRate << " vs " << globalRate << ", ";
+    }
+
+    std::cout << "[ BENCHMARK] Registry operations (Mops/s, ConcurrentHashMap vs std::unordered_map + global lock): "
+              << results.str() << "on " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <RKRuntime/core/event_system.hpp>
+
+TEST(EventSystemTest, NotifyEventsTest) {
+    Rake::core::EventProducer<int> producer;
+
+    std::vector<int> received;
+    int sum = 0;
+
+    producer.AddHandler(Rake::core::EventHandler<int>([&received](const int &_data) { received.push_back(_data); }));
+    producer.AddHandler(Rake::core::EventHandler<int>([&sum](const int &_data) { sum += _data; }));
+
+    // Handlers are grouped by the thread that added them, every group sees every event.
+    std::thread([&producer, &sum]() {
+        producer.AddHandler(Rake::core::EventHandler<int>([&sum](const int &_data) { sum += _data; }));
+    }).join();
+
+    EXPECT_FALSE(producer.HasPendingEvents());
+
+    producer.RegisterEvent(1);
+    producer.RegisterEvent(Rake::core::Event<int>(2));
+
+    EXPECT_TRUE(producer.HasPendingEvents());
+
+    producer.NotifyEvents();
+
+    EXPECT_FALSE(producer.HasPendingEvents());
+    EXPECT_EQ(received, std::vector<int>({1, 2}));
+    EXPECT_EQ(sum, 6);
+
+    // Unregistered events are dropped without reaching the handlers.
+    producer.RegisterEvent(3);
+    producer.UnregisterAllEvents();
+    producer.NotifyEvents();
+
+    EXPECT_EQ(received.size(), 2);
+
+    producer.RemoveAllHandlers();
+    producer.RegisterEvent(4);
+    producer.NotifyEvents();
+
+    EXPECT_EQ(received.size(), 2);
+    EXPECT_EQ(sum, 6);
+}
+
+TEST(EventSystemTest, ConcurrentProducersTest) {
+    constexpr size_t numThreads = 8;
+    constexpr size_t numEvents = 2000;
+
+    Rake::libraries::SlabAllocator allocator;
+    Rake::core::EventProducer<size_t> producer(allocator);
+
+    size_t notified = 0;
+    size_t sum = 0;
+
+    producer.AddHandler(Rake::core::EventHandler<size_t>([&notified, &sum](const size_t &_data) {
+        notified++;
+        sum += _data;
+    }));
+
+    std::atomic<bool> producing = true;
+
+    // Events are registered without the handler lock while the consumer keeps draining them.
+    std::thread consumer([&producer, &producing]() {
+        while (producing.load(std::memory_order_acquire)) producer.NotifyEvents();
+    });
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&producer]() {
+            for (size_t j = 0; j < numEvents; ++j) producer.RegisterEvent(j);
+        });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    producing.store(false, std::memory_order_release);
+    consumer.join();
+
+    producer.NotifyEvents();
+
+    EXPECT_EQ(notified, numThreads * numEvents);
+    EXPECT_EQ(sum, numThreads * numEvents * (numEvents - 1) / 2);
+
+    size_t liveBlocks = 0;
+
+    for (const auto &sizeClass : allocator.GetStatistics()) liveBlocks += sizeClass.liveBlocks;
+
+    // The handler shares one block with its control block, the map holds a node and a bucket array.
+    EXPECT_GT(liveBlocks, 0);
+
+    producer.RemoveAllHandlers();
+}
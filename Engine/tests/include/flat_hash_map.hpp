@@ -0,0 +1,311 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <memory_resource>
+
+#include <RKSTL/flat_hash_map.hpp>
+
+TEST(FlatHashMapTest, StringKeysTest) {
+    Rake::libraries::FlatHashMap<std::string, int> map = {{"MoveForward", 1}, {"MoveBack", 2}};
+
+    map["Jump"] = 3;
+
+    // Lookups go through string_view and literals without building a std::string.
+    const std::string_view jump = "Jump";
+
+    EXPECT_EQ(map.At(jump), 3);
+    EXPECT_EQ(map.Find("MoveBack")->second, 2);
+    EXPECT_TRUE(map.Contains(std::string("MoveForward")));
+    EXPECT_FALSE(map.Contains("Crouch"));
+    EXPECT_THROW((void)map.At("Crouch"), std::out_of_range);
+
+    // TryEmplace leaves an existing value alone, InsertOrAssign overwrites it.
+    EXPECT_FALSE(map.TryEmplace("Jump", 10).second);
+    EXPECT_EQ(map["Jump"], 3);
+    EXPECT_FALSE(map.InsertOrAssign(jump, 10).second);
+    EXPECT_EQ(map["Jump"], 10);
+    EXPECT_TRUE(map.Insert({"Crouch", 4}).second);
+    EXPECT_FALSE(map.Emplace("Crouch", 5).second);
+
+    EXPECT_EQ(map.size(), 4);
+    EXPECT_EQ(map.Erase("MoveBack"), 1);
+    EXPECT_EQ(map.Erase("MoveBack"), 0);
+
+    int sum = 0;
+
+    for (const auto &[action, value] : map) sum += value;
+
+    EXPECT_EQ(sum, 1 + 10 + 4);
+
+    Rake::libraries::FlatHashMap<std::string, int> copy(map);
+
+    copy.Erase(copy.Find("Jump"));
+
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_EQ(map.size(), 3);
+
+    Rake::libraries::FlatHashMap<std::string, int> moved(std::move(map));
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(moved.At("Jump"), 10);
+
+    moved.Clear();
+
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(moved.begin(), moved.end());
+    EXPECT_GT(moved.capacity(), 0);
+}
+
+TEST(FlatHashMapTest, RandomOperationsTest) {
+    Rake::libraries::FlatHashMap<uint64_t, uint64_t> map;
+    Rake::libraries::FlatHashSet<uint64_t> set;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 generator(3);
+
+    // A small key range makes erases and re-inserts frequent, exercising tombstones and in-place rehashes.
+    for (int i = 0; i < 200000; ++i) {
+        const uint64_t key = generator() % 4096;
+
+        if (generator() % 3 == 0) {
+            EXPECT_EQ(map.Erase(key), reference.erase(key));
+            set.Erase(key);
+        } else {
+            map[key] = i;
+            reference[key] = i;
+            set.Insert(key);
+        }
+    }
+
+    ASSERT_EQ(map.size(), reference.size());
+    ASSERT_EQ(set.size(), reference.size());
+    EXPECT_LE(map.GetLoadFactor(), 0.875f);
+
+    for (const auto &[key, value] : reference) {
+        auto it = map.Find(key);
+
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second, value);
+        EXPECT_TRUE(set.Contains(key));
+    }
+
+    size_t visited = 0;
+
+    for (auto it = map.begin(); it != map.end();) {
+        EXPECT_TRUE(reference.contains(it->first));
+
+        // Erasing through iterators while walking the table visits every element once.
+        it = (visited++ % 2 == 0) ? map.Erase(it) : std::next(it);
+    }
+
+    EXPECT_EQ(visited, reference.size());
+    EXPECT_EQ(map.size(), reference.size() / 2);
+}
+
+TEST(FlatHashMapTest, ThrowingCopyRehashTest) {
+    struct Counted {
+        int *copiesLeft;
+        int value;
+
+        Counted(int *_copiesLeft, int _value) : copiesLeft(_copiesLeft), value(_value) {}
+
+        Counted(const Counted &_other) : copiesLeft(_other.copiesLeft), value(_other.value) {
+            if ((*copiesLeft)-- == 0) throw std::runtime_error("copy");
+        }
+
+        // A move that may throw makes the rehash copy instead.
+        Counted(Counted &&_other) : Counted(static_cast<const Counted &>(_other)) {}
+    };
+
+    int copiesLeft = 1 << 30;
+    Rake::libraries::FlatHashMap<int, Counted> map;
+
+    for (int i = 0; i < 100; ++i) map.TryEmplace(i, &copiesLeft, i * 2);
+
+    const size_t capacity = map.capacity();
+
+    copiesLeft = 10;
+
+    EXPECT_THROW(map.Reserve(capacity * 4), std::runtime_error);
+
+    // The failed rehash leaves the old table in place with every element intact.
+    EXPECT_EQ(map.capacity(), capacity);
+    ASSERT_EQ(map.size(), 100);
+
+    for (int i = 0; i < 100; ++i) {
+        auto it = map.Find(i);
+
+        ASSERT_NE(it, map.end());
+        EXPECT_EQ(it->second.value, i * 2);
+    }
+
+    copiesLeft = 1 << 30;
+
+    map.Reserve(capacity * 4);
+
+    EXPECT_GT(map.capacity(), capacity);
+    EXPECT_EQ(map.size(), 100);
+    EXPECT_EQ(map.Find(99)->second.value, 198);
+
+    using CountedMap = Rake::libraries::FlatHashMap<int, Counted>;
+
+    // A copy or an initializer list interrupted by a throwing element releases what it built so far.
+    copiesLeft = 10;
+
+    EXPECT_THROW(CountedMap{map}, std::runtime_error);
+
+    const std::initializer_list<CountedMap::value_type> values = {
+        {1, Counted(&copiesLeft, 1)}, {2, Counted(&copiesLeft, 2)}, {3, Counted(&copiesLeft, 3)}};
+
+    copiesLeft = 1;
+
+    EXPECT_THROW(CountedMap{values}, std::runtime_error);
+
+    EXPECT_EQ(map.size(), 100);
+}
+
+TEST(FlatHashMapTest, AllocatorTest) {
+    struct CountingResource final : public std::pmr::memory_resource {
+        size_t bytes = 0;
+
+        void *do_allocate(size_t _bytes, size_t _alignment) override {
+            bytes += _bytes;
+            return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+        }
+
+        void do_deallocate(void *_ptr, size_t _bytes, size_t _alignment) override {
+            bytes -= _bytes;
+            std::pmr::new_delete_resource()->deallocate(_ptr, _bytes, _alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override { return this == &_other; }
+    };
+
+    using PmrMap = Rake::libraries::FlatHashMap<std::pmr::string, int, Rake::libraries::StringHash,
+                                                Rake::libraries::StringEqual,
+                                                std::pmr::polymorphic_allocator<std::pair<std::pmr::string, int>>>;
+
+    CountingResource resource;
+    CountingResource otherResource;
+
+    {
+        PmrMap map(&resource);
+
+        for (int i = 0; i < 100; ++i) {
+            map.TryEmplace("a key long enough to skip the small string buffer " + std::to_string(i), i);
+        }
+
+        // The table and the names come from the resource given to the map.
+        EXPECT_GE(resource.bytes, map.capacity() * sizeof(PmrMap::value_type) + 100 * 50);
+        EXPECT_EQ(map.Find("a key long enough to skip the small string buffer 42")->first.get_allocator().resource(),
+                  &resource);
+
+        // A polymorphic allocator does not propagate: copies use the default resource and a move to another resource
+        // moves the elements one by one.
+        PmrMap copy(map);
+
+        EXPECT_EQ(copy.GetAllocator().resource(), std::pmr::get_default_resource());
+        EXPECT_EQ(copy.size(), 100);
+
+        PmrMap moved(&otherResource);
+
+        moved = std::move(map);
+
+        EXPECT_EQ(moved.GetAllocator().resource(), &otherResource);
+        EXPECT_EQ(moved.size(), 100);
+        EXPECT_EQ(moved.Find("a key long enough to skip the small string buffer 42")->second, 42);
+        EXPECT_EQ(resource.bytes, 0);
+        EXPECT_GT(otherResource.bytes, 0);
+    }
+
+    EXPECT_EQ(otherResource.bytes, 0);
+}
+
+TEST(FlatHashMapTest, DISABLED_BenchmarkTest) {
+    constexpr size_t numKeys = 1 << 14;
+    constexpr int numPasses = 32;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::mt19937_64 generator(11);
+
+    auto measure = [&](const auto &_keys, const auto &_misses) {
+        using Key = typename std::decay_t<decltype(_keys)>::value_type;
+
+        Rake::libraries::FlatHashMap<Key, uint32_t> flat;
+        std::unordered_map<Key, uint32_t> standard;
+
+        for (uint32_t i = 0; i < _keys.size(); ++i) {
+            flat[_keys[i]] = i;
+            standard[_keys[i]] = i;
+        }
+
+        auto time = [&](auto &_map) {
+            uint64_t sum = 0;
+            const auto start = Clock::now();
+
+            for (int pass = 0; pass < numPasses; ++pass) {
+                for (const Key &key : _keys) sum += _map.find(key)->second;
+                for (const Key &key : _misses) sum += _map.find(key) == _map.end();
+            }
+
+            const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+            return std::make_pair(elapsed / (numPasses * (_keys.size() + _misses.size())), sum);
+        };
+
+        struct FlatAdapter {
+            Rake::libraries::FlatHashMap<Key, uint32_t> &map;
+
+            auto find(const Key &_key) const { return map.Find(_key); }
+            auto end() const { return map.end(); }
+        } adapter{flat};
+
+        const auto [flatTime, flatSum] = time(adapter);
+        const auto [standardTime, standardSum] = time(standard);
+
+        EXPECT_EQ(flatSum, standardSum);
+
+        return std::make_pair(flatTime, standardTime);
+    };
+
+    // Input actions and registry names.
+    std::vector<std::string> names, missingNames;
+
+    for (size_t i = 0; i < numKeys; ++i) {
+        names.push_back("Action" + std::to_string(generator()));
+        missingNames.push_back("Missing" + std::to_string(i));
+    }
+
+    // Entity UUIDs.
+    std::vector<uint64_t> uuids, missingUuids;
+
+    for (size_t i = 0; i < numKeys; ++i) {
+        uuids.push_back(generator());
+        missingUuids.push_back(generator());
+    }
+
+    // Native window handles, aligned pointers with low entropy in the low bits.
+    std::vector<void *> handles, missingHandles;
+
+    for (size_t i = 0; i < numKeys; ++i) {
+        handles.push_back(reinterpret_cast<void *>(0x10000 + i * 64));
+        missingHandles.push_back(reinterpret_cast<void *>(0x10000 + (numKeys + i) * 64));
+    }
+
+    const auto [flatNames, standardNames] = measure(names, missingNames);
+    const auto [flatUuids, standardUuids] = measure(uuids, missingUuids);
+    const auto [flatHandles, standardHandles] = measure(handles, missingHandles);
+
+    std::cout << "[ BENCHMARK] Lookups over " << numKeys << " keys (ns/lookup, FlatHashMap vs std::unordered_map): "
+              << "std::string " << flatNames << " vs " << standardNames << ", uint64_t " << flatUuids << " vs "
+              << standardUuids << ", void* " << flatHandles << " vs " << standardHandles << std::endl;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include <RKRuntime/core/input_system.hpp>
+
+TEST(InputMappingsTest, RoundTripTest) {
+    using namespace Rake;
+
+    core::InputMap<core::KeyboardKeys> inputMap;
+
+    inputMap[libraries::StringId::Intern("MoveForward")] = core::KeyboardKeys::w;
+    inputMap[libraries::StringId::Intern("Jump")] = core::KeyboardKeys::space;
+    inputMap[libraries::StringId::Intern("Unnamed")] = static_cast<core::KeyboardKeys>(0xFF);
+    inputMap[libraries::StringId("NeverInterned")] = core::KeyboardKeys::escape;
+
+    // Inputs are saved by name, or by value when they have none, and actions without a name are saved by hash.
+    const nlohmann::json data = nlohmann::json::parse(core::WriteInputMap(inputMap, core::c_keyboardKeyNames).dump());
+
+    EXPECT_EQ(data.size(), 4);
+    EXPECT_EQ(data["Jump"], "space");
+    EXPECT_EQ(data["Unnamed"], 0xFF);
+    EXPECT_EQ(data[core::GetActionKey(libraries::StringId("NeverInterned"))], "escape");
+
+    core::InputMap<core::KeyboardKeys> loaded;
+
+    EXPECT_TRUE(core::ReadInputMap(data, loaded, core::c_keyboardKeyNames).empty());
+    EXPECT_EQ(loaded.size(), 4);
+    EXPECT_EQ(loaded[libraries::StringId("NeverInterned")], core::KeyboardKeys::escape);
+
+    for (const auto &[action, key] : loaded) EXPECT_EQ(inputMap[action], key);
+}
+
+TEST(InputMappingsTest, BadEntriesTest) {
+    using namespace Rake;
+
+    const nlohmann::json data = {
+        {"MoveForward", "w"}, {"Jump", "spcae"}, {"Crouch", 0x11}, {"Dash", -1}, {"Roll", 300}, {"Aim", 1.5},
+    };
+
+    core::InputMap<core::KeyboardKeys> inputMap;
+
+    std::vector<std::string> skipped = core::ReadInputMap(data, inputMap, core::c_keyboardKeyNames);
+
+    // A misspelled name or an invalid value only drops its own entry.
+    std::sort(skipped.begin(), skipped.end());
+
+    EXPECT_EQ(skipped, (std::vector<std::string>{"Aim", "Dash", "Jump", "Roll"}));
+    EXPECT_EQ(inputMap.size(), 2);
+    EXPECT_EQ(inputMap[libraries::StringId("MoveForward")], core::KeyboardKeys::w);
+    EXPECT_EQ(inputMap[libraries::StringId("Crouch")], core::KeyboardKeys::control);
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include <RKSTL/list.hpp>
+
+struct ListItem : public Rake::libraries::IntrusiveListHook<>,
+                  public Rake::libraries::IntrusiveListHook<struct ListItemTag> {
+    int value = 0;
+
+    explicit ListItem(int _value = 0) : value(_value) {}
+};
+
+using ItemList = Rake::libraries::IntrusiveList<ListItem>;
+using TaggedItemList = Rake::libraries::IntrusiveList<ListItem, ListItemTag>;
+using LabeledItemList = Rake::libraries::IntrusiveList<ListItem, void, true>;
+
+template <typename List>
+std::vector<int> ListValues(const List &_list) {
+    std::vector<int> values;
+
+    for (const ListItem &item : _list) values.push_back(item.value);
+
+    return values;
+}
+
+TEST(IntrusiveListTest, InsertEraseTest) {
+    std::vector<ListItem> items;
+
+    for (int i = 0; i < 5; ++i) items.emplace_back(i);
+
+    ItemList list;
+
+    for (ListItem &item : items) list.PushBack(item);
+
+    // Inserting in the middle links in place, no following node is touched.
+    ListItem middle(42);
+
+    list.Insert(ItemList::GetIterator(items[2]), middle);
+
+    EXPECT_EQ(ListValues(list), (std::vector<int>{0, 1, 42, 2, 3, 4}));
+    EXPECT_EQ(list.size(), 6);
+    EXPECT_THROW(list.PushFront(middle), std::invalid_argument);
+
+    list.Remove(items[0]);
+    list.Erase(ItemList::GetIterator(middle));
+
+    EXPECT_FALSE(middle.Rake::libraries::IntrusiveListHook<>::IsLinked());
+    EXPECT_EQ(list.PopBack().value, 4);
+    EXPECT_EQ(list.PopFront().value, 1);
+    EXPECT_EQ(ListValues(list), (std::vector<int>{2, 3}));
+
+    // The same elements can belong to another list through a second hook.
+    TaggedItemList tagged;
+
+    for (ListItem &item : items) tagged.PushFront(item);
+
+    EXPECT_EQ(ListValues(tagged), (std::vector<int>{4, 3, 2, 1, 0}));
+
+    list.Clear();
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_FALSE(items[2].Rake::libraries::IntrusiveListHook<>::IsLinked());
+    EXPECT_EQ(tagged.size(), 5);
+}
+
+TEST(IntrusiveListTest, SpliceTest) {
+    std::vector<ListItem> items;
+
+    for (int i = 0; i < 8; ++i) items.emplace_back(i);
+
+    ItemList left, right;
+
+    for (int i = 0; i < 4; ++i) left.PushBack(items[i]);
+    for (int i = 4; i < 8; ++i) right.PushBack(items[i]);
+
+    left.Splice(ItemList::GetIterator(items[2]), right);
+
+    EXPECT_EQ(ListValues(left), (std::vector<int>{0, 1, 4, 5, 6, 7, 2, 3}));
+    EXPECT_TRUE(right.empty());
+
+    right.Splice(right.end(), left, ItemList::GetIterator(items[5]), ItemList::GetIterator(items[2]));
+
+    EXPECT_EQ(ListValues(left), (std::vector<int>{0, 1, 4, 2, 3}));
+    EXPECT_EQ(ListValues(right), (std::vector<int>{5, 6, 7}));
+    EXPECT_EQ(left.size() + right.size(), 8);
+
+    left.Splice(left.begin(), left, ItemList::GetIterator(items[3]));
+
+    EXPECT_EQ(ListValues(left), (std::vector<int>{3, 0, 1, 4, 2}));
+
+    ItemList moved(std::move(right));
+
+    EXPECT_TRUE(right.empty());
+    EXPECT_EQ(ListValues(moved), (std::vector<int>{5, 6, 7}));
+}
+
+TEST(IntrusiveListTest, OrderLabelsTest) {
+    constexpr int c_itemCount = 4096;
+
+    std::vector<ListItem> items(c_itemCount);
+    std::mt19937 generator(42);
+
+    LabeledItemList list;
+
+    // Front and repeated same-position inserts exhaust the label gaps and force relabeling.
+    for (int i = 0; i < c_itemCount; ++i) {
+        items[i].value = i;
+
+        if (list.empty() || i % 3 == 0) {
+            list.PushFront(items[i]);
+        } else {
+            list.Insert(LabeledItemList::GetIterator(items[generator() % i]), items[i]);
+        }
+    }
+
+    std::vector<ListItem *> order;
+
+    for (ListItem &item : list) order.push_back(&item);
+
+    ASSERT_EQ(order.size(), c_itemCount);
+
+    for (size_t i = 1; i < order.size(); ++i) {
+        EXPECT_TRUE(list.Precedes(*order[i - 1], *order[i]));
+        EXPECT_FALSE(list.Precedes(*order[i], *order[i - 1]));
+    }
+
+    LabeledItemList other;
+    ListItem extra[2];
+
+    other.PushBack(extra[0]);
+    other.PushBack(extra[1]);
+
+    list.Splice(LabeledItemList::GetIterator(*order[10]), other);
+
+    EXPECT_TRUE(list.Precedes(*order[9], extra[0]));
+    EXPECT_TRUE(list.Precedes(extra[0], extra[1]));
+    EXPECT_TRUE(list.Precedes(extra[1], *order[10]));
+
+    list.Clear();
+}
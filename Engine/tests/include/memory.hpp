@@ -0,0 +1,152 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <RKSTL/memory.hpp>
+
+TEST(MemoryTest, LinearArenaAlignmentTest) {
+    Rake::libraries::LinearArena arena(1024);
+
+    for (size_t alignment : {1, 2, 8, 16, 64, 256}) {
+        void *ptr = arena.Allocate(3, alignment);
+
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignment, 0);
+    }
+
+    EXPECT_THROW((void)arena.Allocate(8, 3), std::invalid_argument);
+    EXPECT_EQ(arena.GetOverflowCount(), 0);
+}
+
+TEST(MemoryTest, LinearArenaOverflowTest) {
+    Rake::libraries::LinearArena arena(256);
+
+    std::vector<uint64_t *> values;
+
+    for (uint64_t i = 0; i < 100; ++i) values.push_back(arena.Construct<uint64_t>(i));
+
+    for (uint64_t i = 0; i < 100; ++i) EXPECT_EQ(*values[i], i);
+
+    EXPECT_GT(arena.GetOverflowCount(), 0);
+    EXPECT_GE(arena.GetPeakMemory(), 100 * sizeof(uint64_t));
+
+    const size_t overflowCount = arena.GetOverflowCount();
+
+    // The block grows to the peak on reset, the same workload no longer overflows.
+    arena.Reset();
+
+    EXPECT_EQ(arena.GetUsedMemory(), 0);
+    EXPECT_GE(arena.capacity(), 100 * sizeof(uint64_t));
+
+    for (uint64_t i = 0; i < 100; ++i) (void)arena.Construct<uint64_t>(i);
+
+    EXPECT_EQ(arena.GetOverflowCount(), overflowCount);
+}
+
+TEST(MemoryTest, FrameAllocatorDoubleBufferTest) {
+    Rake::libraries::FrameAllocator allocator(1024);
+
+    allocator.BeginFrame();
+
+    char *first = allocator.AllocateArray<char>(6);
+    std::memcpy(first, "frame", 6);
+
+    allocator.BeginFrame();
+
+    char *second = allocator.AllocateArray<char>(6);
+    std::memcpy(second, "later", 6);
+
+    // The previous frame allocations survive one more frame.
+    EXPECT_STREQ(first, "frame");
+    EXPECT_EQ(allocator.GetPreviousArena().GetUsedMemory(), 6);
+
+    allocator.BeginFrame();
+
+    EXPECT_EQ(allocator.GetCurrentArena().GetUsedMemory(), 0);
+    EXPECT_EQ(allocator.AllocateArray<char>(6), first);
+}
+
+TEST(MemoryTest, StackAllocatorMarkerTest) {
+    Rake::libraries::StackAllocator stack(4096);
+
+    uint64_t *outer = stack.AllocateArray<uint64_t>(16);
+    const size_t outerUsage = stack.GetUsedMemory();
+
+    {
+        Rake::libraries::StackAllocatorScope scope(stack);
+
+        uint32_t *inner = scope.AllocateArray<uint32_t>(64);
+
+        {
+            Rake::libraries::StackAllocatorScope nested(stack);
+
+            (void)nested.Allocate(512, 64);
+
+            EXPECT_GE(stack.GetUsedMemory(), outerUsage + 64 * sizeof(uint32_t) + 512);
+        }
+
+        // The nested scope released only its own allocations.
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(scope.AllocateArray<uint32_t>(1)) % alignof(uint32_t), 0);
+        EXPECT_GT(stack.GetUsedMemory(), outerUsage + 64 * sizeof(uint32_t));
+        (void)inner;
+    }
+
+    EXPECT_EQ(stack.GetUsedMemory(), outerUsage);
+    EXPECT_GE(stack.GetHighWaterMark(), outerUsage + 64 * sizeof(uint32_t) + 512);
+
+    const auto marker = stack.GetMarker();
+
+    EXPECT_THROW((void)stack.Allocate(8192), std::bad_alloc);
+    EXPECT_EQ(stack.GetMarker(), marker);
+    EXPECT_THROW(stack.FreeToMarker(marker + 1), std::out_of_range);
+
+    stack.Reset();
+
+    EXPECT_EQ(stack.GetUsedMemory(), 0);
+    EXPECT_EQ(stack.AllocateArray<uint64_t>(16), outer);
+}
+
+#ifdef RK_DEBUG
+TEST(MemoryTest, StackAllocatorCanaryTest) {
+    Rake::libraries::StackAllocator stack(1024);
+
+    const auto marker = stack.GetMarker();
+
+    char *buffer = stack.AllocateArray<char>(16);
+
+    // Overrun the buffer into the canary that follows it.
+    std::memset(buffer, 0, 24);
+
+    EXPECT_THROW(stack.FreeToMarker(marker), std::runtime_error);
+}
+#endif
+
+TEST(MemoryTest, LinearArenaReservationTest) {
+    Rake::libraries::LinearArena arena(1024, RK_MEBIBYTES(size_t(16)));
+
+    const size_t initialCapacity = arena.capacity();
+
+    std::byte *first = static_cast<std::byte *>(arena.Allocate(512));
+    std::byte *large = static_cast<std::byte *>(arena.Allocate(RK_MEBIBYTES(size_t(4))));
+
+    std::memset(large, 0xAB, RK_MEBIBYTES(size_t(4)));
+
+    // The block is committed further in place instead of chaining an overflow page.
+    EXPECT_EQ(arena.GetOverflowCount(), 0);
+    EXPECT_GT(arena.capacity(), initialCapacity);
+    EXPECT_GT(large, first);
+
+    arena.Reset();
+    arena.Trim();
+
+    EXPECT_LT(arena.capacity(), RK_MEBIBYTES(size_t(4)));
+    EXPECT_EQ(arena.Allocate(512), first);
+
+    // Past the reservation the arena falls back to overflow pages.
+    (void)arena.Allocate(RK_MEBIBYTES(size_t(32)));
+
+    EXPECT_EQ(arena.GetOverflowCount(), 1);
+}
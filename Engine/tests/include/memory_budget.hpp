@@ -0,0 +1,164 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
+#include <RKSTL/memory_budget.hpp>
+#include <RKSTL/memory.hpp>
+
+#include <RKRuntime/tools/logger.hpp>
+#include <RKRuntime/tools/profiler.hpp>
+
+using Rake::libraries::BudgetPressure;
+using Rake::libraries::MemoryBudgetManager;
+
+TEST(MemoryBudgetTest, EvictionTest) {
+    MemoryBudgetManager manager;
+
+    size_t cacheSize = 100;
+    std::vector<std::pair<size_t, BudgetPressure>> evictions;
+
+    auto evict = [&](size_t _bytesToFree, BudgetPressure _pressure) {
+        evictions.emplace_back(_bytesToFree, _pressure);
+        cacheSize -= _bytesToFree;
+    };
+
+    manager.SetBudget(Rake::libraries::MemoryTag::files, 200, 400, evict, [&] { return cacheSize; });
+
+    EXPECT_TRUE(manager.HasBudget(Rake::libraries::MemoryTag::files));
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::none);
+    EXPECT_TRUE(evictions.empty());
+
+    // Past the soft limit the callback is asked to free the excess.
+    cacheSize = 300;
+
+    EXPECT_EQ(manager.Enforce(Rake::libraries::MemoryTag::files), BudgetPressure::none);
+    EXPECT_EQ(evictions.back(), std::make_pair(size_t(100), BudgetPressure::soft));
+    EXPECT_EQ(cacheSize, 200);
+
+    cacheSize = 1000;
+
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::none);
+    EXPECT_EQ(evictions.back(), std::make_pair(size_t(800), BudgetPressure::hard));
+
+    const auto statistics = manager.GetStatistics(Rake::libraries::MemoryTag::files);
+
+    EXPECT_EQ(statistics.softEvictions, 1);
+    EXPECT_EQ(statistics.hardEvictions, 1);
+    EXPECT_EQ(statistics.bytesEvicted, 900);
+    EXPECT_EQ(statistics.usage, 200);
+
+    manager.RemoveBudget(Rake::libraries::MemoryTag::files);
+
+    cacheSize = 1000;
+
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::none);
+    EXPECT_EQ(evictions.size(), 2);
+    EXPECT_THROW(manager.SetBudget(Rake::libraries::MemoryTag::files, 2, 1, evict), std::invalid_argument);
+}
+
+TEST(MemoryBudgetTest, TrackedUsageTest) {
+    MemoryBudgetManager manager;
+
+    std::vector<std::unique_ptr<Rake::libraries::StackAllocator>> cache;
+
+    // Without a usage callback the budget follows the live bytes the MemoryTracker accounts to the tag.
+    manager.SetBudget(
+        Rake::libraries::MemoryTag::python,
+        RK_KIBIBYTES(64),
+        RK_KIBIBYTES(128),
+        [&](size_t, BudgetPressure _pressure) {
+            if (_pressure == BudgetPressure::hard) cache.clear();
+        });
+
+    {
+        Rake::libraries::MemoryTagScope tagScope(Rake::libraries::MemoryTag::python);
+
+        for (int i = 0; i < 8; ++i) {
+            cache.push_back(std::make_unique<Rake::libraries::StackAllocator>(RK_KIBIBYTES(16)));
+        }
+    }
+
+    // Soft pressure is left to the subsystem to resolve.
+    EXPECT_EQ(manager.Enforce(Rake::libraries::MemoryTag::python), BudgetPressure::soft);
+    EXPECT_EQ(cache.size(), 8);
+
+    {
+        Rake::libraries::MemoryTagScope tagScope(Rake::libraries::MemoryTag::python);
+
+        for (int i = 0; i < 8; ++i) {
+            cache.push_back(std::make_unique<Rake::libraries::StackAllocator>(RK_KIBIBYTES(16)));
+        }
+    }
+
+    EXPECT_EQ(manager.Enforce(Rake::libraries::MemoryTag::python), BudgetPressure::none);
+    EXPECT_TRUE(cache.empty());
+    EXPECT_GE(manager.GetStatistics(Rake::libraries::MemoryTag::python).bytesEvicted, RK_KIBIBYTES(256));
+}
+
+TEST(MemoryBudgetTest, ReentrantEvictionTest) {
+    MemoryBudgetManager manager;
+
+    size_t usage = 100;
+    int evictions = 0;
+
+    // A callback checking budgets again must not recurse into its own eviction.
+    manager.SetBudget(
+        Rake::libraries::MemoryTag::logger,
+        10,
+        50,
+        [&](size_t, BudgetPressure) {
+            evictions++;
+
+            EXPECT_EQ(manager.Enforce(Rake::libraries::MemoryTag::logger), BudgetPressure::none);
+
+            usage = 20;
+        },
+        [&] { return usage; });
+
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::soft);
+    EXPECT_EQ(evictions, 1);
+}
+
+TEST(MemoryBudgetTest, SubsystemBudgetTest) {
+    using Rake::libraries::MemoryTag;
+    using Rake::tools::Logger;
+    using Rake::tools::Profiler;
+
+    MemoryBudgetManager manager;
+
+    Logger::Initialize(L"BudgetTestSession", L"./logs");
+    Profiler::Initialize(L"BudgetTestSession", L"./profiles");
+
+    Logger::RegisterMemoryBudget(manager, 512, RK_KIBIBYTES(2));
+    Profiler::RegisterMemoryBudget(manager, RK_KIBIBYTES(16), RK_MEBIBYTES(1));
+
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::none);
+
+    // Both buffers stay below the sizes at which they flush by themselves.
+    for (int i = 0; i < 20; ++i) {
+        Logger::Info(L"Budget test message {} padded to outgrow the message pool budget", i);
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        const Profiler::CounterSeries series[] = {{"value", i}};
+
+        Profiler::RecordCounter(L"BudgetTestCounter", series);
+    }
+
+    EXPECT_GT(Logger::GetBufferedBytes(), RK_KIBIBYTES(2));
+    EXPECT_GT(Profiler::GetBufferedBytes(), RK_KIBIBYTES(16));
+
+    EXPECT_EQ(manager.Enforce(), BudgetPressure::none);
+
+    EXPECT_EQ(Logger::GetBufferedBytes(), 0);
+    EXPECT_EQ(Profiler::GetBufferedBytes(), 0);
+    EXPECT_EQ(manager.GetStatistics(MemoryTag::logger).hardEvictions, 1);
+    EXPECT_EQ(manager.GetStatistics(MemoryTag::profiler).softEvictions, 1);
+
+    Profiler::Shutdown();
+    Logger::Shutdown();
+}
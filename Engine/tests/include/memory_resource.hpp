@@ -0,0 +1,104 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory_resource>
+
+#include <RKSTL/memory_resource.hpp>
+
+TEST(MemoryResourceTest, PoolResourceTest) {
+    struct CountingResource final : public std::pmr::memory_resource {
+        size_t allocations = 0;
+
+        void *do_allocate(size_t _bytes, size_t _alignment) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(_bytes, _alignment);
+        }
+
+        void do_deallocate(void *_ptr, size_t _bytes, size_t _alignment) override {
+            std::pmr::new_delete_resource()->deallocate(_ptr, _bytes, _alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &_other) const noexcept override { return this == &_other; }
+    };
+
+    CountingResource upstream;
+
+    Rake::libraries::PoolResource<64> resource(64, &upstream);
+
+    {
+        std::pmr::list<int> list(&resource);
+
+        for (int i = 0; i < 1000; ++i) list.push_back(i);
+
+        // List nodes fit a block, none of them reaches the upstream resource.
+        EXPECT_EQ(upstream.allocations, 0);
+        EXPECT_EQ(resource.GetBlockCount(), 1000);
+        EXPECT_GE(resource.GetBlockCapacity(), 1000);
+
+        list.remove_if([](int _value) { return _value % 2; });
+
+        EXPECT_EQ(resource.GetBlockCount(), 500);
+    }
+
+    EXPECT_EQ(resource.GetBlockCount(), 0);
+
+    std::pmr::unordered_map<int, int> map(&resource);
+
+    for (int i = 0; i < 100; ++i) map.emplace(i, i * i);
+
+    // Bucket arrays do not fit a block and go upstream.
+    EXPECT_GT(upstream.allocations, 0);
+    EXPECT_EQ(resource.GetBlockCount(), 100);
+
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(map.at(i), i * i);
+}
+
+TEST(MemoryResourceTest, ConcurrentStringMapTest) {
+    using Registry = Rake::libraries::PmrConcurrentStringMap<int>;
+
+    Rake::libraries::PoolResource<Registry::map_type::GetAllocationSize()> resource;
+
+    {
+        Registry registry(8, &resource);
+
+        for (int i = 0; i < 8; ++i) registry.InsertOrAssign("Window" + std::to_string(i), i);
+
+        // Shard tables that never grew fit a block, every allocation of the registry stays in the pool.
+        EXPECT_EQ(registry.GetAllocator().resource(), &resource);
+        EXPECT_GT(resource.GetBlockCount(), 0);
+        EXPECT_LE(resource.GetBlockCount(), 8);
+        EXPECT_EQ(registry.Find("Window7"), 7);
+    }
+
+    EXPECT_EQ(resource.GetBlockCount(), 0);
+}
+
+TEST(MemoryResourceTest, ArenaResourceTest) {
+    Rake::libraries::StackAllocator stack(4096);
+    Rake::libraries::ArenaResource<Rake::libraries::StackAllocator> resource(stack);
+
+    {
+        Rake::libraries::StackAllocatorScope scope(stack);
+
+        std::pmr::vector<uint64_t> values(&resource);
+
+        values.reserve(64);
+
+        for (uint64_t i = 0; i < 64; ++i) values.push_back(i);
+
+        EXPECT_GE(stack.GetUsedMemory(), 64 * sizeof(uint64_t));
+
+        std::pmr::string text("a string long enough to skip the small string buffer", &resource);
+
+        EXPECT_EQ(text.size(), 52);
+        EXPECT_EQ(values.back(), 63);
+    }
+
+    EXPECT_EQ(stack.GetUsedMemory(), 0);
+    EXPECT_EQ(&resource.GetArena(), &stack);
+}
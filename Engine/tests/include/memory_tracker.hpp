@@ -0,0 +1,136 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <memory_resource>
+
+#include <RKSTL/memory_tracker.hpp>
+#include <RKSTL/pool.hpp>
+#include <RKSTL/memory.hpp>
+#include <RKSTL/slab.hpp>
+
+using Rake::libraries::MemoryTag;
+using Rake::libraries::MemoryTracker;
+using Rake::libraries::MemoryTagScope;
+
+TEST(MemoryTrackerTest, TagScopeTest) {
+    EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTag::general);
+
+    {
+        MemoryTagScope rendererScope(MemoryTag::renderer);
+
+        EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTag::renderer);
+
+        {
+            MemoryTagScope inputScope(MemoryTag::input);
+
+            EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTag::input);
+        }
+
+        EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTag::renderer);
+    }
+
+    EXPECT_EQ(MemoryTracker::GetCurrentTag(), MemoryTag::general);
+    EXPECT_EQ(MemoryTracker::GetTagName(MemoryTag::ecs), "ECS");
+}
+
+TEST(MemoryTrackerTest, AllocatorAccountingTest) {
+    const auto before = MemoryTracker::GetStatistics(MemoryTag::files);
+
+    {
+        MemoryTagScope tagScope(MemoryTag::files);
+
+        Rake::libraries::MemoryPool<uint64_t> pool(128);
+
+        // The data of the page and its two occupancy words.
+        EXPECT_EQ(MemoryTracker::GetStatistics(MemoryTag::files).liveBytes - before.liveBytes, 128 * 8 + 2 * 8);
+
+        Rake::libraries::LinearArena arena(1024);
+        Rake::libraries::StackAllocator stack(512);
+        Rake::libraries::SlabAllocator slab;
+
+        void *block = slab.Allocate(16);
+        void *large = slab.Allocate(4096);
+
+        const auto during = MemoryTracker::GetStatistics(MemoryTag::files);
+
+        EXPECT_GE(during.liveBytes - before.liveBytes, 128 * 8 + 1024 + 512 + RK_KIBIBYTES(64) + 4096);
+        EXPECT_EQ(during.liveAllocations - before.liveAllocations, 5);
+
+        slab.Deallocate(large, 4096);
+        slab.Deallocate(block, 16);
+    }
+
+    // The allocators keep their tag after the scope ends, and give every byte back when destroyed.
+    const auto after = MemoryTracker::GetStatistics(MemoryTag::files);
+
+    EXPECT_EQ(after.liveBytes, before.liveBytes);
+    EXPECT_EQ(after.liveAllocations, before.liveAllocations);
+    EXPECT_EQ(after.totalAllocations - before.totalAllocations, 5);
+    EXPECT_GE(after.peakBytes, before.liveBytes + 128 * 8 + 1024 + 512 + RK_KIBIBYTES(64));
+}
+
+TEST(MemoryTrackerTest, ReservedGrowthAccountingTest) {
+    const auto before = MemoryTracker::GetStatistics(MemoryTag::profiler);
+
+    {
+        MemoryTagScope tagScope(MemoryTag::profiler);
+
+        Rake::libraries::MemoryPool<uint64_t> pool(1024, Rake::libraries::PoolLayout::reserved, 0, 1 << 20);
+        Rake::libraries::LinearArena arena(1024, RK_MEBIBYTES(size_t(1)));
+
+        const size_t committed = MemoryTracker::GetStatistics(MemoryTag::profiler).liveBytes - before.liveBytes;
+
+        EXPECT_GE(committed, 1024 * 8 + 1024);
+
+        // Committing more of a range resizes its allocation instead of adding one.
+        pool.Reserve(1 << 16);
+        EXPECT_NE(arena.Allocate(RK_KIBIBYTES(256)), nullptr);
+
+        const auto grown = MemoryTracker::GetStatistics(MemoryTag::profiler);
+
+        EXPECT_GE(grown.liveBytes - before.liveBytes, committed + (1 << 16) * 8 - 1024 * 8 + RK_KIBIBYTES(255));
+        EXPECT_EQ(grown.liveAllocations - before.liveAllocations, 2);
+
+        arena.Reset();
+        arena.Trim();
+        pool.Reserve(1024);
+
+        EXPECT_LT(MemoryTracker::GetStatistics(MemoryTag::profiler).liveBytes, grown.liveBytes);
+    }
+
+    EXPECT_EQ(MemoryTracker::GetStatistics(MemoryTag::profiler).liveBytes, before.liveBytes);
+    EXPECT_EQ(MemoryTracker::GetStatistics(MemoryTag::profiler).liveAllocations, before.liveAllocations);
+}
+
+TEST(MemoryTrackerTest, TrackedResourceTest) {
+    Rake::libraries::TrackedResource resource(MemoryTag::events);
+
+    MemoryTracker::ResetChurn();
+
+    const auto before = MemoryTracker::GetStatistics(MemoryTag::events);
+
+    EXPECT_EQ(before.churn, 0);
+
+    {
+        std::pmr::vector<uint32_t> values(&resource);
+
+        for (uint32_t i = 0; i < 1000; ++i) values.push_back(i);
+
+        const auto during = MemoryTracker::GetStatistics(MemoryTag::events);
+
+        EXPECT_GE(during.liveBytes - before.liveBytes, 1000 * sizeof(uint32_t));
+        EXPECT_EQ(during.liveAllocations - before.liveAllocations, 1);
+        EXPECT_GT(during.churn, 1);
+    }
+
+    const auto after = MemoryTracker::GetStatistics(MemoryTag::events);
+
+    EXPECT_EQ(after.liveBytes, before.liveBytes);
+    EXPECT_GE(after.peakBytes, before.liveBytes + 1000 * sizeof(uint32_t));
+
+    MemoryTracker::ResetChurn();
+
+    EXPECT_EQ(MemoryTracker::GetSnapshot()[static_cast<size_t>(MemoryTag::events)].churn, 0);
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <RKSTL/mpsc_queue.hpp>
+
+struct QueueItem : public Rake::libraries::MPSCQueueHook<> {
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+    uint64_t payload = 0;
+};
+
+using ItemQueue = Rake::libraries::IntrusiveMPSCQueue<QueueItem>;
+
+TEST(MPSCQueueTest, FifoTest) {
+    std::vector<QueueItem> items(16);
+    ItemQueue queue;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.TryPop(), nullptr);
+
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        items[i].sequence = i;
+        queue.Push(items[i]);
+    }
+
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.TryPop(), &items[0]);
+
+    // A batch stops at its limit and leaves the rest queued in order.
+    std::vector<uint32_t> popped;
+
+    EXPECT_EQ(queue.PopBatch([&](QueueItem &_item) { popped.push_back(_item.sequence); }, 5), 5);
+    EXPECT_EQ(popped, (std::vector<uint32_t>{1, 2, 3, 4, 5}));
+
+    // Elements pushed back from the callback are delivered after everything already queued.
+    popped.clear();
+
+    const size_t count = queue.PopBatch([&](QueueItem &_item) {
+        popped.push_back(_item.sequence);
+
+        if (popped.size() <= 2) queue.Push(_item);
+    });
+
+    EXPECT_EQ(count, 12);
+
+    EXPECT_EQ(popped, (std::vector<uint32_t>{6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 6, 7}));
+    EXPECT_TRUE(queue.empty());
+
+    // The last element is handed out too, the stub takes its place.
+    queue.Push(items[3]);
+
+    EXPECT_EQ(queue.TryPop(), &items[3]);
+    EXPECT_EQ(queue.TryPop(), nullptr);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MPSCQueueTest, ProducerOrderTest) {
+    constexpr uint32_t c_numProducers = 8;
+    constexpr uint32_t c_itemsPerProducer = 20000;
+
+    std::vector<std::vector<QueueItem>> items(c_numProducers, std::vector<QueueItem>(c_itemsPerProducer));
+    std::vector<std::thread> producers;
+    std::atomic<bool> start = false;
+    ItemQueue queue;
+
+    for (uint32_t p = 0; p < c_numProducers; ++p) {
+        producers.emplace_back([&, p] {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            for (uint32_t i = 0; i < c_itemsPerProducer; ++i) {
+                QueueItem &item = items[p][i];
+
+                // Plain writes made before Push must be visible to the consumer once it pops the element.
+                item.producer = p;
+                item.sequence = i;
+                item.payload = uint64_t(p) << 32 | i;
+
+                queue.Push(item);
+            }
+        });
+    }
+
+    start.store(true, std::memory_order_release);
+
+    std::vector<uint32_t> nextSequence(c_numProducers, 0);
+    size_t received = 0, batches = 0;
+    bool inOrder = true, intact = true;
+
+    while (received < c_numProducers * c_itemsPerProducer) {
+        received += queue.PopBatch(
+            [&](QueueItem &_item) {
+                intact &= _item.payload == (uint64_t(_item.producer) << 32 | _item.sequence);
+                inOrder &= _item.sequence == nextSequence[_item.producer]++;
+            },
+            256);
+
+        batches++;
+    }
+
+    for (std::thread &producer : producers) producer.join();
+
+    EXPECT_TRUE(intact);
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.TryPop(), nullptr);
+
+    for (uint32_t p = 0; p < c_numProducers; ++p) EXPECT_EQ(nextSequence[p], c_itemsPerProducer);
+
+    EXPECT_GT(batches, 0);
+}
+
+TEST(MPSCQueueTest, RecyclingTest) {
+    constexpr uint32_t c_numProducers = 4;
+    constexpr uint32_t c_itemsPerProducer = 64;
+    constexpr uint32_t c_rounds = 500;
+
+    // Producers push their elements again once the consumer hands them back, so every hook is reused many times.
+    std::vector<std::vector<QueueItem>> items(c_numProducers, std::vector<QueueItem>(c_itemsPerProducer));
+    std::vector<ItemQueue> returned(c_numProducers);
+    std::vector<std::thread> producers;
+    ItemQueue queue;
+
+    for (uint32_t p = 0; p < c_numProducers; ++p) {
+        producers.emplace_back([&, p] {
+            uint32_t sequence = 0;
+
+            for (QueueItem &item : items[p]) {
+                item.producer = p;
+                item.sequence = sequence++;
+                queue.Push(item);
+            }
+
+            while (sequence < c_itemsPerProducer * c_rounds) {
+                QueueItem *item = returned[p].TryPop();
+
+                if (!item) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                item->sequence = sequence++;
+                queue.Push(*item);
+            }
+        });
+    }
+
+    std::vector<uint32_t> nextSequence(c_numProducers, 0);
+    const size_t total = size_t(c_numProducers) * c_itemsPerProducer * c_rounds;
+    size_t received = 0;
+    bool inOrder = true;
+
+    while (received < total) {
+        received += queue.PopBatch([&](QueueItem &_item) {
+            inOrder &= _item.sequence == nextSequence[_item.producer]++;
+
+            returned[_item.producer].Push(_item);
+        });
+    }
+
+    for (std::thread &producer : producers) producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include <RKSTL/perfect_hash_map.hpp>
+
+enum class ProfileScope : uint8_t { function, scope, frame, gpu, io };
+
+constexpr auto c_profileScopes = Rake::libraries::MakePerfectHashMap<ProfileScope>({
+    {"function", ProfileScope::function},
+    {"scope", ProfileScope::scope},
+    {"frame", ProfileScope::frame},
+    {"gpu", ProfileScope::gpu},
+    {"io", ProfileScope::io},
+});
+
+// The lookups are constant expressions, a broken table fails the build before the tests run.
+static_assert(*c_profileScopes.Find("frame") == ProfileScope::frame);
+static_assert(c_profileScopes.Find("frames") == nullptr);
+
+TEST(PerfectHashMapTest, BasicTest) {
+    EXPECT_EQ(c_profileScopes.size(), 5);
+    EXPECT_EQ(c_profileScopes.At("gpu"), ProfileScope::gpu);
+    EXPECT_THROW((void)c_profileScopes.At("GPU"), std::out_of_range);
+
+    // Strings landing on free slots and on slots of other keys are both rejected.
+    for (std::string_view key : {"", "f", "functio", "function ", "scopes", "i", "ioo", "cpu", "Frame"}) {
+        EXPECT_FALSE(c_profileScopes.Contains(key)) << key;
+    }
+
+    // Iteration follows the order of the entries given to the builder.
+    std::vector<ProfileScope> scopes;
+
+    for (const auto &[name, scope] : c_profileScopes) {
+        EXPECT_EQ(*c_profileScopes.Find(std::string(name)), scope);
+        scopes.push_back(scope);
+    }
+
+    EXPECT_EQ(scopes.front(), ProfileScope::function);
+    EXPECT_EQ(scopes.back(), ProfileScope::io);
+}
+
+// Key names as written in InputMappings.json, enough of them to fill buckets of several keys.
+constexpr auto c_inputNames = Rake::libraries::MakePerfectHashMap<uint8_t>({
+    {"backspace", 0x08}, {"tab", 0x09},       {"clear", 0x0C},     {"returnKey", 0x0D}, {"shift", 0x10},
+    {"control", 0x11},   {"menu", 0x12},      {"pause", 0x13},     {"capital", 0x14},   {"escape", 0x1B},
+    {"space", 0x20},     {"pageUp", 0x21},    {"pageDown", 0x22},  {"end", 0x23},       {"home", 0x24},
+    {"left", 0x25},      {"up", 0x26},        {"right", 0x27},     {"down", 0x28},      {"insert", 0x2D},
+    {"deleteKey", 0x2E}, {"zero", 0x30},      {"one", 0x31},       {"two", 0x32},       {"three", 0x33},
+    {"four", 0x34},      {"five", 0x35},      {"six", 0x36},       {"seven", 0x37},     {"eight", 0x38},
+    {"nine", 0x39},      {"a", 0x41},         {"b", 0x42},         {"c", 0x43},         {"d", 0x44},
+    {"e", 0x45},         {"f", 0x46},         {"g", 0x47},         {"h", 0x48},         {"i", 0x49},
+    {"j", 0x4A},         {"k", 0x4B},         {"l", 0x4C},         {"m", 0x4D},         {"n", 0x4E},
+    {"o", 0x4F},         {"p", 0x50},         {"q", 0x51},         {"r", 0x52},         {"s", 0x53},
+    {"t", 0x54},         {"u", 0x55},         {"v", 0x56},         {"w", 0x57},         {"x", 0x58},
+    {"y", 0x59},         {"z", 0x5A},         {"numpad0", 0x60},   {"numpad1", 0x61},   {"numpad2", 0x62},
+    {"numpad3", 0x63},   {"numpad4", 0x64},   {"numpad5", 0x65},   {"numpad6", 0x66},   {"numpad7", 0x67},
+    {"numpad8", 0x68},   {"numpad9", 0x69},   {"f1", 0x70},        {"f2", 0x71},        {"f3", 0x72},
+    {"f4", 0x73},        {"f5", 0x74},        {"f6", 0x75},        {"f7", 0x76},        {"f8", 0x77},
+    {"f9", 0x78},        {"f10", 0x79},       {"f11", 0x7A},       {"f12", 0x7B},       {"lShift", 0xA0},
+    {"rShift", 0xA1},    {"lControl", 0xA2},  {"rControl", 0xA3},  {"lMenu", 0xA4},     {"rMenu", 0xA5},
+});
+
+TEST(PerfectHashMapTest, DISABLED_BenchmarkTest) {
+    constexpr int numPasses = 10000;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::unordered_map<std::string_view, uint8_t> names;
+    std::vector<std::string> keys;
+
+    // Parsing reads the names from the file, so the lookups take runtime strings.
+    for (const auto &[name, key] : c_inputNames) {
+        names[name] = key;
+        keys.emplace_back(name);
+        keys.emplace_back(std::string(name) + "Unbound");
+    }
+
+    uint64_t perfectSum = 0, unorderedSum = 0;
+
+    auto start = Clock::now();
+
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (const std::string &key : keys) {
+            const uint8_t *value = c_inputNames.Find(key);
+            perfectSum += value != nullptr ? *value : 1;
+        }
+    }
+
+    const double perfectTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (const std::string &key : keys) {
+            auto it = names.find(key);
+            unorderedSum += it != names.end() ? it->second : 1;
+        }
+    }
+
+    const double unorderedTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    EXPECT_EQ(perfectSum, unorderedSum);
+
+    std::cout << "[ BENCHMARK] Lookups over " << c_inputNames.size() << " names, half of them misses (ns/lookup): "
+              << "PerfectHashMap " << perfectTime / (numPasses * keys.size())
+              << ", std::unordered_map<std::string_view> " << unorderedTime / (numPasses * keys.size()) << std::endl;
+}
@@ -0,0 +1,621 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <shared_mutex>
+
+#include <RKSTL/pool.hpp>
+
+TEST(MemoryPoolTest, ReusesReleasedOffsetsTest) {
+    Rake::libraries::MemoryPool<int> pool(8);
+
+    std::vector<int *> ptrs;
+
+    for (int i = 0; i < 8; ++i) ptrs.push_back(pool.Allocate(i));
+
+    EXPECT_THROW(pool.Allocate(8), std::runtime_error);
+
+    pool.Deallocate(ptrs[3]);
+    pool.Deallocate(ptrs[5]);
+
+    EXPECT_EQ(pool.size(), 6);
+    EXPECT_EQ(pool.Construct(42), ptrs[5]);
+    EXPECT_EQ(pool.AllocateAt(7, 3), ptrs[3]);
+    EXPECT_THROW(pool.Allocate(8), std::runtime_error);
+}
+
+TEST(MemoryPoolTest, ReallocateTest) {
+    Rake::libraries::MemoryPool<int> pool(4);
+
+    pool.ConstructAt(0, 10);
+    pool.ConstructAt(1, 11);
+
+    EXPECT_EQ(*pool.Reallocate(0, 3), 10);
+    EXPECT_THROW(pool.Reallocate(0, 2), std::runtime_error);
+    EXPECT_THROW(pool.Reallocate(1, 3), std::runtime_error);
+
+    // Freeing the moved element twice only releases its offset once.
+    pool.Deallocate(&pool[3]);
+    pool.Deallocate(&pool[3]);
+
+    EXPECT_EQ(pool.size(), 1);
+
+    std::vector<int *> ptrs;
+
+    for (int i = 0; i < 3; ++i) ptrs.push_back(pool.Construct(i));
+
+    EXPECT_THROW(pool.Construct(3), std::runtime_error);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::sort(ptrs.begin(), ptrs.end());
+
+    EXPECT_EQ(std::adjacent_find(ptrs.begin(), ptrs.end()), ptrs.end());
+    EXPECT_EQ(pool[1], 11);
+}
+
+TEST(MemoryPoolTest, ThreadCachesTest) {
+    constexpr size_t numThreads = 8;
+    constexpr size_t numAllocations = 10000;
+
+    Rake::libraries::MemoryPool<size_t> pool(numThreads * numAllocations);
+
+    auto threadFunc = [&pool](size_t _idx) {
+        std::vector<size_t *> ptrs;
+
+        for (size_t round = 0; round < 10; ++round) {
+            for (size_t i = 0; i < numAllocations; ++i) ptrs.push_back(pool.Construct(_idx));
+
+            for (auto ptr : ptrs) {
+                EXPECT_EQ(*ptr, _idx);
+                pool.Deallocate(ptr);
+            }
+
+            ptrs.clear();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(threadFunc, i);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    const auto statistics = pool.GetStatistics();
+
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_LT(statistics.lockAcquisitions, numThreads * numAllocations * 10 / 8);
+}
+
+TEST(MemoryPoolTest, ThreadCacheEvictionTest) {
+    using Pool = Rake::libraries::MemoryPool<uint16_t>;
+
+    // Pools created in a row get consecutive identifiers, the first and the last share a thread cache slot.
+    std::vector<std::unique_ptr<Pool>> pools;
+
+    for (int i = 0; i < 9; ++i) pools.push_back(std::make_unique<Pool>(64));
+
+    Pool &first = *pools.front();
+    Pool &last = *pools.back();
+
+    std::vector<uint16_t *> ptrs;
+
+    for (uint16_t i = 0; i < 64; ++i) ptrs.push_back(first.Construct(i));
+    for (auto ptr : ptrs) first.Deallocate(ptr);
+
+    // Taking over the slot hands the cached offsets back to their pool instead of stranding them.
+    (void)last.Construct(uint16_t(0));
+
+    std::thread([&first]() {
+        for (uint16_t i = 0; i < 64; ++i) (void)first.Construct(i);
+        for (uint16_t i = 0; i < 64; ++i) first.Deallocate(&first[i]);
+    }).join();
+
+    // The exited thread returned its cache as well, no offset has to be recovered by rebuilding the free stack.
+    for (uint16_t i = 0; i < 64; ++i) (void)first.Construct(i);
+
+    EXPECT_EQ(first.size(), 64);
+    EXPECT_EQ(first.GetStatistics().reclaims, 0);
+    EXPECT_THROW((void)first.Construct(uint16_t(0)), std::runtime_error);
+}
+
+TEST(MemoryPoolTest, ConcurrentExhaustionTest) {
+    Rake::libraries::MemoryPool<int> pool(1000);
+
+    std::atomic<size_t> allocations = 0;
+
+    auto threadFunc = [&pool, &allocations]() {
+        try {
+            while (true) {
+                pool.Construct(1);
+                allocations++;
+            }
+        } catch (const std::runtime_error &) {
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back(threadFunc);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(allocations, 1000);
+    EXPECT_EQ(pool.size(), 1000);
+}
+
+TEST(MemoryPoolTest, LiveIterationTest) {
+    Rake::libraries::MemoryPool<int> pool(200);
+
+    std::vector<int *> ptrs;
+
+    for (int i = 0; i < 200; ++i) ptrs.push_back(pool.Construct(i));
+
+    for (int i = 0; i < 200; ++i) {
+        if (i % 3) pool.Deallocate(ptrs[i]);
+    }
+
+    std::vector<int> visited;
+
+    pool.ForEachLive([&visited](int &_value) { visited.push_back(_value); });
+
+    ASSERT_EQ(visited.size(), 67);
+    for (size_t i = 0; i < visited.size(); ++i) EXPECT_EQ(visited[i], i * 3);
+
+    std::atomic<int> sum = 0;
+
+    pool.Map(std::execution::par, [&sum](int &_value) { sum += _value; });
+
+    EXPECT_EQ(sum, 3 * 66 * 67 / 2);
+
+    pool.Compact();
+
+    EXPECT_EQ(pool.size(), 67);
+    for (size_t i = 0; i < 67; ++i) EXPECT_EQ(pool[i], i * 3);
+
+    pool.Reserve(100);
+
+    EXPECT_EQ(pool.size(), 67);
+    EXPECT_EQ(pool.GetFreeMemory(), 33 * sizeof(int));
+}
+
+TEST(MemoryPoolTest, SegmentedGrowthTest) {
+    Rake::libraries::MemoryPool<size_t> pool(0, Rake::libraries::PoolLayout::segmented, 64);
+
+    std::vector<size_t *> ptrs;
+
+    for (size_t i = 0; i < 1000; ++i) ptrs.push_back(pool.Construct(i));
+
+    EXPECT_EQ(pool.size(), 1000);
+    EXPECT_EQ(pool.capacity(), 1024);
+    EXPECT_EQ(pool.GetStatistics().pageAllocations, 16);
+
+    for (size_t i = 0; i < 1000; ++i) EXPECT_EQ(*ptrs[i], i);
+
+    for (size_t i = 0; i < 1000; i += 2) pool.Deallocate(ptrs[i]);
+
+    EXPECT_EQ(pool.size(), 500);
+
+    pool.Reserve(4096);
+
+    EXPECT_EQ(pool.capacity(), 4096);
+    for (size_t i = 1; i < 1000; i += 2) EXPECT_EQ(*ptrs[i], i);
+}
+
+TEST(MemoryPoolTest, SegmentedDirectoryTest) {
+    constexpr size_t numPages = 5000;
+
+    Rake::libraries::MemoryPool<size_t> pool(0, Rake::libraries::PoolLayout::segmented, 64);
+
+    std::vector<size_t *> ptrs;
+
+    for (size_t i = 0; i < numPages * 64; ++i) ptrs.push_back(pool.Construct(i));
+
+    EXPECT_EQ(pool.capacity(), numPages * 64);
+    EXPECT_EQ(pool.GetStatistics().pageAllocations, numPages);
+
+    // Pointers from every directory block map back to their offsets, foreign pointers are ignored.
+    size_t foreign = 0;
+
+    pool.Deallocate(&foreign);
+
+    EXPECT_EQ(pool.size(), numPages * 64);
+
+    for (size_t *ptr : ptrs) pool.Deallocate(ptr);
+
+    EXPECT_EQ(pool.size(), 0);
+
+    pool.Reserve(100);
+
+    EXPECT_EQ(pool.capacity(), 128);
+    EXPECT_EQ(*pool.Construct(size_t(7)), 7);
+}
+
+TEST(MemoryPoolTest, ConcurrentSegmentedGrowthTest) {
+    constexpr size_t numThreads = 8;
+    constexpr size_t numAllocations = 5000;
+
+    Rake::libraries::MemoryPool<size_t> pool(64, Rake::libraries::PoolLayout::segmented, 64);
+
+    std::vector<std::vector<size_t *>> ptrs(numThreads);
+
+    auto threadFunc = [&pool, &ptrs](size_t _idx) {
+        for (size_t i = 0; i < numAllocations; ++i) ptrs[_idx].push_back(pool.Construct(_idx * numAllocations + i));
+
+        for (size_t i = 0; i < numAllocations; i += 2) pool.Deallocate(ptrs[_idx][i]);
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(threadFunc, i);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(pool.size(), numThreads * numAllocations / 2);
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        for (size_t j = 1; j < numAllocations; j += 2) EXPECT_EQ(*ptrs[i][j], i * numAllocations + j);
+    }
+}
+
+TEST(MemoryPoolTest, ReservedGrowthTest) {
+    Rake::libraries::MemoryPool<size_t> pool(64, Rake::libraries::PoolLayout::reserved, 0, 1 << 20);
+
+    std::vector<size_t *> ptrs;
+
+    for (size_t i = 0; i < 10000; ++i) ptrs.push_back(pool.Construct(i));
+
+    // Growth commits more of the range in place, the block never moves.
+    EXPECT_EQ(pool.size(), 10000);
+    EXPECT_GE(pool.capacity(), 10000);
+    EXPECT_EQ(&pool[0], ptrs[0]);
+    EXPECT_GT(pool.GetStatistics().pageAllocations, 0);
+
+    for (size_t i = 0; i < 10000; ++i) EXPECT_EQ(*ptrs[i], i);
+
+    pool.Reserve(1 << 20);
+
+    EXPECT_EQ(pool.capacity(), 1 << 20);
+    EXPECT_EQ(&pool[9999], ptrs[9999]);
+
+    pool.Reserve(5000);
+
+    EXPECT_EQ(pool.size(), 5000);
+    EXPECT_EQ(&pool[4999], ptrs[4999]);
+    EXPECT_THROW(pool.Reserve((1 << 20) + 1), std::bad_alloc);
+
+    Rake::libraries::MemoryPool<size_t> copy(pool);
+
+    EXPECT_EQ(copy.GetLayout(), Rake::libraries::PoolLayout::reserved);
+    EXPECT_EQ(copy.size(), 5000);
+    EXPECT_EQ(copy[4999], 4999);
+
+    while (pool.size() < (1 << 20)) (void)pool.Construct(0);
+
+    EXPECT_THROW(pool.Construct(0), std::runtime_error);
+}
+
+TEST(MemoryPoolTest, LargeReservationTest) {
+    constexpr size_t capacity = size_t(1) << 28;
+
+    // The bookkeeping follows the watermark, a capacity of this size would otherwise cost gigabytes up front.
+    Rake::libraries::MemoryPool<uint8_t> pool(capacity, Rake::libraries::PoolLayout::reserved);
+
+    for (int i = 0; i < 1000; ++i) (void)pool.Construct(static_cast<uint8_t>(i));
+
+    EXPECT_EQ(pool.capacity(), capacity);
+    EXPECT_EQ(pool.size(), 1000);
+    EXPECT_EQ(pool[999], static_cast<uint8_t>(999));
+
+    pool.Clear();
+
+    EXPECT_EQ(*pool.ConstructAt(4096, 7), 7);
+    EXPECT_EQ(pool.size(), 1);
+}
+
+TEST(MemoryPoolTest, GenerationalHandlesTest) {
+    using Pool = Rake::libraries::MemoryPool<int>;
+
+    Pool pool(128);
+
+    std::vector<Pool::Handle> handles;
+
+    for (int i = 0; i < 100; ++i) handles.push_back(pool.ConstructHandle(i));
+
+    for (int i = 0; i < 100; i += 2) pool.DeallocateHandle(handles[i]);
+
+    for (int i = 0; i < 100; i += 2) EXPECT_EQ(pool.Resolve(handles[i]), nullptr);
+
+    const Pool::Handle reused = pool.ConstructHandle(-1);
+
+    EXPECT_NE(reused, handles[98]);
+    EXPECT_EQ(pool.Resolve(handles[98]), nullptr);
+    EXPECT_EQ(*pool.Resolve(reused), -1);
+
+    pool.Compact();
+
+    EXPECT_EQ(pool.size(), 51);
+
+    for (int i = 1; i < 100; i += 2) {
+        ASSERT_NE(pool.Resolve(handles[i]), nullptr);
+        EXPECT_EQ(*pool.Resolve(handles[i]), i);
+        EXPECT_LT(pool.Resolve(handles[i]), &pool[51]);
+    }
+
+    EXPECT_EQ(*pool.Resolve(reused), -1);
+
+    pool.Clear();
+
+    EXPECT_EQ(pool.Resolve(reused), nullptr);
+    EXPECT_EQ(pool.Resolve(Pool::Handle{}), nullptr);
+}
+
+TEST(MemoryPoolTest, ElementLifetimeTest) {
+    struct Tracked {
+        std::atomic<int> *live;
+        std::string name;
+
+        Tracked(std::atomic<int> *_live, std::string _name) : live(_live), name(std::move(_name)) { ++*live; }
+        Tracked(const Tracked &_other) : live(_other.live), name(_other.name) { ++*live; }
+        Tracked(Tracked &&_other) noexcept : live(_other.live), name(std::move(_other.name)) { ++*live; }
+        ~Tracked() { --*live; }
+    };
+
+    std::atomic<int> live = 0;
+
+    {
+        Rake::libraries::MemoryPool<Tracked> pool(100);
+
+        EXPECT_EQ(live, 0);
+
+        std::vector<Tracked *> ptrs;
+
+        for (int i = 0; i < 50; ++i) ptrs.push_back(pool.Construct(&live, "element " + std::to_string(i)));
+
+        EXPECT_EQ(live, 50);
+
+        for (int i = 0; i < 50; i += 2) pool.Deallocate(ptrs[i]);
+
+        EXPECT_EQ(live, 25);
+
+        pool.Compact();
+        pool.Reserve(1000);
+
+        EXPECT_EQ(live, 25);
+        EXPECT_EQ(pool[0].name, "element 1");
+        EXPECT_EQ(pool[24].name, "element 49");
+
+        pool.Reserve(10);
+
+        EXPECT_EQ(live, 10);
+        EXPECT_EQ(pool.size(), 10);
+
+        Rake::libraries::MemoryPool<Tracked> copy(pool);
+
+        EXPECT_EQ(live, 20);
+        EXPECT_EQ(copy[9].name, "element 19");
+
+        pool.Clear();
+
+        EXPECT_EQ(live, 10);
+    }
+
+    EXPECT_EQ(live, 0);
+}
+
+TEST(MemoryPoolTest, ThrowingConstructorTest) {
+    struct Throwing {
+        int *destructions;
+        int value;
+
+        Throwing(int *_destructions, int _value) : destructions(_destructions), value(_value) {
+            if (_value < 0) throw std::invalid_argument("Negative value!");
+        }
+        ~Throwing() { ++*destructions; }
+    };
+
+    int destructions = 0;
+
+    {
+        Rake::libraries::MemoryPool<Throwing> pool(4);
+
+        Throwing *first = pool.Construct(&destructions, 1);
+
+        EXPECT_THROW(pool.Construct(&destructions, -1), std::invalid_argument);
+        EXPECT_EQ(pool.size(), 1);
+
+        EXPECT_THROW(pool.ConstructAt(3, &destructions, -1), std::invalid_argument);
+        EXPECT_THROW(pool.ConstructHandle(&destructions, -1), std::invalid_argument);
+        EXPECT_EQ(pool.size(), 1);
+
+        // The released offsets are handed out again, the pool still fills up to its capacity.
+        EXPECT_NE(pool.ConstructAt(3, &destructions, 3), nullptr);
+        EXPECT_FALSE(pool.ConstructHandle(&destructions, 2).IsNull());
+        EXPECT_NE(pool.Construct(&destructions, 4), first);
+        EXPECT_THROW(pool.Construct(&destructions, 5), std::runtime_error);
+        EXPECT_EQ(pool.size(), 4);
+
+        size_t visited = 0;
+
+        pool.ForEachLive([&visited](Throwing &) { ++visited; });
+
+        EXPECT_EQ(visited, 4);
+        EXPECT_EQ(destructions, 0);
+
+        pool.Deallocate(first);
+
+        EXPECT_EQ(destructions, 1);
+    }
+
+    EXPECT_EQ(destructions, 4);
+}
+
+TEST(MemoryPoolTest, EpochClearTest) {
+    using Pool = Rake::libraries::MemoryPool<int>;
+
+    Pool pool(256);
+
+    std::vector<int *> ptrs;
+
+    for (int i = 0; i < 200; ++i) ptrs.push_back(pool.Construct(i));
+
+    const Pool::Handle handle = pool.ConstructHandle(-1);
+
+    pool.Clear();
+
+    EXPECT_EQ(pool.size(), 0);
+    EXPECT_EQ(pool.Resolve(handle), nullptr);
+
+    // Stale occupancy bits above the watermark must not be reported as live.
+    size_t visited = 0;
+
+    pool.ForEachLive([&visited](int &) { ++visited; });
+
+    EXPECT_EQ(visited, 0);
+
+    for (size_t i = 0; i < 256; ++i) EXPECT_EQ(pool.Construct(static_cast<int>(i)), i < ptrs.size() ? ptrs[i] : &pool[i]);
+
+    EXPECT_THROW(pool.Construct(0), std::runtime_error);
+    EXPECT_EQ(pool.size(), 256);
+}
+
+TEST(MemoryPoolTest, DISABLED_ClearBenchmarkTest) {
+    constexpr size_t capacity = 1 << 20;
+    constexpr size_t numFrames = 60;
+    constexpr size_t numAllocations = 4096;
+
+    Rake::libraries::MemoryPool<uint64_t> pool(capacity);
+
+    // Stand-in for the previous Clear, which swept the whole element block and occupancy flags on every call.
+    std::vector<uint64_t> sweepPool(capacity);
+    std::vector<uint8_t> sweepFlags(capacity);
+
+    std::chrono::nanoseconds clearTime(0);
+    std::chrono::nanoseconds sweepTime(0);
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        for (size_t i = 0; i < numAllocations; ++i) pool.Construct(i);
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        pool.Clear();
+
+        clearTime += std::chrono::high_resolution_clock::now() - start;
+
+        start = std::chrono::high_resolution_clock::now();
+
+        std::memset(sweepPool.data(), 0, capacity * sizeof(uint64_t));
+        std::memset(sweepFlags.data(), 0, capacity * sizeof(uint8_t));
+
+        sweepTime += std::chrono::high_resolution_clock::now() - start;
+
+        EXPECT_EQ(pool.size(), 0);
+    }
+
+    const auto clearMicroseconds = std::chrono::duration<double, std::micro>(clearTime).count() / numFrames;
+    const auto sweepMicroseconds = std::chrono::duration<double, std::micro>(sweepTime).count() / numFrames;
+
+    std::cout << "[ BENCHMARK] MemoryPool::Clear on " << capacity << " slots: " << clearMicroseconds
+              << " us/frame, full sweep: " << sweepMicroseconds << " us/frame" << std::endl;
+
+    EXPECT_EQ(sweepPool[capacity - 1] + sweepFlags[capacity - 1], 0);
+}
+
+TEST(MemoryPoolTest, DISABLED_ThreadScalingBenchmarkTest) {
+    constexpr size_t numRounds = 1 << 12;
+    constexpr size_t batchSize = 64;
+    constexpr size_t maxThreads = 16;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    // Stand-in for the previous pool, which took one exclusive lock on a shared free offsets stack per operation.
+    std::vector<uint64_t> lockedStorage(maxThreads * batchSize);
+    std::vector<size_t> lockedFreeSlots;
+    std::shared_mutex lockedMutex;
+
+    for (size_t i = lockedStorage.size(); i > 0; --i) lockedFreeSlots.push_back(i - 1);
+
+    // Every worker allocates a batch of elements and releases them, the pool holds one batch per worker at most.
+    auto run = [&](size_t _numThreads, auto &&_allocate, auto &&_deallocate) {
+        std::vector<std::thread> threads;
+
+        const auto start = Clock::now();
+
+        for (size_t t = 0; t < _numThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                uint64_t *ptrs[batchSize];
+
+                for (size_t round = 0; round < numRounds; ++round) {
+                    for (size_t i = 0; i < batchSize; ++i) ptrs[i] = _allocate(t);
+                    for (size_t i = 0; i < batchSize; ++i) _deallocate(ptrs[i]);
+                }
+            });
+        }
+
+        for (auto &thread : threads) thread.join();
+
+        const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        return _numThreads * numRounds * batchSize * 2 / elapsed / 1e6;
+    };
+
+    std::ostringstream results;
+
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        Rake::libraries::MemoryPool<uint64_t> pool(maxThreads * batchSize * 2);
+
+        const double poolRate = run(
+            numThreads,
+            [&](size_t _value) { return pool.Construct(_value); },
+            [&](uint64_t *_ptr) { pool.Deallocate(_ptr); });
+
+        const double lockedRate = run(
+            numThreads,
+            [&](size_t _value) {
+                std::unique_lock lock(lockedMutex);
+
+                uint64_t *ptr = &lockedStorage[lockedFreeSlots.back()];
+
+                lockedFreeSlots.pop_back();
+                *ptr = _value;
+
+                return ptr;
+            },
+            [&](uint64_t *_ptr) {
+                std::unique_lock lock(lockedMutex);
+
+                lockedFreeSlots.push_back(_ptr - lockedStorage.data());
+            });
+
+        EXPECT_EQ(pool.size(), 0);
+
+        results << numThreads << "t " << poolRate << " vs " << lockedRate << " (" << pool.GetStatistics().lockContentions
+                << " contended), ";
+    }
+
+    EXPECT_EQ(lockedFreeSlots.size(), lockedStorage.size());
+
+    std::cout << "[ BENCHMARK] Construct/Deallocate (Mops/s, MemoryPool vs global lock): " << results.str() << "on "
+              << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+}
@@ -4,6 +4,8 @@
 
 #include <thread>
 #include <vector>
+#include <fstream>
+#include <filesystem>
 
 #include <RKRuntime/tools/profiler.hpp>
 
@@ -56,3 +58,43 @@ TEST(ProfilerTest, ThreadSafetyTest) {
 
     Rake::tools::Profiler::Shutdown();
 }
+
+TEST(ProfilerTest, FlushTest) {
+    namespace fs = std::filesystem;
+
+    constexpr int numCounters = 10000;
+
+    Rake::tools::Profiler::Initialize(L"FlushTestSession", L"./profiles");
+
+    for (int i = 0; i < numCounters; ++i) {
+        const Rake::tools::Profiler::CounterSeries series[] = {{"value", i}};
+
+        Rake::tools::Profiler::RecordCounter(L"FlushTestCounter", series);
+    }
+
+    // Full buffers are written out as the events come, only the last partial one is left.
+    EXPECT_LT(Rake::tools::Profiler::GetBufferedEventCount(), static_cast<size_t>(numCounters));
+
+    Rake::tools::Profiler::Flush();
+
+    EXPECT_EQ(Rake::tools::Profiler::GetBufferedEventCount(), 0);
+
+    Rake::tools::Profiler::Shutdown();
+
+    fs::path profilePath;
+
+    for (const auto &entry : fs::directory_iterator("./profiles")) {
+        if (entry.path().filename().string().starts_with("FlushTestSession_")) profilePath = entry.path();
+    }
+
+    ASSERT_FALSE(profilePath.empty());
+
+    std::ifstream file(profilePath);
+    const nlohmann::json trace = nlohmann::json::parse(file);
+
+    ASSERT_EQ(trace["traceEvents"].size(), numCounters);
+    EXPECT_EQ(trace["traceEvents"].back()["args"]["value"], numCounters - 1);
+
+    file.close();
+    fs::remove(profilePath);
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <iostream>
+#include <stdexcept>
+
+#include <RKSTL/ring_buffer.hpp>
+
+TEST(SPSCRingBufferTest, WrapAroundTest) {
+    Rake::libraries::SPSCRingBuffer<std::string> buffer(6);
+
+    EXPECT_EQ(buffer.capacity(), 8);
+    EXPECT_THROW(Rake::libraries::SPSCRingBuffer<int>(0), std::invalid_argument);
+
+    std::string value;
+
+    EXPECT_FALSE(buffer.TryPop(value));
+    EXPECT_EQ(buffer.Front(), nullptr);
+
+    // Pushing and popping in steps of 3 moves the indices across the end of the buffer several times.
+    int pushed = 0, popped = 0;
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i) EXPECT_TRUE(buffer.TryPush(std::to_string(pushed++)));
+
+        ASSERT_NE(buffer.Front(), nullptr);
+        EXPECT_EQ(*buffer.Front(), std::to_string(popped));
+
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(buffer.TryPop(value));
+            EXPECT_EQ(value, std::to_string(popped++));
+        }
+    }
+
+    while (buffer.TryEmplace(3, 'x')) pushed++;
+
+    EXPECT_EQ(buffer.size(), 8);
+    EXPECT_FALSE(buffer.TryPush("full"));
+
+    // Elements left in the buffer are destroyed with it.
+    auto shared = std::make_shared<int>(0);
+
+    {
+        Rake::libraries::SPSCRingBuffer<std::shared_ptr<int>> owners(4);
+
+        EXPECT_TRUE(owners.TryPush(shared));
+        EXPECT_TRUE(owners.TryPush(shared));
+        EXPECT_EQ(shared.use_count(), 3);
+    }
+
+    EXPECT_EQ(shared.use_count(), 1);
+}
+
+TEST(SPSCRingBufferTest, BulkTest) {
+    Rake::libraries::SPSCRingBuffer<std::string> strings(8);
+    std::vector<std::string> in{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    std::vector<std::string> out(10);
+
+    // Only the free slots are filled, the rest of the span is left to the caller.
+    EXPECT_EQ(strings.PushBulk(in), 8);
+    EXPECT_EQ(strings.PopBulk(std::span(out).first(5)), 5);
+    EXPECT_EQ(strings.PushBulk(std::span(in).subspan(8)), 2);
+    EXPECT_EQ(strings.PopBulk(std::span(out).subspan(5)), 5);
+    EXPECT_EQ(out, in);
+    EXPECT_TRUE(strings.empty());
+
+    Rake::libraries::SPSCRingBuffer<uint32_t> numbers(16);
+    std::array<uint32_t, 12> values, result;
+
+    std::iota(values.begin(), values.end(), 0);
+
+    for (int round = 0; round < 4; ++round) {
+        EXPECT_EQ(numbers.PushBulk(values), 12);
+        EXPECT_EQ(numbers.PopBulk(result), 12);
+        EXPECT_EQ(result, values);
+    }
+}
+
+TEST(SPSCRingBufferTest, ThreadedOrderTest) {
+    constexpr uint64_t c_count = 1 << 20;
+
+    Rake::libraries::SPSCRingBuffer<uint64_t> buffer(1024);
+
+    std::thread producer([&] {
+        uint64_t next = 0;
+        std::array<uint64_t, 32> batch;
+
+        while (next < c_count) {
+            // Alternate single and bulk pushes so both publish paths race against the consumer.
+            if (next % 3 == 0) {
+                if (buffer.TryPush(next)) next++;
+            } else {
+                const size_t count = std::min<uint64_t>(batch.size(), c_count - next);
+
+                for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+
+                next += buffer.PushBulk(std::span(batch).first(count));
+            }
+
+            if (buffer.size() == buffer.capacity()) std::this_thread::yield();
+        }
+    });
+
+    uint64_t expected = 0;
+    bool inOrder = true;
+    std::array<uint64_t, 48> batch;
+
+    while (expected < c_count) {
+        const size_t count = buffer.PopBulk(batch);
+
+        for (size_t i = 0; i < count; ++i) inOrder &= batch[i] == expected++;
+
+        if (count == 0) std::this_thread::yield();
+    }
+
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SPSCRingBufferTest, DISABLED_BenchmarkTest) {
+    constexpr uint64_t c_count = 1 << 24;
+    constexpr size_t c_batchSize = 256;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    Rake::libraries::SPSCRingBuffer<uint64_t> buffer(1 << 16);
+
+    auto run = [&](bool _bulk) {
+        uint64_t sum = 0;
+
+        const auto start = Clock::now();
+
+        std::thread producer([&] {
+            std::array<uint64_t, c_batchSize> batch;
+
+            for (uint64_t next = 0; next < c_count;) {
+                size_t pushed = 0;
+
+                if (_bulk) {
+                    const size_t count = std::min<uint64_t>(c_batchSize, c_count - next);
+
+                    for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+
+                    pushed = buffer.PushBulk(std::span(batch).first(count));
+                } else {
+                    pushed = buffer.TryPush(next);
+                }
+
+                next += pushed;
+
+                if (pushed == 0) std::this_thread::yield();
+            }
+        });
+
+        std::array<uint64_t, c_batchSize> batch;
+
+        for (uint64_t received = 0; received < c_count;) {
+            size_t popped = 0;
+
+            if (_bulk) {
+                popped = buffer.PopBulk(batch);
+                sum = std::accumulate(batch.begin(), batch.begin() + popped, sum);
+            } else if (buffer.TryPop(batch[0])) {
+                popped = 1;
+                sum += batch[0];
+            }
+
+            received += popped;
+
+            if (popped == 0) std::this_thread::yield();
+        }
+
+        producer.join();
+
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        EXPECT_EQ(sum, c_count * (c_count - 1) / 2);
+
+        return c_count / seconds / 1e6;
+    };
+
+    const double single = run(false);
+    const double bulk = run(true);
+
+    std::cout << "[ BENCHMARK] SPSCRingBuffer with " << buffer.capacity() << " slots: " << single
+              << " M ops/s single, " << bulk << " M ops/s bulk of " << c_batchSize << std::endl;
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include <RKSTL/slab.hpp>
+
+TEST(SlabAllocatorTest, SizeClassesTest) {
+    Rake::libraries::SlabAllocator slab;
+
+    std::vector<std::pair<void *, size_t>> blocks;
+
+    for (size_t size = 1; size <= 1024; size *= 3) blocks.emplace_back(slab.Allocate(size, 1), size);
+
+    // Blocks are naturally aligned to their power-of-two size class.
+    for (const auto &[ptr, size] : blocks) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % std::bit_ceil(std::max<size_t>(size, 8)), 0);
+    }
+
+    const auto statistics = slab.GetStatistics();
+
+    EXPECT_EQ(statistics[0].blockSize, 8);
+    EXPECT_EQ(statistics.back().blockSize, 1024);
+    EXPECT_EQ(statistics[0].liveBlocks, 2);
+    EXPECT_EQ(statistics[0].slabCount, 1);
+    EXPECT_EQ(statistics[0].totalBlocks, RK_KIBIBYTES(64) / 8);
+
+    void *large = slab.Allocate(4096);
+
+    EXPECT_EQ(slab.GetLargeBlockCount(), 1);
+
+    slab.Deallocate(large, 4096);
+
+    for (const auto &[ptr, size] : blocks) slab.Deallocate(ptr, size, 1);
+
+    for (const auto &sizeClass : slab.GetStatistics()) EXPECT_EQ(sizeClass.liveBlocks, 0);
+
+    EXPECT_EQ(slab.GetLargeBlockCount(), 0);
+
+    slab.Release();
+
+    for (const auto &sizeClass : slab.GetStatistics()) EXPECT_EQ(sizeClass.slabCount, 0);
+
+    // The thread cache dropped the blocks of the released slabs.
+    EXPECT_NE(slab.Allocate(8), nullptr);
+}
+
+TEST(SlabAllocatorTest, AllocatorTraitsTest) {
+    Rake::libraries::SlabAllocator slab;
+
+    {
+        using Allocator = Rake::libraries::SlabStlAllocator<std::pair<const int, int>>;
+
+        std::map<int, int, std::less<int>, Allocator> map{Allocator(slab)};
+
+        for (int i = 0; i < 1000; ++i) map.emplace(i, -i);
+
+        auto shared = std::allocate_shared<uint64_t>(Rake::libraries::SlabStlAllocator<uint64_t>(slab), 42);
+
+        EXPECT_EQ(*shared, 42);
+        EXPECT_EQ(map.at(999), -999);
+
+        size_t liveBlocks = 0;
+
+        for (const auto &sizeClass : slab.GetStatistics()) liveBlocks += sizeClass.liveBlocks;
+
+        EXPECT_EQ(liveBlocks, 1001);
+    }
+
+    for (const auto &sizeClass : slab.GetStatistics()) EXPECT_EQ(sizeClass.liveBlocks, 0);
+}
+
+TEST(SlabAllocatorTest, ThreadCacheEvictionTest) {
+    constexpr size_t blockSize = 1024;
+    constexpr size_t blocksPerSlab = RK_KIBIBYTES(64) / blockSize;
+
+    // Allocators with ids eight apart share a thread cache slot.
+    std::vector<std::unique_ptr<Rake::libraries::SlabAllocator>> allocators;
+
+    for (size_t i = 0; i < 9; ++i) allocators.push_back(std::make_unique<Rake::libraries::SlabAllocator>());
+
+    auto &first = *allocators.front();
+    auto &last = *allocators.back();
+
+    auto fillSlab = [&first]() {
+        std::vector<void *> ptrs;
+
+        for (size_t i = 0; i < blocksPerSlab; ++i) ptrs.push_back(first.Allocate(blockSize));
+
+        for (void *ptr : ptrs) first.Deallocate(ptr, blockSize);
+    };
+
+    fillSlab();
+
+    // Taking over the slot returns the cached blocks to the first allocator.
+    last.Deallocate(last.Allocate(blockSize), blockSize);
+
+    // Another thread reuses them, then returns its own cache when it exits.
+    std::thread(fillSlab).join();
+
+    fillSlab();
+
+    const auto statistics = first.GetStatistics();
+
+    EXPECT_EQ(statistics.back().slabCount, 1);
+    EXPECT_EQ(statistics.back().liveBlocks, 0);
+}
+
+TEST(SlabAllocatorTest, ConcurrentAllocationTest) {
+    constexpr size_t numThreads = 8;
+    constexpr size_t numAllocations = 10000;
+
+    Rake::libraries::SlabAllocator slab;
+
+    auto threadFunc = [&slab](size_t _idx) {
+        std::vector<uint64_t *> ptrs;
+
+        for (size_t round = 0; round < 10; ++round) {
+            for (size_t i = 0; i < numAllocations; ++i) {
+                uint64_t *ptr = static_cast<uint64_t *>(slab.Allocate(sizeof(uint64_t) * (1 + i % 4)));
+
+                *ptr = _idx;
+                ptrs.push_back(ptr);
+            }
+
+            for (size_t i = 0; i < ptrs.size(); ++i) {
+                EXPECT_EQ(*ptrs[i], _idx);
+                slab.Deallocate(ptrs[i], sizeof(uint64_t) * (1 + i % 4));
+            }
+
+            ptrs.clear();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (size_t i = 0; i < numThreads; ++i) {
+        threads.emplace_back(threadFunc, i);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    size_t allocations = 0;
+
+    for (const auto &sizeClass : slab.GetStatistics()) {
+        EXPECT_EQ(sizeClass.liveBlocks, 0);
+        allocations += sizeClass.allocations;
+    }
+
+    EXPECT_EQ(allocations, numThreads * numAllocations * 10);
+}
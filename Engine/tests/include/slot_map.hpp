@@ -0,0 +1,119 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <RKSTL/slot_map.hpp>
+
+TEST(SlotMapTest, StableKeysTest) {
+    Rake::libraries::SlotMap<std::string> map;
+
+    const auto main = map.Insert("MainWindow");
+    const auto tools = map.Emplace("ToolsWindow");
+    const auto preview = map.Emplace(3, 'x');
+
+    EXPECT_EQ(map.size(), 3);
+    EXPECT_EQ(map.At(tools), "ToolsWindow");
+
+    // Erasing moves the last value into the hole, the keys to it keep resolving.
+    EXPECT_TRUE(map.Erase(main));
+    EXPECT_FALSE(map.Erase(main));
+    EXPECT_EQ(*map.Find(preview), "xxx");
+    EXPECT_EQ(map.begin()[0], "xxx");
+    EXPECT_EQ(map.GetKey(0), preview);
+
+    // The released slot is reused with a new generation, the old key stays stale.
+    const auto console = map.Insert("ConsoleWindow");
+
+    EXPECT_EQ(console.index, main.index);
+    EXPECT_NE(console, main);
+    EXPECT_EQ(map.Find(main), nullptr);
+    EXPECT_THROW((void)map.At(main), std::out_of_range);
+    EXPECT_FALSE(map.Contains(decltype(map)::Key{}));
+    EXPECT_TRUE(decltype(map)::Key{}.IsNull());
+
+    map.Clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_FALSE(map.Contains(tools));
+    EXPECT_FALSE(map.Contains(console));
+    EXPECT_EQ(*map.Find(map.Insert("MainWindow")), "MainWindow");
+}
+
+TEST(SlotMapTest, RandomOperationsTest) {
+    Rake::libraries::SlotMap<std::unique_ptr<int>> map;
+    std::vector<std::pair<Rake::libraries::SlotMap<std::unique_ptr<int>>::Key, int>> live, erased;
+    std::mt19937 generator(9);
+
+    for (int i = 0; i < 50000; ++i) {
+        if (live.empty() || generator() % 3 != 0) {
+            live.emplace_back(map.Emplace(std::make_unique<int>(i)), i);
+        } else {
+            const size_t victim = generator() % live.size();
+
+            EXPECT_TRUE(map.Erase(live[victim].first));
+
+            erased.push_back(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        }
+    }
+
+    ASSERT_EQ(map.size(), live.size());
+
+    for (const auto &[key, value] : live) EXPECT_EQ(**map.Find(key), value);
+    for (const auto &[key, value] : erased) EXPECT_FALSE(map.Contains(key));
+
+    for (size_t i = 0; i < map.size(); ++i) EXPECT_EQ(map.Find(map.GetKey(i)), map.data() + i);
+}
+
+TEST(SlotMapTest, DISABLED_BenchmarkTest) {
+    constexpr size_t numValues = 1024;
+    constexpr int numPasses = 1000;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    Rake::libraries::SlotMap<uint64_t> slots;
+    std::unordered_map<std::string, uint64_t> names;
+    std::vector<Rake::libraries::SlotMap<uint64_t>::Key> keys;
+    std::vector<std::string> keyNames;
+
+    // Registries keyed by name, like windows and rendering contexts, against keys resolved by array indexing.
+    for (uint64_t i = 0; i < numValues; ++i) {
+        keyNames.push_back("RenderingContext" + std::to_string(i));
+        keys.push_back(slots.Insert(i));
+        names[keyNames.back()] = i;
+    }
+
+    uint64_t slotSum = 0, nameSum = 0;
+
+    auto start = Clock::now();
+
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (const auto &key : keys) slotSum += *slots.Find(key);
+    }
+
+    const double slotTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+
+    for (int pass = 0; pass < numPasses; ++pass) {
+        for (const std::string &name : keyNames) nameSum += names.find(name)->second;
+    }
+
+    const double nameTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    EXPECT_EQ(slotSum, nameSum);
+
+    std::cout << "[ BENCHMARK] Lookups over " << numValues << " values (ns/lookup): SlotMap key "
+              << slotTime / (numPasses * numValues) << ", std::unordered_map<std::string> "
+              << nameTime / (numPasses * numValues) << std::endl;
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include <RKSTL/small_vector.hpp>
+
+struct RelocatableHandle {
+    std::unique_ptr<int> value;
+
+    explicit RelocatableHandle(int _value) : value(std::make_unique<int>(_value)) {}
+};
+
+// The unique_ptr member only holds an address, copying its bytes moves ownership.
+template <>
+struct Rake::libraries::IsTriviallyRelocatable<RelocatableHandle> : std::true_type {};
+
+TEST(SmallVectorTest, InlineStorageTest) {
+    Rake::libraries::SmallVector<std::string, 4> names = {"Camera", "Light"};
+
+    EXPECT_TRUE(names.IsInline());
+    EXPECT_EQ(names.capacity(), 4);
+
+    names.PushBack("Mesh");
+    names.EmplaceBack(3, 'x');
+
+    EXPECT_TRUE(names.IsInline());
+
+    // The fifth element moves everything to the heap, arguments aliasing the old storage stay valid.
+    names.PushBack(names[0]);
+
+    EXPECT_FALSE(names.IsInline());
+    EXPECT_EQ(names.size(), 5);
+    EXPECT_EQ(names.Back(), "Camera");
+
+    names.Insert(names.begin() + 1, "Audio");
+    names.Erase(names.begin() + 3, names.begin() + 5);
+
+    EXPECT_EQ(names, (Rake::libraries::SmallVector<std::string, 2>{"Camera", "Audio", "Light", "Camera"}));
+    EXPECT_THROW((void)names.At(4), std::out_of_range);
+
+    names.PopBack();
+    names.ShrinkToFit();
+
+    EXPECT_TRUE(names.IsInline());
+    EXPECT_EQ(names.Front(), "Camera");
+    EXPECT_EQ(names.size(), 3);
+
+    names.Resize(6, "Empty");
+
+    EXPECT_EQ(names[5], "Empty");
+
+    names.Resize(1);
+
+    EXPECT_EQ(names.size(), 1);
+}
+
+TEST(SmallVectorTest, SelfAppendTest) {
+    Rake::libraries::SmallVector<std::string, 4> names = {"Camera", "Light", "Mesh", "Audio"};
+
+    // A full vector appending its own elements grows while the range still points into the old storage.
+    names.Append(names.begin(), names.end());
+
+    ASSERT_EQ(names.size(), 8);
+    EXPECT_FALSE(names.IsInline());
+
+    names.Append(names.begin() + 2, names.end());
+
+    const std::vector<std::string> expected = {"Camera", "Light", "Mesh", "Audio", "Camera", "Light", "Mesh",
+                                               "Audio",  "Mesh",  "Audio", "Camera", "Light", "Mesh", "Audio"};
+
+    EXPECT_TRUE(std::equal(names.begin(), names.end(), expected.begin(), expected.end()));
+}
+
+TEST(SmallVectorTest, MoveTest) {
+    Rake::libraries::SmallVector<std::shared_ptr<int>, 2> inlineHandlers, heapHandlers;
+    auto handler = std::make_shared<int>(7);
+
+    inlineHandlers.PushBack(handler);
+
+    for (int i = 0; i < 5; ++i) heapHandlers.PushBack(handler);
+
+    const std::shared_ptr<int> *heapData = heapHandlers.data();
+
+    // A heap buffer is stolen as is, inline elements are moved one by one.
+    Rake::libraries::SmallVector<std::shared_ptr<int>, 2> stolen(std::move(heapHandlers));
+    Rake::libraries::SmallVector<std::shared_ptr<int>, 2> relocated(std::move(inlineHandlers));
+
+    EXPECT_EQ(stolen.data(), heapData);
+    EXPECT_TRUE(heapHandlers.empty());
+    EXPECT_TRUE(heapHandlers.IsInline());
+    EXPECT_TRUE(inlineHandlers.empty());
+    EXPECT_TRUE(relocated.IsInline());
+    EXPECT_EQ(handler.use_count(), 1 + 5 + 1);
+
+    relocated = stolen;
+
+    EXPECT_EQ(handler.use_count(), 1 + 5 + 5);
+
+    stolen.Swap(relocated);
+    relocated.Clear();
+    stolen = std::move(relocated);
+
+    EXPECT_TRUE(stolen.empty());
+    EXPECT_EQ(handler.use_count(), 1);
+}
+
+TEST(SmallVectorTest, TriviallyRelocatableTest) {
+    Rake::libraries::SmallVector<RelocatableHandle, 2> handles;
+
+    // Growth relocates with memcpy and must neither double free nor leak.
+    for (int i = 0; i < 100; ++i) handles.EmplaceBack(i);
+
+    int sum = 0;
+
+    for (const RelocatableHandle &handle : handles) sum += *handle.value;
+
+    EXPECT_EQ(sum, 99 * 100 / 2);
+
+    handles.Erase(handles.begin(), handles.begin() + 98);
+    handles.ShrinkToFit();
+
+    EXPECT_TRUE(handles.IsInline());
+    EXPECT_EQ(*handles.Back().value, 99);
+
+    Rake::libraries::SmallVector<uint32_t, 8> indices(8, 1);
+
+    indices.PushBack(2);
+
+    EXPECT_EQ(indices.capacity(), 16);
+    EXPECT_EQ(std::accumulate(indices.begin(), indices.end(), 0u), 10);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <RKSTL/sparse_set.hpp>
+
+TEST(SparseSetTest, BasicTest) {
+    Rake::libraries::SparseSet<> set;
+
+    EXPECT_TRUE(set.Insert(3));
+    EXPECT_TRUE(set.Insert(7));
+    EXPECT_TRUE(set.Insert(1'000'000));
+    EXPECT_FALSE(set.Insert(7));
+    EXPECT_THROW(set.Insert(Rake::libraries::SparseSet<>::c_invalidIndex), std::out_of_range);
+
+    EXPECT_EQ(set.size(), 3);
+    EXPECT_TRUE(set.Contains(1'000'000));
+    EXPECT_FALSE(set.Contains(4));
+    EXPECT_FALSE(set.Contains(5'000'000));
+
+    // Erasing moves the last identifier into the hole, the dense array stays packed.
+    EXPECT_TRUE(set.Erase(3));
+    EXPECT_FALSE(set.Erase(3));
+    EXPECT_EQ(set[0], 1'000'000);
+    EXPECT_EQ(set.GetDenseIndex(1'000'000), 0);
+    EXPECT_EQ(set.GetDenseIndex(7), 1);
+
+    set.Clear();
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.Contains(7));
+    EXPECT_TRUE(set.Insert(7));
+}
+
+TEST(SparseSetTest, RandomOperationsTest) {
+    Rake::libraries::SparseSet<uint16_t> set;
+    std::unordered_set<uint16_t> reference;
+    std::mt19937 generator(5);
+
+    for (int i = 0; i < 100000; ++i) {
+        const uint16_t id = static_cast<uint16_t>(generator() % 5000);
+
+        if (generator() % 2 == 0) {
+            EXPECT_EQ(set.Insert(id), reference.insert(id).second);
+        } else {
+            EXPECT_EQ(set.Erase(id), reference.erase(id) == 1);
+        }
+    }
+
+    ASSERT_EQ(set.size(), reference.size());
+
+    for (size_t i = 0; i < set.size(); ++i) {
+        EXPECT_TRUE(reference.contains(set[i]));
+        EXPECT_EQ(set.GetDenseIndex(set[i]), i);
+    }
+
+    std::vector<uint16_t> ids(set.begin(), set.end());
+
+    std::sort(ids.begin(), ids.end());
+
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string_view>
+
+#include <RKSTL/string_id.hpp>
+#include <RKSTL/flat_hash_map.hpp>
+
+TEST(StringIdTest, CompileTimeTest) {
+    constexpr Rake::libraries::StringId moveForward = "MoveForward";
+
+    static_assert(moveForward.GetHash() == Rake::libraries::FNV1aHash<uint64_t>("MoveForward"));
+    static_assert(moveForward == Rake::libraries::StringId(std::string_view("MoveForward")));
+    static_assert(moveForward != Rake::libraries::StringId("MoveBack"));
+    static_assert(Rake::libraries::StringId().IsNull());
+
+    // Runtime strings hash to the same identifier as the literal.
+    const std::string name = std::string("Move") + "Forward";
+
+    EXPECT_EQ(Rake::libraries::StringId(name), moveForward);
+    EXPECT_EQ(Rake::libraries::StringId::FromHash(moveForward.GetHash()), moveForward);
+}
+
+TEST(StringIdTest, InternTest) {
+    const Rake::libraries::StringId escape = Rake::libraries::StringId::Intern(std::string("EscapeApp"));
+
+    EXPECT_EQ(escape, Rake::libraries::StringId("EscapeApp"));
+    EXPECT_EQ(Rake::libraries::StringId("EscapeApp").GetString(), "EscapeApp");
+    EXPECT_EQ(Rake::libraries::StringId::Intern("EscapeApp"), escape);
+    EXPECT_TRUE(Rake::libraries::StringId("NeverInterned").GetString().empty());
+
+    // Registries key on the 64-bit identifier.
+    Rake::libraries::FlatHashMap<Rake::libraries::StringId, int> actions;
+
+    // Templates taking the key by forwarding reference receive the literal itself, it is converted explicitly there.
+    actions[Rake::libraries::StringId("Jump")] = 1;
+    actions[escape] = 2;
+
+    EXPECT_EQ(actions.At(Rake::libraries::StringId(std::string_view("Jump"))), 1);
+    EXPECT_EQ(actions.At(Rake::libraries::StringId("EscapeApp")), 2);
+}
+
+TEST(StringIdTest, ThreadedInternTest) {
+    constexpr int numThreads = 8;
+    constexpr int numNames = 4096;
+
+    std::vector<std::thread> threads;
+    std::atomic<bool> mismatch = false;
+
+    // Threads intern overlapping names while reading back the ones interned so far, growing the table many times.
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < numNames; ++i) {
+                const std::string name = "Cvar" + std::to_string((i * (t + 1)) % numNames);
+                const auto id = Rake::libraries::StringId::Intern(name);
+
+                if (id.GetString() != name) mismatch = true;
+            }
+        });
+    }
+
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_FALSE(mismatch);
+
+    for (int i = 0; i < numNames; ++i) {
+        const std::string name = "Cvar" + std::to_string(i);
+
+        EXPECT_EQ(Rake::libraries::StringId(name).GetString(), name);
+    }
+}
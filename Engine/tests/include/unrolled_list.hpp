@@ -0,0 +1,164 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <chrono>
+#include <random>
+#include <string>
+#include <numeric>
+#include <iostream>
+
+#include <RKSTL/list.hpp>
+#include <RKSTL/unrolled_list.hpp>
+
+TEST(UnrolledListTest, RandomEditsTest) {
+    Rake::libraries::UnrolledList<std::string, 8> list;
+    std::deque<std::string> reference;
+    std::mt19937 generator(7);
+
+    // Small chunks make splits and merges frequent.
+    for (int i = 0; i < 4000; ++i) {
+        const size_t position = reference.empty() ? 0 : generator() % (reference.size() + 1);
+
+        if (reference.size() > 200 && generator() % 2 == 0) {
+            const size_t erased = position % reference.size();
+            auto next = list.Erase(std::next(list.begin(), erased));
+
+            reference.erase(reference.begin() + erased);
+
+            if (erased < reference.size()) EXPECT_EQ(*next, reference[erased]);
+            else EXPECT_EQ(next, list.end());
+        } else {
+            const std::string value = std::to_string(i);
+
+            EXPECT_EQ(*list.Insert(std::next(list.begin(), position), value), value);
+
+            reference.insert(reference.begin() + position, value);
+        }
+    }
+
+    ASSERT_EQ(list.size(), reference.size());
+    EXPECT_TRUE(std::equal(list.begin(), list.end(), reference.begin()));
+    EXPECT_TRUE(std::equal(reference.rbegin(), reference.rend(), std::make_reverse_iterator(list.end())));
+
+    // Merging sparse chunks keeps the chunk count close to the minimum.
+    EXPECT_LE(list.GetChunkCount(), reference.size() / 2 + 1);
+
+    list.PopFront();
+    list.PopBack();
+
+    EXPECT_EQ(list.Front(), reference[1]);
+    EXPECT_EQ(list.Back(), reference[reference.size() - 2]);
+
+    Rake::libraries::UnrolledList<std::string, 8> moved(std::move(list));
+
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(moved.size(), reference.size() - 2);
+
+    moved.Clear();
+
+    EXPECT_EQ(moved.GetChunkCount(), 0);
+}
+
+TEST(UnrolledListTest, SpansTest) {
+    Rake::libraries::UnrolledList<float, 32> list;
+
+    for (int i = 0; i < 1000; ++i) list.PushBack(static_cast<float>(i));
+
+    for (int i = 0; i < 10; ++i) list.PushFront(-1.0f);
+
+    size_t spans = 0;
+    float sum = 0.0f;
+
+    list.ForEachSpan([&](std::span<float> _span) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(_span.data()) % 32, 0);
+        EXPECT_LE(_span.size(), 32);
+
+        for (float &value : _span) value *= 2.0f;
+
+        sum += std::accumulate(_span.begin(), _span.end(), 0.0f);
+        spans++;
+    });
+
+    EXPECT_EQ(spans, list.GetChunkCount());
+    EXPECT_FLOAT_EQ(sum, 2.0f * (999.0f * 1000.0f / 2.0f - 10.0f));
+}
+
+TEST(UnrolledListTest, DISABLED_BenchmarkTest) {
+    constexpr int numElements = 1 << 16;
+    constexpr int numMiddleInserts = 1024;
+    constexpr int numPasses = 16;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    Rake::libraries::UnrolledList<uint64_t> unrolled;
+    Rake::libraries::DoublyLinkedList<uint64_t> linked(numElements);
+    std::deque<uint64_t> deque;
+
+    for (int i = 0; i < numElements; ++i) {
+        unrolled.PushBack(i);
+        linked.PushBack(i);
+        deque.push_back(i);
+    }
+
+    auto measure = [](auto &&_function) {
+        const auto start = Clock::now();
+        _function();
+        return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    };
+
+    uint64_t unrolledSum = 0, linkedSum = 0, dequeSum = 0;
+
+    const double unrolledTraversal = measure([&] {
+        for (int pass = 0; pass < numPasses; ++pass) {
+            unrolled.ForEachSpan([&](std::span<uint64_t> _span) {
+                unrolledSum = std::accumulate(_span.begin(), _span.end(), unrolledSum);
+            });
+        }
+    });
+
+    const double linkedTraversal = measure([&] {
+        for (int pass = 0; pass < numPasses; ++pass) {
+            for (auto it = linked.begin(); it != linked.end(); ++it) linkedSum += *it;
+        }
+    });
+
+    const double dequeTraversal = measure([&] {
+        for (int pass = 0; pass < numPasses; ++pass) dequeSum = std::accumulate(deque.begin(), deque.end(), dequeSum);
+    });
+
+    EXPECT_EQ(unrolledSum, dequeSum);
+    EXPECT_EQ(linkedSum, dequeSum);
+
+    // Inserting at a position already found, so only the cost of the insertion itself is measured.
+    const double unrolledInsert = measure([&] {
+        auto it = std::next(unrolled.begin(), numElements / 2);
+
+        for (int i = 0; i < numMiddleInserts; ++i) it = unrolled.Insert(it, i);
+    });
+
+    const double linkedInsert = measure([&] {
+        auto it = linked.begin();
+
+        for (int i = 0; i < numElements / 2; ++i) ++it;
+
+        for (int i = 0; i < numMiddleInserts; ++i) linked.Insert(it, i);
+    });
+
+    const double dequeInsert = measure([&] {
+        auto it = deque.begin() + numElements / 2;
+
+        for (int i = 0; i < numMiddleInserts; ++i) it = deque.insert(it, i);
+    });
+
+    EXPECT_EQ(unrolled.size(), deque.size());
+    EXPECT_TRUE(std::equal(unrolled.begin(), unrolled.end(), deque.begin()));
+
+    std::cout << "[ BENCHMARK] Traversal of " << numElements << " elements x" << numPasses
+              << ": UnrolledList " << unrolledTraversal << " us, DoublyLinkedList " << linkedTraversal
+              << " us, std::deque " << dequeTraversal << " us" << std::endl;
+
+    std::cout << "[ BENCHMARK] " << numMiddleInserts << " middle inserts: UnrolledList " << unrolledInsert
+              << " us, DoublyLinkedList " << linkedInsert << " us, std::deque " << dequeInsert << " us" << std::endl;
+}
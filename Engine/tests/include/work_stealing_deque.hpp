@@ -0,0 +1,111 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+#include <RKSTL/work_stealing_deque.hpp>
+
+TEST(WorkStealingDequeTest, OwnerAndThiefOrderTest) {
+    Rake::libraries::WorkStealingDeque<int> deque(4);
+
+    EXPECT_THROW(Rake::libraries::WorkStealingDeque<int>(0), std::invalid_argument);
+    EXPECT_FALSE(deque.Pop().has_value());
+    EXPECT_FALSE(deque.Steal().has_value());
+
+    // Pushing past the capacity grows the array without losing or reordering elements.
+    for (int i = 0; i < 10; ++i) deque.Push(i);
+
+    EXPECT_EQ(deque.capacity(), 16);
+    EXPECT_EQ(deque.size(), 10);
+
+    // The owner works LIFO from the bottom, thieves FIFO from the top.
+    EXPECT_EQ(deque.Pop(), 9);
+    EXPECT_EQ(deque.Steal(), 0);
+    EXPECT_EQ(deque.Pop(), 8);
+    EXPECT_EQ(deque.Steal(), 1);
+
+    for (int i = 7; i >= 2; --i) EXPECT_EQ(deque.Pop(), i);
+
+    EXPECT_TRUE(deque.empty());
+    EXPECT_FALSE(deque.Pop().has_value());
+    EXPECT_FALSE(deque.Steal().has_value());
+
+    deque.Push(42);
+
+    EXPECT_EQ(deque.Steal(), 42);
+    EXPECT_FALSE(deque.Pop().has_value());
+}
+
+TEST(WorkStealingDequeTest, StressTest) {
+    constexpr int c_numThieves = 4;
+    constexpr int c_numItems = 200000;
+
+    struct Work {
+        int id = 0;
+        std::atomic<int> taken = 0;
+    };
+
+    // A small initial capacity makes the owner grow the array while thieves are reading from it.
+    Rake::libraries::WorkStealingDeque<Work *> deque(8);
+    std::vector<std::unique_ptr<Work>> work(c_numItems);
+    std::atomic<bool> done = false;
+    std::atomic<int> stolen = 0;
+
+    std::vector<std::thread> thieves;
+
+    for (int i = 0; i < c_numThieves; ++i) {
+        thieves.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (std::optional<Work *> item = deque.Steal()) {
+                    // The plain write of the id made before Push is visible through the stolen pointer.
+                    EXPECT_GE((*item)->id, 0);
+
+                    (*item)->taken.fetch_add(1, std::memory_order_relaxed);
+                    stolen.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int popped = 0;
+
+    for (int i = 0; i < c_numItems; ++i) {
+        work[i] = std::make_unique<Work>();
+        work[i]->id = i;
+
+        deque.Push(work[i].get());
+
+        // The owner keeps popping some of its own work, racing the thieves for the last element.
+        if (i % 3 == 0) {
+            if (std::optional<Work *> item = deque.Pop()) {
+                (*item)->taken.fetch_add(1, std::memory_order_relaxed);
+                popped++;
+            }
+        }
+    }
+
+    while (std::optional<Work *> item = deque.Pop()) {
+        (*item)->taken.fetch_add(1, std::memory_order_relaxed);
+        popped++;
+    }
+
+    done.store(true, std::memory_order_release);
+
+    for (std::thread &thief : thieves) thief.join();
+
+    // Every element is taken exactly once, either by the owner or by a single thief.
+    int takenOnce = 0;
+
+    for (const auto &item : work) takenOnce += item->taken.load() == 1;
+
+    EXPECT_EQ(takenOnce, c_numItems);
+    EXPECT_EQ(popped + stolen.load(), c_numItems);
+    EXPECT_TRUE(deque.empty());
+}
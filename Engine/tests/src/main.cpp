@@ -2,7 +2,28 @@
 #include <gtest/gtest.h>
 
 #include "profiler.hpp"
+#include "pool.hpp"
+#include "memory.hpp"
+#include "memory_resource.hpp"
+#include "slab.hpp"
+#include "memory_tracker.hpp"
+#include "memory_budget.hpp"
+#include "list.hpp"
+#include "unrolled_list.hpp"
+#include "mpsc_queue.hpp"
+#include "ring_buffer.hpp"
+#include "work_stealing_deque.hpp"
+#include "flat_hash_map.hpp"
+#include "small_vector.hpp"
+#include "sparse_set.hpp"
+#include "slot_map.hpp"
+#include "concurrent_hash_map.hpp"
+#include "string_id.hpp"
+#include "perfect_hash_map.hpp"
+#include "input_mappings.hpp"
+#include "event_system.hpp"
 
+// Benchmarks are registered as DISABLED_ tests, run them with --gtest_also_run_disabled_tests.
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     int result = RUN_ALL_TESTS();
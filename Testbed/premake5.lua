@@ -26,5 +26,6 @@ includedirs {
 }
 
 links {
+    "STL",
     "Runtime"
 }
@@ -15,7 +15,7 @@ Testbed::Testbed() {}
 Testbed::~Testbed() {}
 
 void Testbed::OnStart() noexcept {
-    auto& primaryWindow = m_windowSystem->CreateWindow("PrimaryWindow");
+    auto primaryWindow = m_windowSystem->CreateWindow("PrimaryWindow");
 
     primaryWindow->SetTitle(L"Rake Engine - Multicontext Primary - x86_64 - WIN32 - Vulkan");
 